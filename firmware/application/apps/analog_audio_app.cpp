@@ -116,6 +116,9 @@ SPECOptionsView::SPECOptionsView(
         &options_config,
         &text_speed,
         &field_speed,
+        &options_fft_size,
+        &options_window,
+        &options_averaging,
         &text_rx_cal,
         &field_rx_iq_phase_cal,
     });
@@ -130,6 +133,21 @@ SPECOptionsView::SPECOptionsView(
         view->set_spec_trigger(v);
     };
 
+    options_fft_size.set_by_value(view->get_spec_fft_size());
+    options_fft_size.on_change = [this, view](size_t, OptionsField::value_t v) {
+        view->set_spec_fft(v, view->get_spec_window());
+    };
+
+    options_window.set_by_value(toUType(view->get_spec_window()));
+    options_window.on_change = [this, view](size_t, OptionsField::value_t v) {
+        view->set_spec_fft(view->get_spec_fft_size(), static_cast<SpectrumWindow>(v));
+    };
+
+    options_averaging.set_by_value(toUType(view->get_spec_averaging()) | (view->get_spec_average_count() << 8));
+    options_averaging.on_change = [this, view](size_t, OptionsField::value_t v) {
+        view->set_spec_averaging(static_cast<SpectrumAveraging>(v & 0xff), v >> 8);
+    };
+
     field_rx_iq_phase_cal.set_range(0, hackrf_r9 ? 63 : 31);                       // max2839 has 6 bits [0..63],  max2837 has 5 bits [0..31]
     field_rx_iq_phase_cal.set_value(view->get_spec_iq_phase_calibration_value());  // using  accessor function of AnalogAudioView to read iq_phase_calibration_value from rx_audio.ini
     field_rx_iq_phase_cal.on_change = [this, view](int32_t v) {
@@ -245,6 +263,36 @@ void AnalogAudioView::set_spec_trigger(uint16_t trigger) {
     baseband::set_spectrum(spec_bw, spec_trigger);
 }
 
+size_t AnalogAudioView::get_spec_fft_size() {
+    return spec_fft_size;
+}
+
+SpectrumWindow AnalogAudioView::get_spec_window() {
+    return spec_window;
+}
+
+void AnalogAudioView::set_spec_fft(size_t fft_size, SpectrumWindow window) {
+    spec_fft_size = fft_size;
+    spec_window = window;
+
+    waterfall.set_fft(spec_fft_size, spec_window);
+}
+
+SpectrumAveraging AnalogAudioView::get_spec_averaging() {
+    return spec_averaging;
+}
+
+uint8_t AnalogAudioView::get_spec_average_count() {
+    return spec_average_count;
+}
+
+void AnalogAudioView::set_spec_averaging(SpectrumAveraging averaging, uint8_t count) {
+    spec_averaging = averaging;
+    spec_average_count = count;
+
+    waterfall.set_averaging(spec_averaging, spec_average_count);
+}
+
 AnalogAudioView::~AnalogAudioView() {
     audio::output::stop();
     receiver_model.disable();
@@ -274,7 +322,7 @@ void AnalogAudioView::on_modulation_changed(ReceiverModel::Mode modulation) {
     baseband::spectrum_streaming_stop();
     update_modulation(modulation);
     on_show_options_modulation();
-    baseband::spectrum_streaming_start();
+    baseband::spectrum_streaming_start(spec_fft_size, spec_window, spec_averaging, spec_average_count);
 }
 
 void AnalogAudioView::remove_options_widget() {
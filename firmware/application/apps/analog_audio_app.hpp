@@ -123,18 +123,47 @@ class SPECOptionsView : public View {
         }};
 
     Text text_speed{
-        {9 * 8, 0 * 16, 8 * 8, 1 * 16},
-        "SP   /63"};
+        {8 * 8, 0 * 16, 2 * 8, 1 * 16},
+        "SP"};
     NumberField field_speed{
-        {12 * 8, 0 * 16},
+        {10 * 8, 0 * 16},
         2,
         {0, 63},
         1,
         ' ',
     };
+    OptionsField options_fft_size{
+        {13 * 8, 0 * 16},
+        3,
+        {
+            {"256", 256},
+            {"512", 512},
+            {"1k ", 1024},
+            {"2k ", 2048},
+        }};
+    OptionsField options_window{
+        {17 * 8, 0 * 16},
+        3,
+        {
+            {"HAN", toUType(SpectrumWindow::Hann)},
+            {"BHR", toUType(SpectrumWindow::BlackmanHarris)},
+            {"FLT", toUType(SpectrumWindow::FlatTop)},
+        }};
+    // Value is the averaging mode, with the frame count in the next byte up.
+    OptionsField options_averaging{
+        {21 * 8, 0 * 16},
+        3,
+        {
+            {"LIV", toUType(SpectrumAveraging::None) | (1 << 8)},
+            {"AV4", toUType(SpectrumAveraging::Welch) | (4 << 8)},
+            {"A16", toUType(SpectrumAveraging::Welch) | (16 << 8)},
+            {"EX8", toUType(SpectrumAveraging::Exponential) | (8 << 8)},
+            {"MAX", toUType(SpectrumAveraging::MaxHold) | (1 << 8)},
+            {"MIN", toUType(SpectrumAveraging::MinHold) | (1 << 8)},
+        }};
     Text text_rx_cal{
-        {19 * 8, 0 * 16, 11 * 8, 1 * 16},  // 18 (x col.) x char_size,  12 (length) x 8 blanking space to delete previous chars.
-        "Rx_IQ_CAL  "};
+        {25 * 8, 0 * 16, 3 * 8, 1 * 16},  // 3 (length) x 8 blanking space to delete previous chars.
+        "IQ "};
     NumberField field_rx_iq_phase_cal{
         {28 * 8, 0 * 16},
         2,
@@ -161,6 +190,14 @@ class AnalogAudioView : public View {
     uint16_t get_spec_trigger();
     void set_spec_trigger(uint16_t trigger);
 
+    size_t get_spec_fft_size();
+    SpectrumWindow get_spec_window();
+    void set_spec_fft(size_t fft_size, SpectrumWindow window);
+
+    SpectrumAveraging get_spec_averaging();
+    uint8_t get_spec_average_count();
+    void set_spec_averaging(SpectrumAveraging averaging, uint8_t count);
+
     uint8_t get_spec_iq_phase_calibration_value();
     void set_spec_iq_phase_calibration_value(uint8_t cal_value);
 
@@ -183,6 +220,10 @@ class AnalogAudioView : public View {
     size_t spec_bw_index = 0;
     uint32_t spec_bw = 20000000;
     uint16_t spec_trigger = 63;
+    size_t spec_fft_size = SpectrumStreamingConfigMessage::min_fft_size;
+    SpectrumWindow spec_window = SpectrumWindow::Hann;
+    SpectrumAveraging spec_averaging = SpectrumAveraging::None;
+    uint8_t spec_average_count = 1;
 
     RSSI rssi{
         {21 * 8, 0, 6 * 8, 4}};
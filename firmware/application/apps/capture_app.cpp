@@ -25,6 +25,9 @@
 #include "portapack.hpp"
 #include "ui_freqman.hpp"
 
+#include <cmath>
+#include <limits>
+
 using namespace portapack;
 
 namespace ui {
@@ -45,6 +48,14 @@ CaptureAppView::CaptureAppView(NavigationView& nav)
         &option_bandwidth,
         &option_format,
         &check_trim,
+        &option_limit,
+        &text_chain_load,
+        &option_decimation,
+        &option_filter,
+        &option_trigger,
+        &field_trigger_level,
+        &text_trigger_unit,
+        &field_trigger_pattern,
         &record_view,
         &waterfall,
     });
@@ -55,11 +66,13 @@ CaptureAppView::CaptureAppView(NavigationView& nav)
         this->field_frequency.set_step(v);
     };
 
-    option_format.set_selected_index(file_format);
+    // The setting holds the FileType, restore it by value so the recorder follows.
     option_format.on_change = [this](size_t, uint32_t file_type) {
         file_format = file_type;
         record_view.set_file_type((RecordView::FileType)file_type);
+        update_chain_load();
     };
+    option_format.set_by_value(file_format);
 
     check_trim.set_value(trim);
     check_trim.on_select = [this](Checkbox&, bool v) {
@@ -67,38 +80,47 @@ CaptureAppView::CaptureAppView(NavigationView& nav)
         record_view.set_auto_trim(v);
     };
 
-    freqman_set_bandwidth_option(SPEC_MODULATION, option_bandwidth);
-    option_bandwidth.on_change = [this](size_t, uint32_t new_capture_rate) {
-        /* Nyquist would imply a sample rate of 2x bandwidth, but because the ADC
-         * provides 2 values (I,Q), the sample_rate is equal to bandwidth here. */
-
-        /* capture_rate (bandwidth) is used for FFT calculation and display LCD, and also in recording writing SD Card rate. */
-        /* ex. sampling_rate values, 4Mhz, when recording 500 kHz (BW) and fs 8 Mhz, when selected 1 Mhz BW ... */
-        /* ex. recording 500kHz BW to .C16 file, base_rate clock 500kHz x2(I,Q) x 2 bytes (int signed) =2MB/sec rate SD Card. */
-
-        waterfall.stop();
-
-        // record_view determines the correct oversampling to apply and returns the actual sample rate.
-        // NB: record_view is what actually updates proc_capture baseband settings.
-        auto actual_sample_rate = record_view.set_sampling_rate(new_capture_rate);
-
-        // Update the radio model with the actual sampling rate.
-        receiver_model.set_sampling_rate(actual_sample_rate);
-
-        // Get suitable anti-aliasing BPF bandwidth for MAX2837 given the actual sample rate.
-        auto anti_alias_filter_bandwidth = filter_bandwidth_for_sampling_rate(actual_sample_rate);
-        receiver_model.set_baseband_bandwidth(anti_alias_filter_bandwidth);
+    option_limit.set_by_value(capture_limit);
+    record_view.set_capture_limit(capture_limit);
+    option_limit.on_change = [this](size_t, uint32_t seconds) {
+        capture_limit = seconds;
+        record_view.set_capture_limit(seconds);
+    };
 
-        // Automatically switch default capture format to C8 when bandwidth setting is increased to >=1.5MHz anb back to C16 for <=1,25Mhz
-        if ((new_capture_rate >= 1500000) && (capture_rate < 1500000)) {
-            option_format.set_selected_index(1);  // Default C8 format for REC, 1500K ... 5500k
-        }
-        if ((new_capture_rate <= 1250000) && (capture_rate > 1250000)) {
-            option_format.set_selected_index(0);  // Default C16 format for REC , 12k5 ... 1250K
-        }
-        capture_rate = new_capture_rate;
+    option_decimation.set_by_value(decimation);
+    option_filter.set_by_value(decimation_filter);
+    option_decimation.on_change = [this](size_t, uint32_t v) {
+        decimation = v;
+        update_decimation();
+    };
+    option_filter.on_change = [this](size_t, uint32_t v) {
+        decimation_filter = v;
+        update_decimation();
+    };
+    record_view.set_decimation(
+        static_cast<OversampleRate>(decimation),
+        static_cast<DecimationFilter>(decimation_filter));
+
+    option_trigger.set_by_value(trigger_mode);
+    field_trigger_level.set_value(trigger_level);
+    field_trigger_pattern.set_value(trigger_pattern);
+    option_trigger.on_change = [this](size_t, uint32_t v) {
+        trigger_mode = v;
+        update_trigger();
+    };
+    field_trigger_level.on_change = [this](int32_t v) {
+        trigger_level = v;
+        update_trigger();
+    };
+    field_trigger_pattern.on_change = [this](SymField& f) {
+        trigger_pattern = f.to_string();
+        update_trigger();
+    };
+    update_trigger();
 
-        waterfall.start();
+    freqman_set_bandwidth_option(SPEC_MODULATION, option_bandwidth);
+    option_bandwidth.on_change = [this](size_t, uint32_t new_capture_rate) {
+        update_capture_rate(new_capture_rate);
     };
 
     receiver_model.enable();
@@ -137,4 +159,94 @@ void CaptureAppView::on_freqchg(int64_t freq) {
     field_frequency.set_value(freq);
 }
 
+void CaptureAppView::update_capture_rate(uint32_t new_capture_rate) {
+    /* Nyquist would imply a sample rate of 2x bandwidth, but because the ADC
+     * provides 2 values (I,Q), the sample_rate is equal to bandwidth here. */
+
+    /* capture_rate (bandwidth) is used for FFT calculation and display LCD, and also in recording writing SD Card rate. */
+    /* ex. sampling_rate values, 4Mhz, when recording 500 kHz (BW) and fs 8 Mhz, when selected 1 Mhz BW ... */
+    /* ex. recording 500kHz BW to .C16 file, base_rate clock 500kHz x2(I,Q) x 2 bytes (int signed) =2MB/sec rate SD Card. */
+
+    waterfall.stop();
+
+    // record_view determines the correct oversampling to apply and returns the actual sample rate.
+    // NB: record_view is what actually updates proc_capture baseband settings.
+    auto actual_sample_rate = record_view.set_sampling_rate(new_capture_rate);
+
+    // Update the radio model with the actual sampling rate.
+    receiver_model.set_sampling_rate(actual_sample_rate);
+
+    // Get suitable anti-aliasing BPF bandwidth for MAX2837 given the actual sample rate.
+    auto anti_alias_filter_bandwidth = filter_bandwidth_for_sampling_rate(actual_sample_rate);
+    receiver_model.set_baseband_bandwidth(anti_alias_filter_bandwidth);
+
+    // Automatically switch default capture format to C8 when bandwidth setting is increased to >=1.5MHz anb back to C16 for <=1,25Mhz
+    if ((new_capture_rate >= 1500000) && (capture_rate < 1500000)) {
+        option_format.set_selected_index(1);  // Default C8 format for REC, 1500K ... 5500k
+    }
+    if ((new_capture_rate <= 1250000) && (capture_rate > 1250000)) {
+        option_format.set_selected_index(0);  // Default C16 format for REC , 12k5 ... 1250K
+    }
+    capture_rate = new_capture_rate;
+
+    waterfall.start();
+    update_chain_load();
+}
+
+void CaptureAppView::update_decimation() {
+    record_view.set_decimation(
+        static_cast<OversampleRate>(decimation),
+        static_cast<DecimationFilter>(decimation_filter));
+
+    // The baseband is only reconfigured along with the sample rate.
+    update_capture_rate(capture_rate);
+}
+
+void CaptureAppView::update_trigger() {
+    CaptureTriggerConfig trigger{};
+
+    if (trigger_mode != TriggerOff) {
+        // Full scale is a tone at 32767 on I and Q.
+        constexpr float full_scale_power = 32767.0f * 32767.0f;
+        trigger.power_threshold = full_scale_power * std::pow(10.0f, trigger_level / 10.0f);
+
+        if (trigger_mode == TriggerPattern) {
+            const auto& symbols = field_trigger_pattern.to_string();
+            for (size_t i = 0; i < symbols.size(); i++) {
+                const uint32_t bit = 1U << (symbols.size() - 1 - i);
+                if (symbols[i] != 'X')
+                    trigger.pattern_mask |= bit;
+                if (symbols[i] == '1')
+                    trigger.pattern |= bit;
+            }
+        }
+
+        // A level trigger, or a pattern of only X, fires on one loud block.
+        if (trigger.pattern_mask == 0) {
+            trigger.pattern_mask = 1;
+            trigger.pattern = 1;
+        }
+
+        // As much as the baseband can keep.
+        trigger.pre_trigger_bytes = std::numeric_limits<uint32_t>::max();
+    }
+
+    record_view.set_trigger(trigger);
+    field_trigger_level.hidden(trigger_mode == TriggerOff);
+    text_trigger_unit.hidden(trigger_mode == TriggerOff);
+    field_trigger_pattern.hidden(trigger_mode != TriggerPattern);
+    set_dirty();
+}
+
+void CaptureAppView::on_capture_statistics(const CaptureStatisticsMessage& statistics) {
+    m4_load = statistics.load_percent;
+    update_chain_load();
+}
+
+void CaptureAppView::update_chain_load() {
+    text_chain_load.set(
+        "M4:" + to_string_dec_uint(m4_load, 3) + "% " +
+        to_string_dec_uint(record_view.bytes_per_second() / 1000, 5) + "kB/s");
+}
+
 } /* namespace ui */
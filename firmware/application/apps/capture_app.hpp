@@ -47,11 +47,24 @@ class CaptureAppView : public View {
     std::string title() const override { return "Capture"; };
 
    private:
-    static constexpr ui::Dim header_height = 3 * 16;
+    static constexpr ui::Dim header_height = 6 * 16;
+
+    enum TriggerMode : uint32_t {
+        TriggerOff = 0,
+        TriggerLevel = 1,
+        TriggerPattern = 2,
+    };
 
     uint32_t capture_rate{500000};
     uint32_t file_format{0};
     bool trim{false};
+    uint32_t capture_limit{0};
+    uint32_t decimation{toUType(OversampleRate::None)};
+    uint32_t decimation_filter{toUType(DecimationFilter::Standard)};
+    uint8_t m4_load{0};
+    uint32_t trigger_mode{TriggerOff};
+    int32_t trigger_level{-40};
+    std::string trigger_pattern{"XXXXXXX1"};
 
     NavigationView& nav_;
     RxRadioState radio_state_{ReceiverModel::Mode::Capture};
@@ -62,11 +75,21 @@ class CaptureAppView : public View {
             {"capture_rate"sv, &capture_rate},
             {"file_format"sv, &file_format},
             {"trim"sv, &trim},
+            {"capture_limit"sv, &capture_limit},
+            {"decimation"sv, &decimation},
+            {"decimation_filter"sv, &decimation_filter},
+            {"trigger_mode"sv, &trigger_mode},
+            {"trigger_level"sv, &trigger_level},
+            {"trigger_pattern"sv, &trigger_pattern},
         }};
 
     Labels labels{
         {{0 * 8, 1 * 16}, "Rate:", Theme::getInstance()->fg_light->foreground},
         {{11 * 8, 1 * 16}, "Format:", Theme::getInstance()->fg_light->foreground},
+        {{0 * 8, 3 * 16}, "Limit:", Theme::getInstance()->fg_light->foreground},
+        {{0 * 8, 4 * 16}, "Decim:", Theme::getInstance()->fg_light->foreground},
+        {{12 * 8, 4 * 16}, "Filter:", Theme::getInstance()->fg_light->foreground},
+        {{0 * 8, 5 * 16}, "Trig:", Theme::getInstance()->fg_light->foreground},
     };
 
     RSSI rssi{
@@ -100,7 +123,8 @@ class CaptureAppView : public View {
         {18 * 8, 1 * 16},
         3,
         {{"C16", RecordView::FileType::RawS16},
-         {"C8", RecordView::FileType::RawS8}}};
+         {"C8", RecordView::FileType::RawS8},
+         {"CIQ", RecordView::FileType::PackedS16}}};
 
     Checkbox check_trim{
         {23 * 8, 1 * 16},
@@ -108,6 +132,65 @@ class CaptureAppView : public View {
         "Trim",
         /*small*/ true};
 
+    // Seconds; a limit pre-allocates the capture file.
+    OptionsField option_limit{
+        {7 * 8, 3 * 16},
+        4,
+        {{"Off", 0},
+         {"10s", 10},
+         {"30s", 30},
+         {"1m", 60},
+         {"5m", 300},
+         {"15m", 900},
+         {"1h", 3600}}};
+
+    Text text_chain_load{
+        {12 * 8, 3 * 16, 18 * 8, 16},
+        ""};
+
+    // Total decimation of the capture chain, Auto follows the oversample table.
+    OptionsField option_decimation{
+        {7 * 8, 4 * 16},
+        4,
+        {{"Auto", toUType(OversampleRate::None)},
+         {"x4", toUType(OversampleRate::x4)},
+         {"x8", toUType(OversampleRate::x8)},
+         {"x16", toUType(OversampleRate::x16)},
+         {"x32", toUType(OversampleRate::x32)},
+         {"x64", toUType(OversampleRate::x64)}}};
+
+    OptionsField option_filter{
+        {20 * 8, 4 * 16},
+        5,
+        {{"Std", toUType(DecimationFilter::Standard)},
+         {"Fast", toUType(DecimationFilter::Fast)},
+         {"Sharp", toUType(DecimationFilter::Sharp)}}};
+
+    OptionsField option_trigger{
+        {5 * 8, 5 * 16},
+        5,
+        {{"Off", TriggerOff},
+         {"Level", TriggerLevel},
+         {"Patt", TriggerPattern}}};
+
+    // Mean block power, relative to a full scale tone.
+    NumberField field_trigger_level{
+        {11 * 8, 5 * 16},
+        3,
+        {-90, 0},
+        1,
+        ' '};
+
+    Text text_trigger_unit{
+        {14 * 8, 5 * 16, 2 * 8, 16},
+        "dB"};
+
+    // On/off state of the last blocks, the newest on the right. X is either.
+    SymField field_trigger_pattern{
+        {17 * 8, 5 * 16},
+        8,
+        "X01"};
+
     RecordView record_view{
         {0 * 8, 2 * 16, 30 * 8, 1 * 16},
         u"BBD_????.*",
@@ -125,7 +208,19 @@ class CaptureAppView : public View {
             this->on_freqchg(message->freq);
         }};
 
+    MessageHandlerRegistration message_handler_capture_statistics{
+        Message::ID::CaptureStatistics,
+        [this](Message* const p) {
+            const auto message = static_cast<const CaptureStatisticsMessage*>(p);
+            this->on_capture_statistics(*message);
+        }};
+
     void on_freqchg(int64_t freq);
+    void on_capture_statistics(const CaptureStatisticsMessage& statistics);
+    void update_capture_rate(uint32_t new_capture_rate);
+    void update_decimation();
+    void update_chain_load();
+    void update_trigger();
 };
 
 } /* namespace ui */
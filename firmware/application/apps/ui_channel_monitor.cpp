@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "ui_channel_monitor.hpp"
+
+#include "audio.hpp"
+#include "portapack.hpp"
+#include "string_format.hpp"
+
+#include <algorithm>
+#include <bitset>
+
+using namespace portapack;
+
+namespace ui {
+
+/* ChannelMonitorList ****************************************************/
+
+ChannelMonitorList::ChannelMonitorList(Rect parent_rect)
+    : Widget{parent_rect} {
+    set_focusable(true);
+}
+
+void ChannelMonitorList::paint(Painter& painter) {
+    const auto rect = screen_rect();
+    const auto theme = Theme::getInstance();
+
+    for (size_t c = 0; c < channel_count; c++) {
+        const Point line{rect.left(), rect.top() + static_cast<int>(c) * line_height};
+        const bool routed = route_mask_ & (1 << c);
+        const bool open = open_mask_ & (1 << c);
+
+        const auto frequency = center_frequency_ +
+                               (static_cast<int32_t>(c) - static_cast<int32_t>(channel_count / 2)) *
+                                   ChannelizerConfigureMessage::channel_spacing;
+        const auto text = std::string{routed ? ">" : " "} + to_string_short_freq(frequency) + " ";
+
+        const auto& style = open ? *theme->fg_green : *theme->fg_light;
+        painter.draw_string(line, (has_focus() && (c == selected_)) ? style.invert() : style, text);
+
+        const int32_t level = std::clamp<int32_t>(power_db_[c] + bar_range_db, 0, bar_range_db);
+        const int bar = level * bar_width / bar_range_db;
+        const Color bar_color = open ? theme->fg_green->foreground : theme->fg_medium->foreground;
+        painter.fill_rectangle({line.x() + bar_x, line.y() + 4, bar, line_height - 8}, bar_color);
+        painter.fill_rectangle({line.x() + bar_x + bar, line.y() + 4, bar_width - bar, line_height - 8}, theme->bg_darkest->background);
+
+        painter.draw_string({line.x() + level_x, line.y()}, style, to_string_dec_int(power_db_[c], 4));
+    }
+}
+
+void ChannelMonitorList::on_focus() {
+    set_dirty();
+}
+
+void ChannelMonitorList::on_blur() {
+    set_dirty();
+}
+
+bool ChannelMonitorList::on_key(const KeyEvent key) {
+    if (key == KeyEvent::Select) {
+        if (on_select)
+            on_select(selected_);
+        return true;
+    }
+
+    // Let focus leave the list at either end.
+    if (key == KeyEvent::Up && selected_ > 0) {
+        selected_--;
+    } else if (key == KeyEvent::Down && selected_ < channel_count - 1) {
+        selected_++;
+    } else {
+        return false;
+    }
+
+    set_dirty();
+    return true;
+}
+
+bool ChannelMonitorList::on_encoder(const EncoderEvent delta) {
+    selected_ = std::clamp<int32_t>(selected_ + delta, 0, channel_count - 1);
+    set_dirty();
+    return true;
+}
+
+void ChannelMonitorList::set_center_frequency(const rf::Frequency frequency) {
+    center_frequency_ = frequency;
+    set_dirty();
+}
+
+void ChannelMonitorList::set_route_mask(const uint16_t mask) {
+    route_mask_ = mask;
+    set_dirty();
+}
+
+void ChannelMonitorList::set_status(const ChannelizerStatusMessage& status) {
+    power_db_ = status.power_db;
+    open_mask_ = status.open_mask;
+    set_dirty();
+}
+
+/* ChannelMonitorView ****************************************************/
+
+ChannelMonitorView::ChannelMonitorView(NavigationView& nav)
+    : nav_{nav} {
+    add_children({&labels,
+                  &field_lna,
+                  &field_vga,
+                  &field_rf_amp,
+                  &field_volume,
+                  &button_frequency,
+                  &field_squelch,
+                  &field_deviation,
+                  &channel_list});
+
+    baseband::run_image(portapack::spi_flash::image_tag_channelizer);
+
+    // The channelizer ignores the NBFM configuration this sends; the mode
+    // only keeps the receiver on the fs / 4 offset tuning its front end expects.
+    receiver_model.set_modulation(ReceiverModel::Mode::NarrowbandFMAudio);
+    receiver_model.set_sampling_rate(3200000);
+    receiver_model.set_baseband_bandwidth(1750000);
+
+    set_frequency(receiver_model.target_frequency());
+
+    button_frequency.on_select = [this](ButtonWithEncoder&) {
+        auto new_view = nav_.push<FrequencyKeypadView>(receiver_model.target_frequency());
+        new_view->on_changed = [this](rf::Frequency f) {
+            set_frequency(f);
+        };
+    };
+
+    // The encoder moves the whole bank by one channel.
+    button_frequency.on_change = [this]() {
+        const int64_t frequency = receiver_model.target_frequency() +
+                                  button_frequency.get_encoder_delta() * ChannelizerConfigureMessage::channel_spacing;
+        button_frequency.set_encoder_delta(0);
+        set_frequency(std::clamp<int64_t>(frequency, 1, MAX_UFREQ));
+    };
+
+    field_squelch.set_value(squelch_db_);
+    field_squelch.on_change = [this](int32_t v) {
+        squelch_db_ = v;
+        update_channelizer();
+    };
+
+    field_deviation.set_by_value(deviation_);
+    field_deviation.on_change = [this](size_t, OptionsField::value_t v) {
+        deviation_ = v;
+        update_channelizer();
+    };
+
+    route_mask_ &= (1 << ChannelizerConfigureMessage::channel_count) - 1;
+    channel_list.set_route_mask(route_mask_);
+    channel_list.on_select = [this](const size_t channel) {
+        on_channel_selected(channel);
+    };
+
+    update_channelizer();
+    receiver_model.enable();
+
+    audio::output::start();
+    receiver_model.set_headphone_volume(receiver_model.headphone_volume());  // WM8731 hack.
+}
+
+ChannelMonitorView::~ChannelMonitorView() {
+    audio::output::stop();
+    receiver_model.disable();
+    baseband::shutdown();
+}
+
+void ChannelMonitorView::focus() {
+    channel_list.focus();
+}
+
+void ChannelMonitorView::set_frequency(const rf::Frequency frequency) {
+    receiver_model.set_target_frequency(frequency);
+    button_frequency.set_text("<" + to_string_short_freq(frequency) + ">");
+    channel_list.set_center_frequency(frequency);
+}
+
+void ChannelMonitorView::on_channel_selected(const size_t channel) {
+    const uint32_t bit = 1 << channel;
+
+    // Only so many channels can be demodulated at once.
+    if (!(route_mask_ & bit) && (std::bitset<32>(route_mask_).count() >= ChannelizerConfigureMessage::max_routes))
+        return;
+
+    route_mask_ ^= bit;
+    channel_list.set_route_mask(route_mask_);
+    update_channelizer();
+}
+
+void ChannelMonitorView::update_channelizer() {
+    baseband::set_channelizer(route_mask_, squelch_db_, deviation_);
+}
+
+} /* namespace ui */
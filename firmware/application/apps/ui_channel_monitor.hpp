@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __UI_CHANNEL_MONITOR_H__
+#define __UI_CHANNEL_MONITOR_H__
+
+#include "app_settings.hpp"
+#include "baseband_api.hpp"
+#include "message.hpp"
+#include "radio_state.hpp"
+#include "receiver_model.hpp"
+#include "ui.hpp"
+#include "ui_navigation.hpp"
+#include "ui_receiver.hpp"
+#include "ui_widget.hpp"
+
+#include <functional>
+
+namespace ui {
+
+/* One line per channelizer channel: a mark when it feeds the audio, its
+ * centre frequency, a power bar that turns green while the squelch is
+ * open, and the level in dBFS. */
+class ChannelMonitorList : public Widget {
+   public:
+    std::function<void(size_t)> on_select{};
+
+    ChannelMonitorList(Rect parent_rect);
+
+    void paint(Painter& painter) override;
+    void on_focus() override;
+    void on_blur() override;
+    bool on_key(const KeyEvent key) override;
+    bool on_encoder(const EncoderEvent delta) override;
+
+    void set_center_frequency(const rf::Frequency frequency);
+    void set_route_mask(const uint16_t mask);
+    void set_status(const ChannelizerStatusMessage& status);
+
+   private:
+    static constexpr size_t channel_count = ChannelizerConfigureMessage::channel_count;
+    static constexpr int line_height = 16;
+    static constexpr int bar_x = 11 * 8;
+    static constexpr int bar_width = 13 * 8;
+    static constexpr int level_x = 25 * 8;
+    static constexpr int32_t bar_range_db = 120;
+
+    rf::Frequency center_frequency_{0};
+    uint16_t route_mask_{0};
+    uint16_t open_mask_{0};
+    std::array<int8_t, channel_count> power_db_{};
+    size_t selected_{0};
+};
+
+class ChannelMonitorView : public View {
+   public:
+    ChannelMonitorView(NavigationView& nav);
+    ~ChannelMonitorView();
+
+    void focus() override;
+
+    std::string title() const override { return "Chan Mon"; };
+
+   private:
+    NavigationView& nav_;
+    RxRadioState radio_state_{};
+
+    uint32_t route_mask_{1 << (ChannelizerConfigureMessage::channel_count / 2)};
+    uint8_t squelch_db_{10};
+    uint32_t deviation_{5000};
+
+    app_settings::SettingsManager settings_{
+        "rx_chanmon",
+        app_settings::Mode::RX,
+        {
+            {"route_mask"sv, &route_mask_},
+            {"squelch_db"sv, &squelch_db_},
+            {"deviation"sv, &deviation_},
+        }};
+
+    Labels labels{
+        {{0 * 8, 0 * 16}, "LNA:   VGA:   AMP:  VOL:     ", Theme::getInstance()->fg_light->foreground},
+        {{15 * 8, 1 * 16}, "SQ:   DEV:", Theme::getInstance()->fg_light->foreground},
+        {{0 * 8, 2 * 16}, " Frequency  Power        dBFS", Theme::getInstance()->fg_light->foreground},
+    };
+
+    LNAGainField field_lna{
+        {4 * 8, 0 * 16}};
+
+    VGAGainField field_vga{
+        {11 * 8, 0 * 16}};
+
+    RFAmpField field_rf_amp{
+        {18 * 8, 0 * 16}};
+
+    AudioVolumeField field_volume{
+        {24 * 8, 0 * 16}};
+
+    ButtonWithEncoder button_frequency{
+        {0 * 8, 1 * 16, 14 * 8, 1 * 16},
+        ""};
+
+    NumberField field_squelch{
+        {18 * 8, 1 * 16},
+        2,
+        {0, 40},
+        1,
+        ' ',
+    };
+
+    OptionsField field_deviation{
+        {25 * 8, 1 * 16},
+        3,
+        {{"2k5", 2500},
+         {" 5k", 5000}}};
+
+    ChannelMonitorList channel_list{
+        {0 * 8, 3 * 16, 240, ChannelizerConfigureMessage::channel_count * 16}};
+
+    void set_frequency(const rf::Frequency frequency);
+    void on_channel_selected(const size_t channel);
+    void update_channelizer();
+
+    MessageHandlerRegistration message_handler_status{
+        Message::ID::ChannelizerStatus,
+        [this](const Message* const p) {
+            this->channel_list.set_status(*static_cast<const ChannelizerStatusMessage*>(p));
+        }};
+};
+
+} /* namespace ui */
+
+#endif /*__UI_CHANNEL_MONITOR_H__*/
@@ -26,6 +26,7 @@
 #include "portapack.hpp"
 #include "ui_fileman.hpp"
 #include "file_path.hpp"
+#include "metadata_file.hpp"
 
 using namespace portapack;
 namespace fs = std::filesystem;
@@ -43,6 +44,7 @@ IQTrimView::IQTrimView(NavigationView& nav)
         &text_max,
         &field_cutoff,
         &field_amplify,
+        &button_mark,
         &button_trim,
     });
 
@@ -80,6 +82,11 @@ IQTrimView::IQTrimView(NavigationView& nav)
         refresh_ui();
     };
 
+    button_mark.on_select = [this](Button&) {
+        if (mark_capture())
+            nav_.display_modal("IQ Trim", "Range saved, replays\nwill play only it.");
+    };
+
     button_trim.on_select = [this](Button&) {
         if (trim_capture()) {
             profile_capture();
@@ -98,6 +105,7 @@ void IQTrimView::open_file(const std::filesystem::path& path) {
     path_ = std::move(path);
     profile_capture();
     compute_range();
+    load_marked_range();
     refresh_ui();
 }
 
@@ -213,10 +221,72 @@ bool IQTrimView::trim_capture() {
     trimmed = iq::trim_capture_with_range(path_, trim_range, progress_ui.get_callback(), field_amplify.value());
     progress_ui.clear();
 
-    if (!trimmed)
+    if (!trimmed) {
         nav_.display_modal("Error", "Trimming failed.");
+        return false;
+    }
+
+    // Sample numbers changed, a stored range no longer applies.
+    const auto metadata_path = get_metadata_path(path_);
+    auto metadata = read_metadata_file(metadata_path);
+    if (metadata && metadata->trim_end) {
+        metadata->trim_start = 0;
+        metadata->trim_end = 0;
+        write_metadata_file(metadata_path, *metadata);
+    }
+
+    return true;
+}
+
+bool IQTrimView::mark_capture() {
+    if (!info_) {
+        nav_.display_modal("Error", "Open a file first.");
+        return false;
+    }
+
+    const uint64_t start = field_start.value();
+    const uint64_t end = field_end.value();
+    if (start >= end) {
+        nav_.display_modal("Error", "Invalid trimming range.");
+        return false;
+    }
+
+    if (field_amplify.value() > 1) {
+        nav_.display_modal("Error", "Amplify needs Trim,\nMark keeps the samples.");
+        return false;
+    }
+
+    const auto metadata_path = get_metadata_path(path_);
+    auto metadata = read_metadata_file(metadata_path);
+    if (!metadata) {
+        nav_.display_modal("Error", "Mark needs the\ncapture's .TXT file.");
+        return false;
+    }
+
+    // The whole file is the same as no trim.
+    const bool whole = start == 0 && end >= info_->sample_count;
+    metadata->trim_start = whole ? 0 : start;
+    metadata->trim_end = whole ? 0 : end;
+
+    if (write_metadata_file(metadata_path, *metadata)) {
+        nav_.display_modal("Error", "Can't write metadata.");
+        return false;
+    }
+    return true;
+}
+
+void IQTrimView::load_marked_range() {
+    if (!info_)
+        return;
+
+    auto metadata = read_metadata_file(get_metadata_path(path_));
+    if (!metadata || metadata->trim_end <= metadata->trim_start)
+        return;
 
-    return trimmed;
+    update_range_controls({
+        metadata->trim_start,
+        std::min(metadata->trim_end, info_->sample_count),
+        info_->sample_size});
 }
 
 }  // namespace ui
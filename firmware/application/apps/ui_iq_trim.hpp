@@ -92,6 +92,12 @@ class IQTrimView : public View {
     /* Trims the capture file based on the settings. */
     bool trim_capture();
 
+    /* Stores the range in the capture metadata; replays play only that range. */
+    bool mark_capture();
+
+    /* Shows the stored virtual trim instead of the computed range. */
+    void load_marked_range();
+
     NavigationView& nav_;
 
     std::filesystem::path path_{};
@@ -154,6 +160,10 @@ class IQTrimView : public View {
         1,
         ' '};
 
+    Button button_mark{
+        {2 * 8, 16 * 16, 8 * 8, 2 * 16},
+        "Mark"};
+
     Button button_trim{
         {20 * 8, 16 * 16, 8 * 8, 2 * 16},
         "Trim"};
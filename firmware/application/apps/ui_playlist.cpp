@@ -30,6 +30,7 @@
 #include "file_reader.hpp"
 #include "io_file.hpp"
 #include "io_convert.hpp"
+#include "io_range.hpp"
 #include "oversample.hpp"
 #include "portapack.hpp"
 #include "portapack_persistent_memory.hpp"
@@ -95,10 +96,21 @@ Optional<PlaylistView::playlist_entry> PlaylistView::load_entry(fs::path&& path)
     if (!metadata)
         metadata = {transmitter_model.target_frequency(), 500'000};
 
+    // Packed captures are played back as C16, size them by the decoded length.
+    auto file_size = capture_file.size();
+    if (is_packed_capture_file(path) && metadata->sample_count)
+        file_size = metadata->sample_count * sizeof(complex16_t);
+
+    // A virtual trim only plays its range.
+    if (metadata->trim_end > metadata->trim_start) {
+        const auto sample_size = is_packed_capture_file(path) ? sizeof(complex16_t) : capture_file_sample_size(path);
+        file_size = std::min<File::Size>(file_size, (metadata->trim_end - metadata->trim_start) * sample_size);
+    }
+
     return playlist_entry{
         std::move(path),
         *metadata,
-        capture_file.size(),
+        file_size,
         0u};
 }
 
@@ -280,10 +292,11 @@ void PlaylistView::send_current_track() {
 
     // Reset the transmit progress bar.
     progressbar_transmit.set_value(0);
+    progress_offset_ = 0;
 
     // Use the ReplayThread class to send the data.
     replay_thread_ = std::make_unique<ReplayThread>(
-        std::move(reader),
+        apply_trim(std::move(reader), current()->metadata.trim_start, current()->metadata.trim_end, sizeof(complex16_t)),
         /* read_size */ 0x4000,
         /* buffer_count */ 3,
         &ready_signal_,
@@ -294,6 +307,44 @@ void PlaylistView::send_current_track() {
 
     // Now it's sending, update the UI.
     update_ui();
+    preroll_next_track();
+}
+
+/* Queues the following track on the running ReplayThread so it starts without
+ * a gap. Only tracks the radio can send unchanged qualify, the others are
+ * started by handle_replay_thread_done as before. */
+void PlaylistView::preroll_next_track() {
+    if (!is_active() || !current())
+        return;
+
+    auto next_index = current_index_ + 1;
+    if (next_index >= playlist_db_.size()) {
+        if (!check_loop.value())
+            return;
+        next_index = 0;
+    }
+
+    const auto& next = playlist_db_[next_index];
+    if (next.metadata.sample_rate != current()->metadata.sample_rate ||
+        next.metadata.center_frequency != current()->metadata.center_frequency)
+        return;
+
+    auto reader = std::make_unique<FileConvertReader>();
+    if (reader->open(next.path))
+        return;  // Reported when the track comes up the slow way.
+
+    // The track delay becomes silence in the stream, which also keeps its timing exact.
+    const File::Size gap_bytes = uint64_t(next.ms_delay) * next.metadata.sample_rate / 1000 * sizeof(complex16_t);
+
+    const bool queued = replay_thread_->queue_next(
+        apply_trim(std::move(reader), next.metadata.trim_start, next.metadata.trim_end, sizeof(complex16_t)),
+        gap_bytes,
+        [](uint32_t stream_offset) {
+            ReplayThreadNextMessage message{stream_offset};
+            EventDispatcher::send_message(message);
+        });
+    if (queued)
+        preroll_index_ = next_index;
 }
 
 void PlaylistView::stop() {
@@ -327,7 +378,7 @@ void PlaylistView::update_ui() {
         text_filename.set(current()->path.filename().string());
         text_sample_rate.set(unit_auto_scale(current()->metadata.sample_rate, 3, (current()->metadata.sample_rate > 1000000) ? 2 : 0) + "Hz");
 
-        uint8_t sample_size = capture_file_sample_size(current()->path);
+        uint8_t sample_size = is_packed_capture_file(current()->path) ? sizeof(complex16_t) : capture_file_sample_size(current()->path);
         auto duration = ms_duration(current()->file_size, current()->metadata.sample_rate, sample_size);
         text_duration.set(to_string_time_ms(duration));
         field_frequency.set_value(current()->metadata.center_frequency);
@@ -346,7 +397,18 @@ void PlaylistView::update_ui() {
 }
 
 void PlaylistView::on_tx_progress(uint32_t progress) {
-    progressbar_transmit.set_value(progress);
+    progressbar_transmit.set_value(progress >= progress_offset_ ? progress - progress_offset_ : 0);
+}
+
+void PlaylistView::handle_replay_thread_next(uint32_t stream_offset) {
+    if (!is_active() || preroll_index_ >= playlist_db_.size())
+        return;
+
+    current_index_ = preroll_index_;
+    progress_offset_ = stream_offset;
+    progressbar_transmit.set_value(0);
+    update_ui();
+    preroll_next_track();
 }
 
 void PlaylistView::handle_replay_thread_done(uint32_t return_code) {
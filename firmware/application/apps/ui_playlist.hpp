@@ -73,6 +73,8 @@ class PlaylistView : public View {
     bool ready_signal_{};  // Used to signal the ReplayThread.
 
     size_t current_index_{0};
+    size_t preroll_index_{0};       // Track queued on the ReplayThread.
+    uint32_t progress_offset_{0};   // TXProgress count where the current track began.
     bool playlist_dirty_{};
     std::vector<playlist_entry> playlist_db_{};
     std::filesystem::path playlist_path_{};
@@ -98,6 +100,7 @@ class PlaylistView : public View {
     void start();
     bool next_track();
     void send_current_track();
+    void preroll_next_track();
     void stop();
 
     void update_ui();
@@ -105,6 +108,7 @@ class PlaylistView : public View {
     /* There are called by Message handlers. */
     void on_tx_progress(uint32_t progress);
     void handle_replay_thread_done(uint32_t return_code);
+    void handle_replay_thread_next(uint32_t stream_offset);
 
     Text text_filename{
         {0 * 8, 0 * 16, 30 * 8, 16}};
@@ -192,6 +196,13 @@ class PlaylistView : public View {
             handle_replay_thread_done(message.return_code);
         }};
 
+    MessageHandlerRegistration message_handler_replay_thread_next{
+        Message::ID::ReplayThreadNext,
+        [this](const Message* p) {
+            auto message = *reinterpret_cast<const ReplayThreadNextMessage*>(p);
+            handle_replay_thread_next(message.stream_offset);
+        }};
+
     MessageHandlerRegistration message_handler_fifo_signal{
         Message::ID::RequestSignal,
         [this](const Message* p) {
@@ -26,6 +26,7 @@
 
 #include "ui_fileman.hpp"
 #include "io_file.hpp"
+#include "io_range.hpp"
 #include "metadata_file.hpp"
 #include "utility.hpp"
 #include "file_path.hpp"
@@ -47,11 +48,26 @@ namespace ui {
 
 void SigGenAppView::set_ready() {
     ready_signal = true;
+
+    if (replay_thread) {
+        // The baseband has allocated the pool by now and may have trimmed it.
+        const auto& state = replay_thread->state();
+        const auto& pool = replay_thread->pool();
+        auto pool_info = "Buf:" + to_string_dec_uint(state.read_size / 1024) + "Kx" +
+                         to_string_dec_uint(state.buffer_count);
+        if (pool.sd_rate)
+            pool_info += " SD:" + to_string_dec_uint(pool.sd_rate / 1000) + "kB/s";
+        if (!pool.sustainable())
+            pool_info += " SLOW";
+        text_pool.set(pool_info);
+    }
 }
 
 void SigGenAppView::on_file_changed(const fs::path& new_file_path) {
     file_path = new_file_path;
-    File::Size file_size{};
+    file_size = 0;
+    trim_start = 0;
+    trim_end = 0;
 
     {  // Get the size of the data file.
         File data_file;
@@ -74,19 +90,27 @@ void SigGenAppView::on_file_changed(const fs::path& new_file_path) {
             metadata->center_frequency = transmitter_model.target_frequency();
         }
         field_frequency.set_value(metadata->center_frequency);
-        transmitter_model.set_sampling_rate(metadata->sample_rate);
+        file_sample_rate = metadata->sample_rate;
+
+        if (metadata->trim_end > metadata->trim_start) {
+            trim_start = metadata->trim_start;
+            trim_end = metadata->trim_end;
+            file_size = std::min<File::Size>(file_size, (trim_end - trim_start) * sizeof(complex8_t));
+        }
+    } else {
+        file_sample_rate = transmitter_model.sampling_rate();
     }
 
+    capture_size = file_size;
+    find_file_bursts();
+
     transmitter_model.set_baseband_bandwidth(1'750'000);
+    update_sample_rate();
 
     // UI Fixup.
-    text_sample_rate.set(unit_auto_scale(transmitter_model.sampling_rate(), 3, 1) + "Hz");
-    progressbar.set_max(file_size);
     //text_filename.set(truncate(file_path.filename().string(), 12));
     text_filename.set(file_path.filename().string());
-
-    auto duration = ms_duration(file_size, transmitter_model.sampling_rate(), 2);
-    text_duration.set(to_string_time_ms(duration));
+    update_selection();
 
     // TODO: fix in UI framework with 'try_focus()'?
     // Hack around focus getting called by ctor before parent is set.
@@ -94,8 +118,96 @@ void SigGenAppView::on_file_changed(const fs::path& new_file_path) {
         button_play.focus();
 }
 
+void SigGenAppView::find_file_bursts() {
+    bursts.clear();
+
+    // The buckets match the cached envelope, so a capture that was opened
+    // before is split without reading it again.
+    std::vector<iq::PowerBuckets::Bucket> storage(iq::PowerEnvelope::max_points);
+    iq::PowerBuckets buckets{
+        .p = storage.data(),
+        .size = storage.size()};
+
+    auto info = iq::profile_capture(file_path, buckets);
+    if (info) {
+        bursts = iq::find_bursts(*info, buckets, burst_cutoff_percent);
+
+        // Keep to the virtual trim, the bursts replay the raw file.
+        if (trim_end > trim_start) {
+            std::vector<iq::BurstSegment> kept{};
+            for (auto burst : bursts) {
+                const auto start = std::max(burst.start_sample, trim_start);
+                const auto end = std::min(burst.start_sample + burst.sample_count, trim_end);
+                if (end > start)
+                    kept.push_back({start, end - start, burst.peak_power});
+            }
+            bursts = std::move(kept);
+        }
+    }
+
+    OptionsField::options_t options{
+        {"File", burst_whole_file}};
+    if (!bursts.empty())
+        options.push_back({"All", burst_all});
+    for (size_t i = 0; i < bursts.size(); i++)
+        options.push_back({to_string_dec_uint(i + 1), static_cast<int32_t>(i + 1)});
+
+    field_burst.set_options(std::move(options));
+    field_burst.set_by_value(burst_whole_file);
+    text_burst_count.set("of " + to_string_dec_uint(bursts.size()));
+}
+
+std::vector<SegmentReader::Segment> SigGenAppView::selected_segments() const {
+    std::vector<SegmentReader::Segment> segments{};
+    const auto selected = field_burst.selected_index_value();
+
+    for (size_t i = 0; i < bursts.size(); i++) {
+        if (selected == burst_all || selected == static_cast<int32_t>(i + 1))
+            segments.push_back({bursts[i].start_sample * sizeof(complex8_t),
+                                bursts[i].sample_count * sizeof(complex8_t)});
+    }
+
+    return segments;
+}
+
+File::Size SigGenAppView::burst_gap_bytes() const {
+    return static_cast<uint64_t>(field_burst_gap.value()) * file_sample_rate / 1000 * sizeof(complex8_t);
+}
+
+void SigGenAppView::update_selection() {
+    const auto segments = selected_segments();
+    if (segments.empty()) {
+        file_size = capture_size;
+    } else {
+        const auto gap_bytes = burst_gap_bytes();
+        file_size = 0;
+        for (const auto& segment : segments)
+            file_size += segment.size + gap_bytes;
+    }
+
+    progressbar.set_max(file_size);
+    auto duration = ms_duration(file_size, file_sample_rate, 2);
+    text_duration.set(to_string_time_ms(duration));
+}
+
 void SigGenAppView::on_tx_progress(const uint32_t progress) {
-    progressbar.set_value(progress);
+    // Progress keeps counting across loops.
+    progressbar.set_value(file_size ? progress % file_size : progress);
+}
+
+void SigGenAppView::on_tx_underrun(const ReplayUnderrunStatistics& statistics) {
+    const auto sample_rate = file_sample_rate;
+    const auto first_ms = ms_duration(statistics.first_position, sample_rate, 2);
+    const auto last_ms = ms_duration(statistics.last_position, sample_rate, 2);
+
+    text_underruns.set(
+        "Gaps:" + to_string_dec_uint(statistics.count) + " " +
+        to_string_time_ms(first_ms) + "-" + to_string_time_ms(last_ms));
+
+    if (statistics.aborted && is_transmitting) {
+        toggle();
+        nav_.display_modal("Error", "TX underrun, stopped.");
+    }
 }
 
 void SigGenAppView::focus() {
@@ -117,18 +229,13 @@ bool SigGenAppView::is_active() const {
 
 void SigGenAppView::toggle() {
     if (is_transmitting) {
-        stop_cyclic();
         stop(false);
         is_transmitting = FALSE;
         button_play.set_bitmap(&bitmap_play);
     } else {
+        text_underruns.set("Gaps:0");
         save_last_config();   //保存预计发送的文件，用于下次开机能够自动加载前一次发射的文件。
-        if(check_cycle_enable.value() && field_cycle_pause.value() != 0){    //如果开启了间隔发射模式则进入间隔发射流程
-            cyclic_tx_ctr(TRUE);
-        }
-        else{
-            start();
-        }
+        start();
         if(is_active())
         {
             is_transmitting = TRUE;
@@ -150,15 +257,33 @@ void SigGenAppView::start() {
         reader = std::move(p);
     }
 
+    // Bursts are played by seeking through the capture, not copied out.
+    auto segments = selected_segments();
+    if (segments.empty()) {
+        reader = apply_trim(std::move(reader), trim_start, trim_end, sizeof(complex8_t));
+    } else {
+        reader = std::make_unique<SegmentReader>(std::move(reader), std::move(segments), burst_gap_bytes());
+    }
+
     if (reader) {
+        configure_gate();
+        baseband::set_replay_rate(file_sample_rate, tx_sample_rate());
+        configure_mixer();
+
         replay_thread = std::make_unique<ReplayThread>(
             std::move(reader),
-            read_size, buffer_count,
+            file_sample_rate,
             &ready_signal,
             [](uint32_t return_code) {
                 ReplayThreadDoneMessage message{return_code};
                 EventDispatcher::send_message(message);
-            });
+            },
+            static_cast<ReplayFillPolicy>(field_fill_policy.selected_index_value()));
+
+        // Cyclic transmission wraps inside the replay thread instead of
+        // restarting it, so there is no gap at the loop point. The on/off
+        // keying is done by the baseband on the running stream.
+        replay_thread->set_loop(check_cycle_enable.value());
     }
 
     transmitter_model.enable();
@@ -168,17 +293,9 @@ void SigGenAppView::stop(const bool do_loop) {
     transmitter_model.disable();
     if (is_active())
         replay_thread.reset();
-    //1.doloop为真，文件读完了，没有开启循环发送时，就直接结束。这时需要更新UI,直接触发toggle就可以。（只有文件读完，doloop为true）
-    //2.doloop为真，文件读完了，开启了循环发送，这个时候判断是否开启了间隔发送，间隔发送用cycle_pause，来判断，如没有开启间隔发送，则持续性循环发送，则进入start()。
-    //3.doloop为真，文件读完了，开启了循环发送，这个时候判断是否开启了间隔发送，间隔发送用cycle_pause，来判断，如开启间隔发送，撒也不干，因为下次开始发数据是定时器来调。
-    //4.doloop为假，既不需要更新ui，也不需要重新开始。
-    if (do_loop && !check_cycle_enable.value()) {  //一次性发送
+    // The file ended without looping: a one-shot transmission is done.
+    if (do_loop && is_transmitting)
         toggle();
-    }else if(do_loop && check_cycle_enable.value()){
-        if(field_cycle_pause.value() == 0){   //长发
-            start();
-        }        
-    } 
 
     ready_signal = false;
 }
@@ -188,7 +305,6 @@ void SigGenAppView::handle_replay_thread_done(const uint32_t return_code) {
         stop(true);
     } else if (return_code == ReplayThread::READ_ERROR) {
         stop(false);
-        stop_cyclic();
         file_error();
     }
 
@@ -217,7 +333,27 @@ SigGenAppView::SigGenAppView(
         &text_cycle_tx,
         &field_cycle_tx,
         &text_cycle_pause,
-        &field_cycle_pause
+        &field_cycle_pause,
+        &text_fill_policy,
+        &field_fill_policy,
+        &text_underruns,
+        &text_pool,
+        &text_tx_rate,
+        &field_tx_rate,
+        &text_resample,
+        &text_shift,
+        &field_shift,
+        &text_shift_unit,
+        &text_digital_gain,
+        &field_digital_gain,
+        &text_digital_gain_unit,
+        &check_soft_clip,
+        &text_burst,
+        &field_burst,
+        &text_burst_count,
+        &text_burst_gap,
+        &field_burst_gap,
+        &text_burst_gap_unit
         //&waterfall,
     });
 
@@ -238,8 +374,51 @@ SigGenAppView::SigGenAppView(
 
     //enable为1，pause为0，则默认开启长发。  tx的值不为0就行。
     check_cycle_enable.set_value(TRUE);
-    field_cycle_tx.set_value(5);
+    field_cycle_tx.set_value(5000);
     field_cycle_pause.set_value(0);   
+    // The gate is counted on the baseband, so it follows the fields while transmitting.
+    check_cycle_enable.on_select = [this](Checkbox&, bool value) {
+        if (replay_thread)
+            replay_thread->set_loop(value);
+        configure_gate();
+    };
+    field_cycle_tx.on_change = [this](int32_t) {
+        configure_gate();
+    };
+    field_cycle_pause.on_change = [this](int32_t) {
+        configure_gate();
+    };
+
+    field_fill_policy.set_by_value(static_cast<int32_t>(ReplayFillPolicy::Zero));
+    field_tx_rate.set_by_value(0);
+    field_tx_rate.on_change = [this](size_t, OptionsField::value_t) {
+        update_sample_rate();
+        // The resampler ratio and the gate's sample counts follow the TX rate.
+        if (is_active()) {
+            baseband::set_replay_rate(file_sample_rate, tx_sample_rate());
+            configure_gate();
+        }
+    };
+
+    field_shift.set_value(0);
+    field_digital_gain.set_value(0);
+    field_shift.on_change = [this](int32_t) {
+        configure_mixer();
+    };
+    field_digital_gain.on_change = [this](int32_t) {
+        configure_mixer();
+    };
+    check_soft_clip.on_select = [this](Checkbox&, bool) {
+        configure_mixer();
+    };
+
+    field_burst_gap.set_value(0);
+    field_burst.on_change = [this](size_t, OptionsField::value_t) {
+        update_selection();
+    };
+    field_burst_gap.on_change = [this](int32_t) {
+        update_selection();
+    };
 
     button_load_last_config.on_select = [this, &nav](Button&) {
         load_last_config();
@@ -283,15 +462,43 @@ void SigGenAppView::load_last_config(){
                     break;
 
                 case 2: //第六行是cycle tx time
-                    field_cycle_tx.set_value(static_cast<int32_t>(std::stoi(line.c_str())));
+                    field_cycle_tx.set_value(cycle_ms_from_config(std::stoi(line.c_str())));
                     //UsbSerialAsyncmsg::asyncmsg(static_cast<uint32_t>(std::stoi(line.c_str())));
                     break;
 
                 case 3: //第五行是cycle pause time
-                    field_cycle_pause.set_value(static_cast<int32_t>(std::stoi(line.c_str())));
+                    field_cycle_pause.set_value(cycle_ms_from_config(std::stoi(line.c_str())));
                     //UsbSerialAsyncmsg::asyncmsg(static_cast<uint32_t>(std::stoi(line.c_str())));
                     break;
 
+                case 4:  // Underrun fill policy
+                    field_fill_policy.set_by_value(static_cast<int32_t>(std::stoi(line.c_str())));
+                    break;
+
+                case 5:  // TX sample rate, 0 follows the file
+                    field_tx_rate.set_by_value(static_cast<int32_t>(std::stoi(line.c_str())));
+                    break;
+
+                case 6:  // Digital frequency shift, kHz
+                    field_shift.set_value(std::stoi(line.c_str()));
+                    break;
+
+                case 7:  // Digital gain, dB
+                    field_digital_gain.set_value(std::stoi(line.c_str()));
+                    break;
+
+                case 8:  // Soft clip
+                    check_soft_clip.set_value(static_cast<bool>(std::stoi(line.c_str())));
+                    break;
+
+                case 9:  // Burst selection, the file's bursts are known by now
+                    field_burst.set_by_value(static_cast<int32_t>(std::stoi(line.c_str())));
+                    break;
+
+                case 10:  // Gap after each burst, ms
+                    field_burst_gap.set_value(std::stoi(line.c_str()));
+                    break;
+
             }        
     }
     return;
@@ -328,46 +535,71 @@ void SigGenAppView::save_last_config(){
     config_content += "\r\n";   //第六行为循环发送中的发射时间
     config_content += std::to_string(field_cycle_pause.value()); //field_cycle_pause.value().string();
     config_content += "\r\n";   //第七行为循环发送中的暂停时间
+    config_content += std::to_string(field_fill_policy.selected_index_value());
+    config_content += "\r\n";  // Underrun fill policy
+    config_content += std::to_string(field_tx_rate.selected_index_value());
+    config_content += "\r\n";  // TX sample rate
+    config_content += std::to_string(field_shift.value());
+    config_content += "\r\n";  // Digital frequency shift
+    config_content += std::to_string(field_digital_gain.value());
+    config_content += "\r\n";  // Digital gain
+    config_content += std::to_string(check_soft_clip.value());
+    config_content += "\r\n";  // Soft clip
+    config_content += std::to_string(field_burst.selected_index_value());
+    config_content += "\r\n";  // Burst selection
+    config_content += std::to_string(field_burst_gap.value());
+    config_content += "\r\n";  // Burst gap
     //UsbSerialAsyncmsg::asyncmsg(config_content);
 
     auto error_write = config_file.write(config_content.c_str(), config_content.size());
     config_file.close();
 }
 
-void SigGenAppView::stop_cyclic() {
-    if(is_cycle_timer_enabled)
-        chVTReset(&cycle_timer);
-        is_cycle_timer_enabled = FALSE;
+uint32_t SigGenAppView::tx_sample_rate() const {
+    const auto selected = static_cast<uint32_t>(field_tx_rate.selected_index_value());
+    if (selected)
+        return selected;
+
+    return (file_sample_rate >= min_tx_sample_rate) ? file_sample_rate : default_tx_sample_rate;
 }
 
-void SigGenAppView::cycle_cb(void* arg) {
-    auto obj = static_cast<SigGenAppView*>(arg);
-    CyclicTXCtrMessage message;
-    message.CyclicTXCtr = obj->is_active() ? FALSE : TRUE;
-    EventDispatcher::send_message_from_isr(message);
-    return;
+void SigGenAppView::update_sample_rate() {
+    const auto rate = tx_sample_rate();
+    transmitter_model.set_sampling_rate(rate);
+
+    text_sample_rate.set(unit_auto_scale(rate, 3, 1) + "Hz");
+    if (rate == file_sample_rate)
+        text_resample.set("");
+    else
+        text_resample.set("from " + unit_auto_scale(file_sample_rate, 3, 1) + "Hz");
+}
+
+int32_t SigGenAppView::cycle_ms_from_config(const int32_t value) {
+    return (value <= legacy_cycle_seconds_max) ? value * 1000 : value;
 }
 
-//CyclicTXCtr: TRUE tx start; FALSE tx pause;
-void SigGenAppView::cyclic_tx_ctr(bool CyclicTXCtr){
-    std::string cyclic_tx_ctr = "cyclic_tx_ctr function:";
-    std::string tx_start = "cyclic_tx_ctr: tx enable";  
-    std::string tx_pause = "cyclic_tx_ctr: tx pause";
-    //UsbSerialAsyncmsg::asyncmsg(cyclic_tx_ctr);
-    if(CyclicTXCtr){
-        //UsbSerialAsyncmsg::asyncmsg(tx_start);
-        chVTSet(&cycle_timer, S2ST(field_cycle_tx.value()), cycle_cb, this);
-        start(); // 开始信号生成
-    }else{
-        //UsbSerialAsyncmsg::asyncmsg(tx_pause);
-        chVTSet(&cycle_timer, S2ST(field_cycle_pause.value()), cycle_cb, this);
-        stop(false); // 开始信号生成
+void SigGenAppView::configure_gate() {
+    uint64_t on_samples = 0;
+    uint64_t off_samples = 0;
+
+    if (check_cycle_enable.value()) {
+        const uint64_t rate = transmitter_model.sampling_rate();
+        on_samples = rate * field_cycle_tx.value() / 1000;
+        off_samples = rate * field_cycle_pause.value() / 1000;
     }
-    is_cycle_timer_enabled = TRUE;
+
+    baseband::set_replay_gate(on_samples, off_samples);
+}
+
+void SigGenAppView::configure_mixer() {
+    // Takes effect on the next buffer, so it can be adjusted while transmitting.
+    baseband::set_replay_mixer(
+        field_shift.value() * 1000,
+        static_cast<int8_t>(field_digital_gain.value()),
+        check_soft_clip.value());
 }
 
 SigGenAppView::~SigGenAppView() {
-    stop_cyclic();
     transmitter_model.disable();
     baseband::shutdown();
 }
@@ -32,12 +32,14 @@
 #include "ui_receiver.hpp"
 #include "ui_freq_field.hpp"
 #include "replay_thread.hpp"
+#include "io_range.hpp"
+#include "iq_trim.hpp"
 #include "ui_spectrum.hpp"
 #include "ui_transmitter.hpp"
-#include "chvt.h"
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace ui {
 
@@ -64,16 +66,27 @@ class SigGenAppView : public View {
 
     static constexpr ui::Dim header_height = 3 * 16;
 
-    const size_t read_size{16384};
-    const size_t buffer_count{3};
     std::filesystem::path config_file_name = u"/SigGen/config.txt";
 
-    VirtualTimer cycle_timer;
-    bool is_cycle_timer_enabled = false;   //避免在常发状态时，定时器没有启动，但是stop流程会重置定时器导致的中断抢占问题。
-    bool is_transmitting = false;     //因为间隔发送时，repaly线程的active状态就不能标志是否发送中，那么更新开始和停止的UI就会有问题，新增flag用来更新UI。
+    bool is_transmitting = false;
+
+    // Lowest rate the radio transmits at; slower captures are resampled.
+    static constexpr uint32_t min_tx_sample_rate = 2'000'000;
+    static constexpr uint32_t default_tx_sample_rate = 2'600'000;
+
+    // Same default as the IQ trim app.
+    static constexpr uint8_t burst_cutoff_percent = 7;
+
+    // Burst selection values, others pick a single burst by number.
+    static constexpr int32_t burst_whole_file = -1;
+    static constexpr int32_t burst_all = 0;
+
+    // Older configs stored the cycle times in whole seconds.
+    static constexpr int32_t legacy_cycle_seconds_max = 30;
 
     void on_file_changed(const std::filesystem::path& new_file_path);
     void on_tx_progress(const uint32_t progress);
+    void on_tx_underrun(const ReplayUnderrunStatistics& statistics);
 
     void toggle();
     void start();
@@ -86,12 +99,24 @@ class SigGenAppView : public View {
     void load_last_config();
     void save_last_config();
 
-    void stop_cyclic();
-    void start_cycle();
-    static void cycle_cb(void* arg);
-    void cyclic_tx_ctr(bool CyclicTXCtr);
+    void find_file_bursts();
+    void update_selection();
+    std::vector<SegmentReader::Segment> selected_segments() const;
+    File::Size burst_gap_bytes() const;
+
+    void configure_gate();
+    void configure_mixer();
+    void update_sample_rate();
+    uint32_t tx_sample_rate() const;
+    static int32_t cycle_ms_from_config(const int32_t value);
 
     std::filesystem::path file_path{};
+    File::Size file_size{0};     // Of what is replayed, the bursts or the whole file.
+    File::Size capture_size{0};  // Of the virtual trim range when there is one.
+    uint64_t trim_start{0};
+    uint64_t trim_end{0};
+    std::vector<iq::BurstSegment> bursts{};
+    uint32_t file_sample_rate{default_tx_sample_rate};
     std::unique_ptr<ReplayThread> replay_thread{};
     bool ready_signal{false};
 
@@ -138,30 +163,30 @@ class SigGenAppView : public View {
 
     Checkbox check_cycle_enable{
         {0 * 8, 3 * 16},
-        15,
+        12,
         LanguageHelper::currentMessages[LANG_CYCLE_ENABLE],
         true};
 
     Text text_cycle_tx{
-        {17 * 8, 3 * 16, 3 * 8, 1 * 16},
+        {14 * 8, 3 * 16, 2 * 8, 1 * 16},
         "T:"};
 
     NumberField field_cycle_tx{
-        {19 * 8, 3 * 16},
-        2,
-        {1, 30},
-        1,
+        {16 * 8, 3 * 16},
+        5,
+        {50, 60000},
+        50,
         ' '};
 
     Text text_cycle_pause{
-        {23 * 8, 3 * 16, 3 * 8, 1 * 16},
+        {22 * 8, 3 * 16, 2 * 8, 1 * 16},
         "P:"};
 
     NumberField field_cycle_pause{
-        {25 * 8, 3 * 16},
-        2,
-        {0, 30},
-        1,
+        {24 * 8, 3 * 16},
+        5,
+        {0, 60000},
+        50,
         ' '};
 
     ImageButton button_play{
@@ -170,6 +195,109 @@ class SigGenAppView : public View {
         Theme::getInstance()->fg_green->foreground,
         Theme::getInstance()->fg_green->background};
 
+    Text text_fill_policy{
+        {0 * 8, 6 * 16, 5 * 8, 16},
+        "Fill:"};
+
+    OptionsField field_fill_policy{
+        {5 * 8, 6 * 16},
+        6,
+        {{"Zero", static_cast<int32_t>(ReplayFillPolicy::Zero)},
+         {"Repeat", static_cast<int32_t>(ReplayFillPolicy::RepeatLast)},
+         {"Abort", static_cast<int32_t>(ReplayFillPolicy::Abort)}}};
+
+    Text text_underruns{
+        {12 * 8, 6 * 16, 18 * 8, 16},
+        "Gaps:0"};
+
+    Text text_pool{
+        {0 * 8, 7 * 16, 30 * 8, 16},
+        ""};
+
+    Text text_tx_rate{
+        {0 * 8, 8 * 16, 8 * 8, 16},
+        "TX rate:"};
+
+    // Zero replays at the capture's own rate where the radio allows it.
+    OptionsField field_tx_rate{
+        {9 * 8, 8 * 16},
+        5,
+        {{"File", 0},
+         {"2M", 2000000},
+         {"2.6M", 2600000},
+         {"3M", 3072000},
+         {"4M", 4000000}}};
+
+    Text text_resample{
+        {15 * 8, 8 * 16, 15 * 8, 16},
+        ""};
+
+    Text text_shift{
+        {0 * 8, 9 * 16, 6 * 8, 16},
+        "Shift:"};
+
+    // Digital offset in kHz, the baseband clamps it to +/- fs/2.
+    NumberField field_shift{
+        {7 * 8, 9 * 16},
+        5,
+        {-2000, 2000},
+        1,
+        ' '};
+
+    Text text_shift_unit{
+        {13 * 8, 9 * 16, 3 * 8, 16},
+        "kHz"};
+
+    Text text_digital_gain{
+        {0 * 8, 10 * 16, 5 * 8, 16},
+        "Gain:"};
+
+    NumberField field_digital_gain{
+        {7 * 8, 10 * 16},
+        3,
+        {-30, 20},
+        1,
+        ' '};
+
+    Text text_digital_gain_unit{
+        {11 * 8, 10 * 16, 2 * 8, 16},
+        "dB"};
+
+    Checkbox check_soft_clip{
+        {15 * 8, 10 * 16},
+        9,
+        "Soft clip",
+        false};
+
+    Text text_burst{
+        {0 * 8, 11 * 16, 6 * 8, 16},
+        "Burst:"};
+
+    OptionsField field_burst{
+        {7 * 8, 11 * 16},
+        4,
+        {{"File", burst_whole_file}}};
+
+    Text text_burst_count{
+        {12 * 8, 11 * 16, 6 * 8, 16},
+        ""};
+
+    Text text_burst_gap{
+        {19 * 8, 11 * 16, 4 * 8, 16},
+        "Gap:"};
+
+    // Silence after each burst, in ms at the capture's sample rate.
+    NumberField field_burst_gap{
+        {23 * 8, 11 * 16},
+        4,
+        {0, 9999},
+        10,
+        ' '};
+
+    Text text_burst_gap_unit{
+        {27 * 8, 11 * 16, 2 * 8, 16},
+        "ms"};
+
     spectrum::WaterfallView waterfall{};
 
     MessageHandlerRegistration message_handler_replay_thread_error{
@@ -195,11 +323,11 @@ class SigGenAppView : public View {
             this->on_tx_progress(message.progress);
         }};
 
-    MessageHandlerRegistration message_handler_cyclic_tx_ctr{
-        Message::ID::CyclicTxCtr,
+    MessageHandlerRegistration message_handler_tx_underrun{
+        Message::ID::TXUnderrun,
         [this](const Message* const p) {
-            const auto message = *reinterpret_cast<const CyclicTXCtrMessage*>(p);
-            this->cyclic_tx_ctr(message.CyclicTXCtr);
+            const auto message = *reinterpret_cast<const TXUnderrunMessage*>(p);
+            this->on_tx_underrun(message.statistics);
         }};
 };
 
@@ -25,6 +25,7 @@
 #include "tonesets.hpp"
 #include "portapack.hpp"
 #include "baseband_api.hpp"
+#include "ui_fileman.hpp"
 
 #include <cstring>
 #include <stdio.h>
@@ -43,10 +44,14 @@ SigGenView::~SigGenView() {
 }
 
 void SigGenView::update_config() {
+    baseband::set_siggen_carrier(field_offset.value(), options_dds.selected_index_value());
+
+    const auto awg_modulation = static_cast<AWGModulation>(options_awg_modulation.selected_index_value());
+
     if (checkbox_stop.value())
-        baseband::set_siggen_config(transmitter_model.channel_bandwidth(), options_shape.selected_index_value(), field_stop.value());
+        baseband::set_siggen_config(transmitter_model.channel_bandwidth(), options_shape.selected_index_value(), field_stop.value(), awg_modulation);
     else
-        baseband::set_siggen_config(transmitter_model.channel_bandwidth(), options_shape.selected_index_value(), 0);
+        baseband::set_siggen_config(transmitter_model.channel_bandwidth(), options_shape.selected_index_value(), 0, awg_modulation);
 }
 
 void SigGenView::update_tone() {
@@ -73,8 +78,48 @@ void SigGenView::on_tx_progress(const uint32_t progress, const bool done) {
     }
 }
 
+void SigGenView::load_awg_table(const std::filesystem::path& path) {
+    File file;
+    if (file.open(path)) {
+        nav_.display_modal("Error", "File read error.");
+        return;
+    }
+
+    const auto format = path_iequal(path.extension(), u".C8") ? AWGFormat::IQ : AWGFormat::Real;
+    const size_t stride = (format == AWGFormat::IQ) ? 2 : 1;
+    const size_t size = file.size() - (file.size() % stride);
+
+    if (size == 0 || size > awg_table_max_bytes) {
+        nav_.display_modal("Error", "Table must be 1 to\n" + to_string_dec_uint(awg_table_max_bytes) + " bytes.");
+        return;
+    }
+
+    // The whole table goes to baseband RAM now; playback never reads the SD card.
+    baseband::set_awg_table(format, size / stride);
+
+    std::array<uint8_t, awg_chunk_size> chunk{};
+    for (size_t offset = 0; offset < size; offset += chunk.size()) {
+        const auto result = file.read(chunk.data(), std::min(chunk.size(), size - offset));
+        if (result.is_error() || *result == 0) {
+            baseband::set_awg_table(format, 0);
+            nav_.display_modal("Error", "File read error.");
+            return;
+        }
+        baseband::write_awg_table(offset, chunk.data(), *result);
+    }
+
+    text_awg.set(to_string_dec_uint(size / stride) + (format == AWGFormat::IQ ? " IQ" : " smp"));
+}
+
+void SigGenView::on_statistics(const SigGenStatisticsMessage& statistics) {
+    text_cycles.set(
+        "Cycles/buf avg:" + to_string_dec_uint(statistics.cycles_average) +
+        " pk:" + to_string_dec_uint(statistics.cycles_peak));
+}
+
 SigGenView::SigGenView(
-    NavigationView& nav) {
+    NavigationView& nav)
+    : nav_{nav} {
     baseband::run_image(portapack::spi_flash::image_tag_siggen);
 
     add_children({&labels,
@@ -85,6 +130,12 @@ SigGenView::SigGenView(
                   &checkbox_auto,
                   &checkbox_stop,
                   &field_stop,
+                  &button_awg,
+                  &options_awg_modulation,
+                  &text_awg,
+                  &options_dds,
+                  &field_offset,
+                  &text_cycles,
                   &tx_view});
 
     symfield_tone.hidden(1);        // At first launch , by default we are in CW Shape has NO MOD , we are not using Tone modulation.
@@ -105,6 +156,16 @@ SigGenView::SigGenView(
 
     field_stop.set_value(1);
 
+    options_dds.set_by_value(2);  // Interpolated
+    options_dds.on_change = [this](size_t, OptionsField::value_t) {
+        if (auto_update)
+            update_config();
+    };
+    field_offset.on_change = [this](int32_t) {
+        if (auto_update)
+            update_config();
+    };
+
     symfield_tone.set_value(1000);  // Default: 1000 Hz
     symfield_tone.on_change = [this](SymField&) {
         if (auto_update)
@@ -120,6 +181,18 @@ SigGenView::SigGenView(
         auto_update = v;
     };
 
+    button_awg.on_select = [this, &nav](Button&) {
+        auto open_view = nav.push<FileLoadView>("");
+        open_view->on_changed = [this](std::filesystem::path new_file_path) {
+            load_awg_table(new_file_path);
+        };
+    };
+
+    options_awg_modulation.on_change = [this](size_t, OptionsField::value_t) {
+        if (auto_update)
+            update_config();
+    };
+
     tx_view.on_edit_frequency = [this, &nav]() {
         auto new_view = nav.push<FrequencyKeypadView>(transmitter_model.target_frequency());
         new_view->on_changed = [this](rf::Frequency f) {
@@ -30,6 +30,8 @@
 #include "ui_navigation.hpp"
 #include "ui_transmitter.hpp"
 
+#include "file.hpp"
+
 #include "portapack.hpp"
 #include "message.hpp"
 
@@ -45,10 +47,14 @@ class SigGenView : public View {
     std::string title() const override { return "Signal gen"; };
 
    private:
+    NavigationView& nav_;
+
     void start_tx();
     void update_config();
     void update_tone();
     void on_tx_progress(const uint32_t progress, const bool done);
+    void on_statistics(const SigGenStatisticsMessage& statistics);
+    void load_awg_table(const std::filesystem::path& path);
 
     TxRadioState radio_state_{
         0 /* frequency */,
@@ -58,7 +64,9 @@ class SigGenView : public View {
     app_settings::SettingsManager settings_{
         "tx_siggen", app_settings::Mode::TX};
 
-    const std::string shape_strings[9] = {
+    static constexpr size_t awg_chunk_size = 512;  // Size of shared_memory.bb_data.
+
+    const std::string shape_strings[10] = {
         "CW  (No mod.) ",
         "Sine mod. FM",
         "Triangle mod.FM",  // max 15 character text space.
@@ -67,7 +75,8 @@ class SigGenView : public View {
         "Square mod. FM",
         "Pseudo Noise FM",  // using 16 bits LFSR register, 16 order polynomial feedback.
         "BPSK 0,1,0,1...",
-        "QPSK 00-01-10.."};
+        "QPSK 00-01-10..",
+        "AWG table"};  // One table period per tone period, .C8 is I/Q.
 
     bool auto_update{false};
 
@@ -75,7 +84,10 @@ class SigGenView : public View {
         {{3 * 8, 4 + 10}, "Shape:", Theme::getInstance()->fg_light->foreground},
         {{6 * 8, 7 * 8}, "Tone:      Hz", Theme::getInstance()->fg_light->foreground},
         {{22 * 8, 15 * 8 + 4}, "s.", Theme::getInstance()->fg_light->foreground},
-        {{8 * 8, 20 * 8}, "Modulation: FM", Theme::getInstance()->fg_light->foreground}};
+        {{1 * 8, 18 * 8}, "DDS:", Theme::getInstance()->fg_light->foreground},
+        {{13 * 8, 18 * 8}, "Offs:", Theme::getInstance()->fg_light->foreground},
+        {{26 * 8, 18 * 8}, "Hz", Theme::getInstance()->fg_light->foreground},
+        {{1 * 8, 20 * 8}, "AWG:", Theme::getInstance()->fg_light->foreground}};
 
     ImageOptionsField options_shape{
         {10 * 8, 4, 32, 32},
@@ -89,7 +101,8 @@ class SigGenView : public View {
          {&bitmap_sig_square, 5},
          {&bitmap_sig_noise, 6},
          {&bitmap_sig_noise, 7},    // Pending to add a correct BPSK icon.
-         {&bitmap_sig_noise, 8}}};  // Pending to add a correct QPSK icon.
+         {&bitmap_sig_noise, 8},    // Pending to add a correct QPSK icon.
+         {&bitmap_sig_noise, 9}}};  // Pending to add a correct AWG icon.
 
     Text text_shape{
         {15 * 8, 4 + 10, 15 * 8, 16},
@@ -120,6 +133,41 @@ class SigGenView : public View {
         1,
         ' '};
 
+    // Values are dsp::DDS::Mode.
+    OptionsField options_dds{
+        {5 * 8, 18 * 8},
+        6,
+        {{"8bit", 0},
+         {"Table", 1},
+         {"Interp", 2},
+         {"Dither", 3}}};
+
+    NumberField field_offset{
+        {18 * 8, 18 * 8},
+        7,
+        {-750000, 750000},
+        100,
+        ' '};
+
+    Button button_awg{
+        {5 * 8, 20 * 8 - 4, 6 * 8, 3 * 8},
+        "Load"};
+
+    OptionsField options_awg_modulation{
+        {12 * 8, 20 * 8},
+        6,
+        {{"FM", static_cast<int32_t>(AWGModulation::FM)},
+         {"AM", static_cast<int32_t>(AWGModulation::AM)},
+         {"Direct", static_cast<int32_t>(AWGModulation::Direct)}}};
+
+    Text text_awg{
+        {19 * 8, 20 * 8, 11 * 8, 16},
+        "-"};
+
+    Text text_cycles{
+        {0 * 8, 22 * 8, 30 * 8, 16},
+        ""};
+
     TransmitterView tx_view{
         16 * 16,
         10000,
@@ -131,6 +179,13 @@ class SigGenView : public View {
             const auto message = *reinterpret_cast<const TXProgressMessage*>(p);
             this->on_tx_progress(message.progress, message.done);
         }};
+
+    MessageHandlerRegistration message_handler_statistics{
+        Message::ID::SigGenStatistics,
+        [this](const Message* const p) {
+            const auto message = *reinterpret_cast<const SigGenStatisticsMessage*>(p);
+            this->on_statistics(message);
+        }};
 };
 
 } /* namespace ui */
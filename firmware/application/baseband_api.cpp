@@ -31,6 +31,9 @@
 
 #include "core_control.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 /* Set true to enable additional checks to ensure
  * M4 and M0 are synchronized before passing messages. */
 static constexpr bool enforce_core_sync = true;
@@ -310,9 +313,28 @@ void set_siggen_tone(const uint32_t tone) {
     send_message(&message);
 }
 
-void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration) {
+void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration, const AWGModulation awg_modulation) {
     const SigGenConfigMessage message{
-        bw, shape, duration * TONES_SAMPLERATE};
+        bw, shape, duration * TONES_SAMPLERATE, awg_modulation};
+    send_message(&message);
+}
+
+void set_siggen_carrier(const int32_t offset, const uint8_t dds_mode) {
+    const SigGenCarrierMessage message{offset, dds_mode};
+    send_message(&message);
+}
+
+void set_awg_table(const AWGFormat format, const uint32_t length) {
+    const AWGConfigMessage message{format, length};
+    send_message(&message);
+}
+
+void write_awg_table(const uint32_t offset, const uint8_t* const data, const size_t size) {
+    // send_message() waits for the baseband to copy the chunk out.
+    const auto chunk = std::min(size, sizeof(shared_memory.bb_data.data));
+    memcpy(shared_memory.bb_data.data, data, chunk);
+
+    const AWGDataMessage message{offset, chunk};
     send_message(&message);
 }
 
@@ -326,6 +348,12 @@ void set_subghzd_config(uint8_t modulation = 0, uint32_t sampling_rate = 0) {
     send_message(&message);
 }
 
+void set_channelizer(const uint16_t route_mask, const uint8_t squelch_db, const size_t deviation) {
+    const ChannelizerConfigureMessage message{route_mask, squelch_db, deviation};
+    send_message(&message);
+    audio::set_rate(audio::Rate::Hz_24000);
+}
+
 static bool baseband_image_running = false;
 
 void run_image(const spi_flash::image_tag_t image_tag) {
@@ -391,9 +419,13 @@ void shutdown() {
     baseband_image_running = false;
 }
 
-void spectrum_streaming_start() {
+void spectrum_streaming_start(size_t fft_size, SpectrumWindow window, SpectrumAveraging averaging, uint8_t average_count) {
     SpectrumStreamingConfigMessage message{
-        SpectrumStreamingConfigMessage::Mode::Running};
+        SpectrumStreamingConfigMessage::Mode::Running,
+        fft_size,
+        window,
+        averaging,
+        average_count};
     send_message(&message);
 }
 
@@ -403,8 +435,8 @@ void spectrum_streaming_stop() {
     send_message(&message);
 }
 
-void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate) {
-    SampleRateConfigMessage message{sample_rate, oversample_rate};
+void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate, DecimationFilter filter) {
+    SampleRateConfigMessage message{sample_rate, oversample_rate, filter};
     send_message(&message);
 }
 
@@ -428,6 +460,21 @@ void replay_stop() {
     send_message(&message);
 }
 
+void set_replay_gate(const uint64_t on_samples, const uint64_t off_samples) {
+    TXGateConfigMessage message{on_samples, off_samples};
+    send_message(&message);
+}
+
+void set_replay_rate(const uint32_t input_rate, const uint32_t output_rate) {
+    ReplayRateConfigMessage message{input_rate, output_rate};
+    send_message(&message);
+}
+
+void set_replay_mixer(const int32_t frequency_offset, const int8_t gain_db, const bool soft_clip) {
+    ReplayMixerConfigMessage message{frequency_offset, gain_db, soft_clip};
+    send_message(&message);
+}
+
 void request_beep(RequestSignalMessage::Signal beep_type) {
     RequestSignalMessage message{beep_type};
     send_message(&message);
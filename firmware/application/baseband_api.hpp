@@ -86,9 +86,13 @@ void set_jammer(const bool run, const jammer::JammerType type, const uint32_t sp
 void set_rds_data(const uint16_t message_length);
 void set_spectrum(const size_t sampling_rate, const size_t trigger);
 void set_siggen_tone(const uint32_t tone);
-void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration);
+void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration, const AWGModulation awg_modulation = AWGModulation::FM);
+void set_siggen_carrier(const int32_t offset, const uint8_t dds_mode);
+void set_awg_table(const AWGFormat format, const uint32_t length);
+void write_awg_table(const uint32_t offset, const uint8_t* const data, const size_t size);
 void set_spectrum_painter_config(const uint16_t width, const uint16_t height, bool update, int32_t bw);
 void set_subghzd_config(uint8_t modulation, uint32_t sampling_rate);
+void set_channelizer(const uint16_t route_mask, const uint8_t squelch_db, const size_t deviation);
 
 void request_roger_beep();
 void request_rssi_beep();
@@ -99,15 +103,25 @@ void run_image(const portapack::spi_flash::image_tag_t image_tag);
 void run_prepared_image(const uint32_t m4_code);
 void shutdown();
 
-void spectrum_streaming_start();
+void spectrum_streaming_start(
+    size_t fft_size = SpectrumStreamingConfigMessage::min_fft_size,
+    SpectrumWindow window = SpectrumWindow::Hann,
+    SpectrumAveraging averaging = SpectrumAveraging::None,
+    uint8_t average_count = 1);
 void spectrum_streaming_stop();
 
 /* NB: sample_rate should be desired rate. Don't pre-scale. */
-void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate = OversampleRate::None);
+void set_sample_rate(
+    uint32_t sample_rate,
+    OversampleRate oversample_rate = OversampleRate::None,
+    DecimationFilter filter = DecimationFilter::Standard);
 void capture_start(CaptureConfig* const config);
 void capture_stop();
 void replay_start(ReplayConfig* const config);
 void replay_stop();
+void set_replay_gate(const uint64_t on_samples, const uint64_t off_samples);
+void set_replay_rate(const uint32_t input_rate, const uint32_t output_rate);
+void set_replay_mixer(const int32_t frequency_offset, const int8_t gain_db, const bool soft_clip);
 
 } /* namespace baseband */
 
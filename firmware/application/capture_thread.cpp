@@ -23,6 +23,10 @@
 
 #include "baseband_api.hpp"
 #include "buffer_exchange.hpp"
+#include "replay_pool.hpp"
+#include "sd_card.hpp"
+
+#include <algorithm>
 
 struct BasebandCapture {
     BasebandCapture(CaptureConfig* const config) {
@@ -40,10 +44,13 @@ CaptureThread::CaptureThread(
     std::unique_ptr<stream::Writer> writer,
     size_t write_size,
     size_t buffer_count,
+    uint64_t byte_limit,
     std::function<void()> success_callback,
-    std::function<void(File::Error)> error_callback)
-    : config{write_size, buffer_count},
+    std::function<void(File::Error)> error_callback,
+    const CaptureTriggerConfig& trigger)
+    : config{cluster_transfer_size(write_size, sd_card::fs.csize * _MAX_SS), buffer_count, trigger},
       writer{std::move(writer)},
+      byte_limit{byte_limit},
       success_callback{std::move(success_callback)},
       error_callback{std::move(error_callback)} {
     // Need significant stack for FATFS
@@ -51,6 +58,10 @@ CaptureThread::CaptureThread(
 }
 
 CaptureThread::~CaptureThread() {
+    stop();
+}
+
+void CaptureThread::stop() {
     if (thread) {
         chThdTerminate(thread);
         chThdWait(thread);
@@ -77,13 +88,21 @@ Optional<File::Error> CaptureThread::run() {
 
     while (!chThdShouldTerminate()) {
         auto buffer = buffers.get();
-        auto write_result = writer->write(buffer->data(), buffer->size());
+        auto size = buffer->size();
+        if (byte_limit)
+            size = std::min<uint64_t>(size, byte_limit - bytes_written);
+
+        auto write_result = writer->write(buffer->data(), size);
         if (write_result.is_error()) {
             return write_result.error();
         }
+        bytes_written += size;
         buffer->empty();
         buffers.put(buffer);
+
+        if (byte_limit && bytes_written >= byte_limit)
+            break;
     }
 
-    return {};
+    return writer->flush();
 }
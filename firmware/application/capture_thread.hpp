@@ -35,12 +35,18 @@
 
 class CaptureThread {
    public:
+    /* A non-zero byte_limit ends the capture successfully once that many
+     * baseband bytes have been handed to the writer. With a trigger the
+     * baseband holds the data back until it fires, the limit counts from
+     * the first byte written. */
     CaptureThread(
         std::unique_ptr<stream::Writer> writer,
         size_t write_size,
         size_t buffer_count,
+        uint64_t byte_limit,
         std::function<void()> success_callback,
-        std::function<void(File::Error)> error_callback);
+        std::function<void(File::Error)> error_callback,
+        const CaptureTriggerConfig& trigger = {});
     ~CaptureThread();
 
     CaptureThread(const CaptureThread&) = delete;
@@ -52,9 +58,19 @@ class CaptureThread {
         return config;
     }
 
+    /* Ends the capture and waits for the writer to be flushed. */
+    void stop();
+
+    /* Baseband bytes handed to the writer, final once stopped. */
+    uint64_t bytes_captured() const {
+        return bytes_written;
+    }
+
    private:
     CaptureConfig config;
     std::unique_ptr<stream::Writer> writer;
+    uint64_t byte_limit;
+    uint64_t bytes_written{0};
     std::function<void()> success_callback;
     std::function<void(File::Error)> error_callback;
     Thread* thread{nullptr};
@@ -31,6 +31,7 @@
 namespace fs = std::filesystem;
 static const fs::path c8_ext{u".C8"};
 static const fs::path c16_ext{u".C16"};
+static const fs::path ciq_ext{u".CIQ"};
 
 Optional<File::Error> File::open_fatfs(const std::filesystem::path& filename, BYTE mode) {
     auto result = f_open(&f, reinterpret_cast<const TCHAR*>(filename.c_str()), mode);
@@ -67,11 +68,14 @@ Optional<File::Error> File::create(const std::filesystem::path& filename) {
 }
 
 File::~File() {
+    finish_preallocation();
     f_close(&f);
 }
 
 void File::close() {
+    finish_preallocation();
     f_close(&f);
+    disable_fast_seek();
 }
 
 File::Result<File::Size> File::read(void* data, Size bytes_to_read) {
@@ -85,6 +89,10 @@ File::Result<File::Size> File::read(void* data, Size bytes_to_read) {
 }
 
 File::Result<File::Size> File::write(const void* data, Size bytes_to_write) {
+    // The link map can't grow the file, FatFs needs the FAT for that.
+    if (f.cltbl && f_tell(&f) + bytes_to_write > f_size(&f))
+        disable_fast_seek();
+
     UINT bytes_written = 0;
     const auto result = f_write(&f, data, bytes_to_write, &bytes_written);
     if (result == FR_OK) {
@@ -155,6 +163,51 @@ Optional<File::Error> File::sync() {
     }
 }
 
+Optional<File::Error> File::enable_fast_seek() {
+    size_t length = link_map_initial;
+
+    while (true) {
+        link_map = std::make_unique<DWORD[]>(length);
+        link_map[0] = length;
+        f.cltbl = link_map.get();
+
+        const auto result = f_lseek(&f, CREATE_LINKMAP);
+        if (result == FR_OK)
+            return {};
+
+        // On FR_NOT_ENOUGH_CORE the first entry holds the length needed.
+        const size_t required = link_map[0];
+        disable_fast_seek();
+        if (result != FR_NOT_ENOUGH_CORE || required > link_map_max)
+            return {result};
+        length = required;
+    }
+}
+
+void File::disable_fast_seek() {
+    f.cltbl = nullptr;
+    link_map.reset();
+}
+
+Optional<File::Error> File::preallocate(const Size size) {
+    const auto result = f_expand(&f, size, 1);
+    if (result != FR_OK)
+        return {result};
+
+    preallocated = true;
+    return enable_fast_seek();
+}
+
+void File::finish_preallocation() {
+    if (!preallocated)
+        return;
+
+    preallocated = false;
+    disable_fast_seek();
+    if (f_tell(&f) < f_size(&f))
+        f_truncate(&f);
+}
+
 File::Result<std::string> File::read_file(const std::filesystem::path& filename) {
     constexpr size_t buffer_size = 0x80;
     char* buffer[buffer_size];
@@ -538,7 +591,11 @@ bool path_iequal(
 
 bool is_cxx_capture_file(const path& filename) {
     auto ext = filename.extension();
-    return path_iequal(c8_ext, ext) || path_iequal(c16_ext, ext);
+    return path_iequal(c8_ext, ext) || path_iequal(c16_ext, ext) || path_iequal(ciq_ext, ext);
+}
+
+bool is_packed_capture_file(const path& filename) {
+    return path_iequal(ciq_ext, filename.extension());
 }
 
 uint8_t capture_file_sample_size(const path& filename) {
@@ -171,6 +171,8 @@ path operator/(const path& lhs, const path& rhs);
 /* Case insensitive path equality on underlying "native" string. */
 bool path_iequal(const path& lhs, const path& rhs);
 bool is_cxx_capture_file(const path& filename);
+/* Packed (.CIQ) captures decode to C16 and have no fixed sample size on disk. */
+bool is_packed_capture_file(const path& filename);
 uint8_t capture_file_sample_size(const path& filename);
 
 using file_status = BYTE;
@@ -320,9 +322,13 @@ class File {
 
     File(File&& other) {
         std::swap(f, other.f);
+        std::swap(link_map, other.link_map);
+        std::swap(preallocated, other.preallocated);
     }
     File& operator=(File&& other) {
         std::swap(f, other.f);
+        std::swap(link_map, other.link_map);
+        std::swap(preallocated, other.preallocated);
         return *this;
     }
 
@@ -355,12 +361,31 @@ class File {
     // TODO: Return Result<>.
     Optional<Error> sync();
 
+    /* Builds a FatFs cluster link map so that reads, writes and seeks
+     * inside the current file size never walk the FAT. */
+    Optional<Error> enable_fast_seek();
+
+    /* Allocates one contiguous block for an empty file opened for writing
+     * and enables fast seek on it. On close the file is truncated at the
+     * current position. Writes past the block fall back to normal FAT
+     * allocation. */
+    Optional<Error> preallocate(const Size size);
+
     /* Reads the entire file contents to a string.
      * NB: This will likely fail for files larger than ~10kB. */
     static Result<std::string> read_file(const std::filesystem::path& filename);
 
    private:
+    /* Cluster link maps are two entries per fragment plus a header. */
+    static constexpr size_t link_map_initial = 16;
+    static constexpr size_t link_map_max = 512;
+
     FIL f{};
+    std::unique_ptr<DWORD[]> link_map{};
+    bool preallocated{false};
+
+    void disable_fast_seek();
+    void finish_preallocation();
 
     Optional<Error> open_fatfs(const std::filesystem::path& filename, BYTE mode);
 };
@@ -29,12 +29,32 @@ namespace stream {
 class Reader {
    public:
     virtual File::Result<File::Size> read(void* const buffer, const File::Size bytes) = 0;
+
+    /* Moves the read position, returns the previous position.
+     * Readers that can't seek keep this default. */
+    virtual File::Result<File::Offset> seek(const File::Offset) {
+        return {static_cast<File::Error>(FR_BAD_SEEK)};
+    }
+
+    /* Lets file backed readers stream without walking the FAT.
+     * Failure only costs speed, callers may ignore it. */
+    virtual Optional<File::Error> enable_fast_seek() {
+        return {};
+    }
+
     virtual ~Reader() = default;
 };
 
 class Writer {
    public:
     virtual File::Result<File::Size> write(const void* const buffer, const File::Size bytes) = 0;
+
+    /* Writes out anything held back between write() calls.
+     * Called once when the stream ends; unbuffered writers keep this default. */
+    virtual Optional<File::Error> flush() {
+        return {};
+    }
+
     virtual ~Writer() = default;
 };
 
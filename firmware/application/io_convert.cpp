@@ -22,24 +22,86 @@
 #include "io_convert.hpp"
 #include "complex.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
 namespace fs = std::filesystem;
 static const fs::path c8_ext = u".C8";
+static const fs::path ciq_ext = u".CIQ";
 
 namespace file_convert {
 
+namespace {
+
+/* The M0 has no SIMD and faults on unaligned word access, so the
+ * converters work on aligned 32-bit words, four samples per iteration,
+ * with the odd samples done one at a time. */
+constexpr size_t samples_per_iteration = 4;
+
+bool word_aligned(const void* p) {
+    return (reinterpret_cast<uintptr_t>(p) & 3) == 0;
+}
+
+// Shift isn't used here because it would amplify noise at center freq since it's a signed number
+// i.e. ((-1 >> 8) << 8) = -256, whereas (-1 / 256) * 256 = 0
+complex8_t narrow(const complex16_t v) {
+    return {(int8_t)(v.real() / 256), (int8_t)(v.imag() / 256)};
+}
+
+complex16_t widen(const complex8_t v) {
+    // Can't shift signed numbers left, so using multiply
+    return {(int16_t)(v.real() * 256), (int16_t)(v.imag() * 256)};
+}
+
+/* Top byte of a 16-bit lane, rounded toward zero like narrow(): negative
+ * values get 255 added first. */
+uint32_t narrow_lane(const uint32_t lane) {
+    const uint32_t bias = (0U - (lane >> 15)) & 0xFF;
+    return ((lane + bias) >> 8) & 0xFF;
+}
+
+/* One C16 sample word to a C8 sample in the low half. */
+uint32_t narrow_word(const uint32_t w) {
+    return narrow_lane(w & 0xFFFF) | (narrow_lane(w >> 16) << 8);
+}
+
+/* Byte moves only: v * 256 is the byte shifted into the top of the lane. */
+uint32_t widen_low(const uint32_t w) {
+    return ((w & 0x000000FF) << 8) | ((w & 0x0000FF00) << 16);
+}
+
+uint32_t widen_high(const uint32_t w) {
+    return ((w & 0x00FF0000) >> 8) | (w & 0xFF000000);
+}
+
+}  // namespace
+
 // Convert buffer contents from c16 to c8.
 // Same buffer used for input & output; input size is bytes; output size is bytes/2.
 void c16_to_c8(const void* buffer, File::Size bytes) {
     complex16_t* src = (complex16_t*)buffer;
     complex8_t* dest = (complex8_t*)buffer;
+    const size_t count = bytes / sizeof(complex16_t);
+    size_t i = 0;
+
+    if (word_aligned(buffer)) {
+        const uint32_t* in = (const uint32_t*)buffer;
+        uint32_t* out = (uint32_t*)buffer;
 
-    // Shift isn't used here because it would amplify noise at center freq since it's a signed number
-    // i.e. ((-1 >> 8) << 8) = -256, whereas (-1 / 256) * 256 = 0
-    for (File::Size i = 0; i < bytes / sizeof(complex16_t); i++) {
-        auto re_out = src[i].real() / 256;
-        auto im_out = src[i].imag() / 256;
-        dest[i] = {(int8_t)re_out, (int8_t)im_out};
+        // Output words trail the input, so the buffer can be shared.
+        for (; i + samples_per_iteration <= count; i += samples_per_iteration) {
+            const uint32_t w0 = in[i + 0];
+            const uint32_t w1 = in[i + 1];
+            const uint32_t w2 = in[i + 2];
+            const uint32_t w3 = in[i + 3];
+            out[i / 2 + 0] = narrow_word(w0) | (narrow_word(w1) << 16);
+            out[i / 2 + 1] = narrow_word(w2) | (narrow_word(w3) << 16);
+        }
     }
+
+    for (; i < count; i++)
+        dest[i] = narrow(src[i]);
 }
 
 // Convert c8 buffer to c16 buffer.
@@ -47,15 +109,32 @@ void c16_to_c8(const void* buffer, File::Size bytes) {
 void c8_to_c16(const void* buffer, File::Size bytes) {
     complex8_t* src = (complex8_t*)buffer;
     complex16_t* dest = (complex16_t*)buffer;
-    uint32_t i = bytes / sizeof(complex8_t);
+    size_t i = bytes / sizeof(complex8_t);
+
+    // Back to front, the output overwrites input that was already read.
+    if (word_aligned(buffer)) {
+        const uint32_t* in = (const uint32_t*)buffer;
+        uint32_t* out = (uint32_t*)buffer;
 
-    if (i != 0) {
-        do {
+        while (i % samples_per_iteration) {
             i--;
-            auto re_out = (int16_t)src[i].real() * 256;  // C8 to C16 conversion;
-            auto im_out = (int16_t)src[i].imag() * 256;  // Can't shift signed numbers left, so using multiply
-            dest[i] = {(int16_t)re_out, (int16_t)im_out};
-        } while (i != 0);
+            dest[i] = widen(src[i]);
+        }
+
+        while (i != 0) {
+            i -= samples_per_iteration;
+            const uint32_t w0 = in[i / 2 + 0];
+            const uint32_t w1 = in[i / 2 + 1];
+            out[i + 3] = widen_high(w1);
+            out[i + 2] = widen_low(w1);
+            out[i + 1] = widen_high(w0);
+            out[i + 0] = widen_low(w0);
+        }
+    }
+
+    while (i != 0) {
+        i--;
+        dest[i] = widen(src[i]);
     }
 }
 
@@ -64,11 +143,40 @@ void c8_to_c16(const void* buffer, File::Size bytes) {
 // Automatically enables C8/C16 conversion based on file extension
 Optional<File::Error> FileConvertReader::open(const std::filesystem::path& filename) {
     convert_c8_to_c16 = path_iequal(filename.extension(), c8_ext);
+
+    if (path_iequal(filename.extension(), ciq_ext)) {
+        packed_ = std::make_unique<PackedFileReader>();
+        return packed_->open(filename);
+    }
+
+    packed_.reset();
     return file_.open(filename);
 }
 
+File::Result<File::Offset> FileConvertReader::seek(const File::Offset offset) {
+    if (packed_)
+        return packed_->seek(offset);
+
+    // C8 files hold half the bytes of the C16 stream they are read as.
+    auto seek_result = file_.seek(convert_c8_to_c16 ? offset / 2 : offset);
+    if (seek_result.is_ok() && convert_c8_to_c16)
+        return {static_cast<File::Offset>(seek_result.value() * 2)};
+    return seek_result;
+}
+
+Optional<File::Error> FileConvertReader::enable_fast_seek() {
+    return packed_ ? packed_->enable_fast_seek() : file_.enable_fast_seek();
+}
+
 // If C8 conversion enabled, half the number of bytes are read from the file & expanded to fill the whole buffer.
 File::Result<File::Size> FileConvertReader::read(void* const buffer, const File::Size bytes) {
+    if (packed_) {
+        auto read_result = packed_->read(buffer, bytes);
+        if (read_result.is_ok())
+            bytes_read_ += read_result.value();
+        return read_result;
+    }
+
     auto read_result = file_.read(buffer, convert_c8_to_c16 ? bytes / 2 : bytes);
     if (read_result.is_ok()) {
         if (convert_c8_to_c16) {
@@ -100,3 +208,192 @@ File::Result<File::Size> FileConvertWriter::write(const void* const buffer, cons
     }
     return write_result;
 }
+
+// PackedFileReader ///////////////////////////////////////////////////////
+
+File::Result<File::Size> PackedFileReader::read(void* const buffer, const File::Size bytes) {
+    auto p = static_cast<uint8_t*>(buffer);
+    File::Size done = 0;
+
+    while (done < bytes) {
+        if (block_begin_ == block_end_) {
+            auto result = next_block();
+            if (result.is_error())
+                return result.error();
+            if (!result.value())
+                break;
+        }
+
+        const auto n = std::min<File::Size>(bytes - done, block_end_ - block_begin_);
+        memcpy(p + done, reinterpret_cast<const uint8_t*>(block_.data()) + block_begin_, n);
+        block_begin_ += n;
+        done += n;
+    }
+
+    bytes_read_ += done;
+    return {static_cast<File::Size>(done)};
+}
+
+File::Result<File::Offset> PackedFileReader::seek(const File::Offset offset) {
+    const auto previous = bytes_read_;
+    auto position = bytes_read_ - block_begin_;  // Start of the decoded block.
+
+    if (offset < position) {
+        auto seek_result = file_.seek(0);
+        if (seek_result.is_error())
+            return seek_result.error();
+        packed_begin_ = packed_end_ = 0;
+        position = 0;
+    } else if (offset < position + block_end_) {
+        block_begin_ = offset - position;
+        bytes_read_ = offset;
+        return {static_cast<File::Offset>(previous)};
+    } else {
+        position += block_end_;
+    }
+    block_begin_ = block_end_ = 0;
+
+    // Skip whole blocks by their headers, decode the one holding the offset.
+    while (true) {
+        auto available = fill(iq_codec::header_size);
+        if (available.is_error())
+            return available.error();
+        if (available.value() < iq_codec::header_size)
+            break;
+
+        const auto header = &packed_[packed_begin_];
+        const auto size = iq_codec::block_size(header);
+        if (size == 0)
+            return {static_cast<File::Error>(FR_INT_ERR)};
+
+        const auto bytes = iq_codec::block_sample_count(header) * sizeof(complex16_t);
+        if (offset < position + bytes) {
+            auto result = next_block();
+            if (result.is_error())
+                return result.error();
+            if (result.value())
+                block_begin_ = offset - position;
+            break;
+        }
+
+        available = fill(size);
+        if (available.is_error())
+            return available.error();
+        if (available.value() < size)
+            break;
+
+        packed_begin_ += size;
+        position += bytes;
+    }
+
+    // Past the end lands on the end, like File::seek on a read-only file.
+    bytes_read_ = position + block_begin_;
+    return {static_cast<File::Offset>(previous)};
+}
+
+File::Result<bool> PackedFileReader::next_block() {
+    auto available = fill(iq_codec::header_size);
+    if (available.is_error())
+        return available.error();
+    if (available.value() < iq_codec::header_size)
+        return false;
+
+    const auto size = iq_codec::block_size(&packed_[packed_begin_]);
+    if (size == 0)
+        return {static_cast<File::Error>(FR_INT_ERR)};
+
+    available = fill(size);
+    if (available.is_error())
+        return available.error();
+    if (available.value() < size)
+        return false;  // Truncated at the end, drop the partial block.
+
+    const auto count = iq_codec::decode_block(&packed_[packed_begin_], block_.data());
+    packed_begin_ += size;
+    block_begin_ = 0;
+    block_end_ = count * sizeof(complex16_t);
+    return true;
+}
+
+// Makes at least 'bytes' packed bytes available unless the file ends, returns how many are.
+File::Result<size_t> PackedFileReader::fill(const size_t bytes) {
+    if (packed_end_ - packed_begin_ >= bytes)
+        return {packed_end_ - packed_begin_};
+
+    memmove(packed_.data(), &packed_[packed_begin_], packed_end_ - packed_begin_);
+    packed_end_ -= packed_begin_;
+    packed_begin_ = 0;
+
+    auto read_result = file_.read(&packed_[packed_end_], packed_.size() - packed_end_);
+    if (read_result.is_error())
+        return read_result.error();
+
+    packed_end_ += read_result.value();
+    return {static_cast<size_t>(packed_end_)};
+}
+
+// PackedFileWriter ///////////////////////////////////////////////////////
+
+File::Result<File::Size> PackedFileWriter::write(const void* const buffer, const File::Size bytes) {
+    auto p = static_cast<const uint8_t*>(buffer);
+    auto remaining = bytes;
+
+    // Whole blocks straight from the caller's buffer, the rest through block_.
+    while (remaining) {
+        if (block_fill_ == 0 && remaining >= iq_codec::block_bytes &&
+            (reinterpret_cast<uintptr_t>(p) & 1) == 0) {
+            auto error = pack(reinterpret_cast<const complex16_t*>(p), iq_codec::block_samples);
+            if (error)
+                return error.value();
+            p += iq_codec::block_bytes;
+            remaining -= iq_codec::block_bytes;
+            continue;
+        }
+
+        const auto n = std::min<File::Size>(remaining, iq_codec::block_bytes - block_fill_);
+        memcpy(reinterpret_cast<uint8_t*>(block_.data()) + block_fill_, p, n);
+        block_fill_ += n;
+        p += n;
+        remaining -= n;
+
+        if (block_fill_ == iq_codec::block_bytes) {
+            block_fill_ = 0;
+            auto error = pack(block_.data(), iq_codec::block_samples);
+            if (error)
+                return error.value();
+        }
+    }
+
+    bytes_written_ += bytes;
+    return {static_cast<File::Size>(bytes)};
+}
+
+Optional<File::Error> PackedFileWriter::flush() {
+    const auto count = block_fill_ / sizeof(complex16_t);
+    block_fill_ = 0;
+    if (count) {
+        packed_fill_ += iq_codec::encode_block(block_.data(), count, &packed_[packed_fill_]);
+    }
+
+    if (packed_fill_) {
+        auto write_result = file_.write(packed_.data(), packed_fill_);
+        packed_fill_ = 0;
+        if (write_result.is_error())
+            return write_result.error();
+    }
+    return {};
+}
+
+Optional<File::Error> PackedFileWriter::pack(const complex16_t* const samples, const size_t count) {
+    packed_fill_ += iq_codec::encode_block(samples, count, &packed_[packed_fill_]);
+    if (packed_fill_ < write_size)
+        return {};
+
+    auto write_result = file_.write(packed_.data(), write_size);
+    if (write_result.is_error())
+        return write_result.error();
+
+    packed_fill_ -= write_size;
+    memmove(packed_.data(), &packed_[write_size], packed_fill_);
+    return {};
+}
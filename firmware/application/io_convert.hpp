@@ -25,10 +25,13 @@
 #include "io_file.hpp"
 
 #include "io.hpp"
+#include "iq_codec.hpp"
 #include "file.hpp"
 #include "optional.hpp"
 
+#include <array>
 #include <cstdint>
+#include <memory>
 
 namespace file_convert {
 
@@ -37,6 +40,89 @@ void c16_to_c8(const void* buffer, File::Size bytes);
 
 } /* namespace file_convert */
 
+/* Reads a packed .CIQ capture as a plain C16 stream. */
+class PackedFileReader : public stream::Reader {
+   public:
+    PackedFileReader() = default;
+
+    PackedFileReader(const PackedFileReader&) = delete;
+    PackedFileReader& operator=(const PackedFileReader&) = delete;
+    PackedFileReader(PackedFileReader&& file) = delete;
+    PackedFileReader& operator=(PackedFileReader&&) = delete;
+
+    Optional<File::Error> open(const std::filesystem::path& filename) {
+        return file_.open(filename);
+    }
+
+    File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+    /* Offsets are in the decoded C16 stream. Blocks vary in size, so the
+     * reader walks their headers: forward from the current block, or from
+     * the start of the file when seeking back. */
+    File::Result<File::Offset> seek(const File::Offset offset) override;
+    Optional<File::Error> enable_fast_seek() override { return file_.enable_fast_seek(); }
+    const File& file() const& { return file_; }
+
+   private:
+    static constexpr size_t read_size = 4096;
+
+    File file_{};
+    uint64_t bytes_read_{0};
+
+    std::array<uint8_t, read_size + iq_codec::max_block_size> packed_{};
+    size_t packed_begin_{0};
+    size_t packed_end_{0};
+
+    std::array<complex16_t, iq_codec::block_samples> block_{};
+    size_t block_begin_{0};
+    size_t block_end_{0};
+
+    /* Ok(false) at the end of the file. */
+    File::Result<bool> next_block();
+    File::Result<size_t> fill(const size_t bytes);
+};
+
+/* Packs a C16 stream into a .CIQ capture. Blocks are staged and written
+ * in read_size chunks; flush() writes the final partial block. */
+class PackedFileWriter : public stream::Writer {
+   public:
+    PackedFileWriter() = default;
+
+    PackedFileWriter(const PackedFileWriter&) = delete;
+    PackedFileWriter& operator=(const PackedFileWriter&) = delete;
+    PackedFileWriter(PackedFileWriter&& file) = delete;
+    PackedFileWriter& operator=(PackedFileWriter&&) = delete;
+
+    Optional<File::Error> create(const std::filesystem::path& filename) {
+        return file_.create(filename);
+    }
+
+    /* Size of the C16 stream to be written, reserves the worst case packed size. */
+    Optional<File::Error> preallocate(const File::Size size) {
+        return file_.preallocate(iq_codec::max_packed_size(size));
+    }
+
+    File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
+    Optional<File::Error> flush() override;
+    const File& file() const& { return file_; }
+
+    /* C16 bytes taken in, the decoded length of the file. */
+    uint64_t bytes_written() const { return bytes_written_; }
+
+   private:
+    static constexpr size_t write_size = 4096;
+
+    File file_{};
+    uint64_t bytes_written_{0};
+
+    std::array<complex16_t, iq_codec::block_samples> block_{};
+    size_t block_fill_{0};  // Bytes.
+
+    std::array<uint8_t, write_size + iq_codec::max_block_size> packed_{};
+    size_t packed_fill_{0};
+
+    Optional<File::Error> pack(const complex16_t* const samples, const size_t count);
+};
+
 class FileConvertReader : public stream::Reader {
    public:
     FileConvertReader() = default;
@@ -49,13 +135,17 @@ class FileConvertReader : public stream::Reader {
     Optional<File::Error> open(const std::filesystem::path& filename);
 
     File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
-    const File& file() const& { return file_; }
+    /* Offsets are in the C16 stream. */
+    File::Result<File::Offset> seek(const File::Offset offset) override;
+    Optional<File::Error> enable_fast_seek() override;
+    const File& file() const& { return packed_ ? packed_->file() : file_; }
 
     bool convert_c8_to_c16{};
 
    protected:
     File file_{};
     uint64_t bytes_read_{0};
+    std::unique_ptr<PackedFileReader> packed_{};  // Set for .CIQ captures.
 };
 
 class FileConvertWriter : public stream::Writer {
@@ -68,6 +158,8 @@ class FileConvertWriter : public stream::Writer {
     FileConvertWriter& operator=(FileConvertWriter&&) = delete;
 
     Optional<File::Error> create(const std::filesystem::path& filename);
+    /* Size of the file as written, after any C16 to C8 conversion. */
+    Optional<File::Error> preallocate(const File::Size size) { return file_.preallocate(size); }
 
     File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
     const File& file() const& { return file_; }
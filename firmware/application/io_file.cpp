@@ -29,6 +29,10 @@ File::Result<File::Size> FileReader::read(void* const buffer, const File::Size b
     return read_result;
 }
 
+File::Result<File::Offset> FileReader::seek(const File::Offset offset) {
+    return file_.seek(offset);
+}
+
 File::Result<File::Size> FileWriter::write(const void* const buffer, const File::Size bytes) {
     auto write_result = file_.write(buffer, bytes);
     if (write_result.is_ok()) {
@@ -43,6 +43,8 @@ class FileReader : public stream::Reader {
     }
 
     File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+    File::Result<File::Offset> seek(const File::Offset offset) override;
+    Optional<File::Error> enable_fast_seek() override { return file_.enable_fast_seek(); }
     const File& file() const& { return file_; }
 
    protected:
@@ -63,6 +65,8 @@ class FileWriter : public stream::Writer {
         return file_.create(filename);
     }
 
+    Optional<File::Error> preallocate(const File::Size size) { return file_.preallocate(size); }
+
     File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
     const File& file() const& { return file_; }
 
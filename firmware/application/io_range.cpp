@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "io_range.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+RangeReader::RangeReader(
+    std::unique_ptr<stream::Reader> reader,
+    const File::Offset start,
+    const File::Offset end)
+    : reader_{std::move(reader)},
+      start_{start},
+      end_{end},
+      position_{start},
+      positioned_{start == 0} {
+}
+
+File::Result<File::Size> RangeReader::read(void* const buffer, const File::Size bytes) {
+    if (!positioned_) {
+        auto seek_result = reader_->seek(start_);
+        if (seek_result.is_error())
+            return seek_result.error();
+        positioned_ = true;
+    }
+
+    auto limit = bytes;
+    if (end_ > 0)
+        limit = (position_ < end_) ? std::min<File::Size>(bytes, end_ - position_) : 0;
+
+    if (limit == 0)
+        return {static_cast<File::Size>(0)};
+
+    auto read_result = reader_->read(buffer, limit);
+    if (read_result.is_ok())
+        position_ += read_result.value();
+    return read_result;
+}
+
+File::Result<File::Offset> RangeReader::seek(const File::Offset offset) {
+    auto seek_result = reader_->seek(start_ + offset);
+    if (seek_result.is_error())
+        return seek_result;
+
+    const auto previous = position_ - start_;
+    position_ = start_ + offset;
+    positioned_ = true;
+    return {static_cast<File::Offset>(previous)};
+}
+
+SegmentReader::SegmentReader(
+    std::unique_ptr<stream::Reader> reader,
+    std::vector<Segment> segments,
+    const File::Size gap_bytes)
+    : reader_{std::move(reader)},
+      segments_{std::move(segments)},
+      gap_bytes_{gap_bytes} {
+}
+
+File::Result<File::Size> SegmentReader::read(void* const buffer, const File::Size bytes) {
+    auto p = static_cast<uint8_t*>(buffer);
+    File::Size done = 0;
+
+    while (done < bytes && index_ < segments_.size()) {
+        const auto& segment = segments_[index_];
+
+        if (in_gap_) {
+            const auto n = std::min<File::Size>(bytes - done, gap_bytes_ - offset_);
+            memset(p + done, 0, n);
+            offset_ += n;
+            done += n;
+            if (offset_ >= gap_bytes_)
+                next_item();
+            continue;
+        }
+
+        if (!positioned_) {
+            auto seek_result = reader_->seek(segment.start + offset_);
+            if (seek_result.is_error())
+                return seek_result.error();
+            positioned_ = true;
+        }
+
+        const auto n = std::min<File::Size>(bytes - done, segment.size - offset_);
+        auto read_result = reader_->read(p + done, n);
+        if (read_result.is_error())
+            return read_result.error();
+
+        offset_ += read_result.value();
+        done += read_result.value();
+
+        // A range running past the end of the file is cut short.
+        if (offset_ >= segment.size || read_result.value() == 0)
+            next_item();
+    }
+
+    position_ += done;
+    return {static_cast<File::Size>(done)};
+}
+
+File::Result<File::Offset> SegmentReader::seek(const File::Offset offset) {
+    const auto previous = position_;
+
+    index_ = 0;
+    offset_ = 0;
+    in_gap_ = false;
+    positioned_ = false;
+
+    // Walk to the segment or gap holding the offset.
+    auto remaining = offset;
+    while (index_ < segments_.size()) {
+        const auto size = in_gap_ ? gap_bytes_ : segments_[index_].size;
+        if (remaining < size) {
+            offset_ = remaining;
+            break;
+        }
+        remaining -= size;
+        next_item();
+    }
+
+    position_ = offset - remaining + offset_;
+    return {static_cast<File::Offset>(previous)};
+}
+
+File::Size SegmentReader::size() const {
+    File::Size total = 0;
+    for (const auto& segment : segments_)
+        total += segment.size + gap_bytes_;
+    return total;
+}
+
+void SegmentReader::next_item() {
+    if (in_gap_ || gap_bytes_ == 0)
+        index_++;
+    in_gap_ = !in_gap_ && gap_bytes_ > 0;
+    offset_ = 0;
+    positioned_ = false;
+}
+
+std::unique_ptr<stream::Reader> apply_trim(
+    std::unique_ptr<stream::Reader> reader,
+    const uint64_t start_sample,
+    const uint64_t end_sample,
+    const size_t sample_size) {
+    if (end_sample == 0 || end_sample <= start_sample)
+        return reader;
+
+    return std::make_unique<RangeReader>(
+        std::move(reader),
+        start_sample * sample_size,
+        end_sample * sample_size);
+}
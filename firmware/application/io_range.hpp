@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IO_RANGE_H__
+#define __IO_RANGE_H__
+
+#include "io.hpp"
+
+#include "file.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* Limits a seekable reader to the bytes [start, end) of its stream, which
+ * is how a virtually trimmed capture is replayed without rewriting it.
+ * An end of 0 reads to the end of the stream. Seeks are relative to
+ * start, so looping back to 0 goes to the start of the range. The first
+ * seek is deferred to the first read, on the thread doing the reads. */
+class RangeReader : public stream::Reader {
+   public:
+    RangeReader(
+        std::unique_ptr<stream::Reader> reader,
+        const File::Offset start,
+        const File::Offset end);
+
+    RangeReader(const RangeReader&) = delete;
+    RangeReader& operator=(const RangeReader&) = delete;
+    RangeReader(RangeReader&&) = delete;
+    RangeReader& operator=(RangeReader&&) = delete;
+
+    File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+    File::Result<File::Offset> seek(const File::Offset offset) override;
+    Optional<File::Error> enable_fast_seek() override { return reader_->enable_fast_seek(); }
+
+   private:
+    std::unique_ptr<stream::Reader> reader_;
+    const File::Offset start_;
+    const File::Offset end_;
+    File::Offset position_;
+    bool positioned_;
+};
+
+/* Plays a list of byte ranges of a seekable reader back to back, with
+ * gap_bytes of zeros after each one, so bursts picked out of a long
+ * capture replay in place. Seeks are in the combined stream; the
+ * reader is only seeked when a range starts. */
+class SegmentReader : public stream::Reader {
+   public:
+    struct Segment {
+        File::Offset start;
+        File::Size size;
+    };
+
+    SegmentReader(
+        std::unique_ptr<stream::Reader> reader,
+        std::vector<Segment> segments,
+        const File::Size gap_bytes);
+
+    SegmentReader(const SegmentReader&) = delete;
+    SegmentReader& operator=(const SegmentReader&) = delete;
+    SegmentReader(SegmentReader&&) = delete;
+    SegmentReader& operator=(SegmentReader&&) = delete;
+
+    File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+    File::Result<File::Offset> seek(const File::Offset offset) override;
+    Optional<File::Error> enable_fast_seek() override { return reader_->enable_fast_seek(); }
+
+    /* Length of the combined stream, gaps included. */
+    File::Size size() const;
+
+   private:
+    std::unique_ptr<stream::Reader> reader_;
+    const std::vector<Segment> segments_;
+    const File::Size gap_bytes_;
+    size_t index_{0};
+    File::Size offset_{0};  // Into the current segment, or its gap.
+    File::Offset position_{0};
+    bool in_gap_{false};
+    bool positioned_{false};
+
+    void next_item();
+};
+
+/* Applies a capture's virtual trim, given in samples of sample_size bytes
+ * in the reader's stream. Returns the reader unchanged if there is none. */
+std::unique_ptr<stream::Reader> apply_trim(
+    std::unique_ptr<stream::Reader> reader,
+    const uint64_t start_sample,
+    const uint64_t end_sample,
+    const size_t sample_size);
+
+#endif /*__IO_RANGE_H__*/
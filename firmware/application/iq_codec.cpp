@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "iq_codec.hpp"
+
+namespace iq_codec {
+
+namespace {
+
+constexpr uint8_t tag_raw = 0xA0;
+constexpr uint8_t tag_delta = 0xA1;
+
+/* Interleaves signs so small magnitudes have few significant bits. */
+uint32_t zigzag(const int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+int32_t unzigzag(const uint32_t u) {
+    return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+}
+
+size_t bit_width(uint32_t v) {
+    size_t width = 0;
+    for (; v; v >>= 1)
+        width++;
+    return width;
+}
+
+uint16_t get_u16(const uint8_t* const p) {
+    return p[0] | (p[1] << 8);
+}
+
+void put_u16(uint8_t* const p, const uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+/* LSB first bit writer; width never exceeds max_width so 32 bits suffice. */
+class BitPacker {
+   public:
+    BitPacker(uint8_t* const p, const size_t width)
+        : p{p}, width{width} {}
+
+    void put(const uint32_t v) {
+        acc |= v << bits;
+        bits += width;
+        while (bits >= 8) {
+            *(p++) = acc & 0xFF;
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+
+    uint8_t* finish() {
+        if (bits)
+            *(p++) = acc & 0xFF;
+        return p;
+    }
+
+   private:
+    uint8_t* p;
+    const size_t width;
+    uint32_t acc{0};
+    size_t bits{0};
+};
+
+class BitUnpacker {
+   public:
+    BitUnpacker(const uint8_t* const p, const size_t width)
+        : p{p}, width{width}, mask{(1U << width) - 1} {}
+
+    uint32_t get() {
+        while (bits < width) {
+            acc |= static_cast<uint32_t>(*(p++)) << bits;
+            bits += 8;
+        }
+        const auto v = acc & mask;
+        acc >>= width;
+        bits -= width;
+        return v;
+    }
+
+   private:
+    const uint8_t* p;
+    const size_t width;
+    const uint32_t mask;
+    uint32_t acc{0};
+    size_t bits{0};
+};
+
+size_t payload_size(const size_t count, const size_t width) {
+    return ((count - 1) * 2 * width + 7) / 8;
+}
+
+}  // namespace
+
+size_t encode_block(const complex16_t* const samples, const size_t count, uint8_t* const out) {
+    // Pick the narrower of plain values and deltas from a single pass.
+    uint32_t raw_bits = 0;
+    uint32_t delta_bits = 0;
+    for (size_t i = 1; i < count; i++) {
+        raw_bits |= zigzag(samples[i].real()) | zigzag(samples[i].imag());
+        delta_bits |= zigzag(samples[i].real() - samples[i - 1].real()) |
+                      zigzag(samples[i].imag() - samples[i - 1].imag());
+    }
+
+    const auto raw_width = bit_width(raw_bits);
+    const auto delta_width = bit_width(delta_bits);
+    const bool delta = delta_width < raw_width;
+    const auto width = delta ? delta_width : raw_width;
+
+    out[0] = delta ? tag_delta : tag_raw;
+    out[1] = width;
+    put_u16(&out[2], count);
+    put_u16(&out[4], samples[0].real());
+    put_u16(&out[6], samples[0].imag());
+
+    BitPacker packer{&out[header_size], width};
+    if (delta) {
+        for (size_t i = 1; i < count; i++) {
+            packer.put(zigzag(samples[i].real() - samples[i - 1].real()));
+            packer.put(zigzag(samples[i].imag() - samples[i - 1].imag()));
+        }
+    } else if (width) {
+        for (size_t i = 1; i < count; i++) {
+            packer.put(zigzag(samples[i].real()));
+            packer.put(zigzag(samples[i].imag()));
+        }
+    }
+
+    return packer.finish() - out;
+}
+
+size_t block_size(const uint8_t* const header) {
+    const auto count = get_u16(&header[2]);
+    const auto width = header[1];
+    if ((header[0] != tag_raw && header[0] != tag_delta) ||
+        width > max_width || count == 0 || count > block_samples)
+        return 0;
+
+    return header_size + payload_size(count, width);
+}
+
+size_t block_sample_count(const uint8_t* const header) {
+    return get_u16(&header[2]);
+}
+
+size_t decode_block(const uint8_t* const block, complex16_t* const samples) {
+    const bool delta = block[0] == tag_delta;
+    const size_t width = block[1];
+    const size_t count = get_u16(&block[2]);
+
+    int16_t re = get_u16(&block[4]);
+    int16_t im = get_u16(&block[6]);
+    samples[0] = {re, im};
+
+    BitUnpacker unpacker{&block[header_size], width};
+    for (size_t i = 1; i < count; i++) {
+        const auto a = unzigzag(unpacker.get());
+        const auto b = unzigzag(unpacker.get());
+        if (delta) {
+            re += a;
+            im += b;
+        } else {
+            re = a;
+            im = b;
+        }
+        samples[i] = {re, im};
+    }
+
+    return count;
+}
+
+} /* namespace iq_codec */
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IQ_CODEC_H__
+#define __IQ_CODEC_H__
+
+#include "complex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+/* Lossless block codec for C16 IQ streams (.CIQ captures).
+ *
+ * A block holds up to block_samples samples. The header carries the
+ * first sample, the rest are bit-packed I, Q, I, Q... at the narrowest
+ * width that fits either the values or the sample to sample deltas.
+ * Quiet stretches between bursts pack into a few bits per lane, full
+ * scale noise costs under 7% over raw C16.
+ *
+ * Header, little endian:
+ *   u8  tag (0xA0 | 1 for deltas)
+ *   u8  width, 0..17 bits
+ *   u16 sample count, 1..block_samples
+ *   s16 first I, s16 first Q */
+namespace iq_codec {
+
+constexpr size_t block_samples = 256;
+constexpr size_t block_bytes = block_samples * sizeof(complex16_t);
+constexpr size_t header_size = 8;
+constexpr size_t max_width = 17;
+constexpr size_t max_block_size = header_size + ((block_samples - 1) * 2 * max_width + 7) / 8;
+
+/* Worst case packed size for a C16 stream of this many bytes. */
+constexpr uint64_t max_packed_size(const uint64_t c16_bytes) {
+    return (c16_bytes + block_bytes - 1) / block_bytes * max_block_size;
+}
+
+/* Packs 1..block_samples samples into out (max_block_size bytes), returns the block size. */
+size_t encode_block(const complex16_t* const samples, const size_t count, uint8_t* const out);
+
+/* Size of the block starting with this header, 0 if it isn't a block header. */
+size_t block_size(const uint8_t* const header);
+
+/* The sample count of a block whose header block_size accepted. */
+size_t block_sample_count(const uint8_t* const header);
+
+/* Unpacks a whole block (block_size bytes), returns the sample count. */
+size_t decode_block(const uint8_t* const block, complex16_t* const samples);
+
+} /* namespace iq_codec */
+
+#endif /*__IQ_CODEC_H__*/
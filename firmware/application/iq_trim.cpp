@@ -21,6 +21,9 @@
 
 #include "iq_trim.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include "string_format.hpp"
 
@@ -28,85 +31,244 @@ namespace fs = std::filesystem;
 
 namespace iq {
 
-/* Trimming helpers based on the sample type (complex8 or complex16). */
-template <typename T>
-uint32_t power(T value) {
-    auto real = value.real();
-    auto imag = value.imag();
-    return (real * real) + (imag * imag);
+namespace {
+
+constexpr char envelope_magic[4] = {'I', 'Q', 'P', 'E'};
+constexpr uint16_t envelope_version = 2;
+
+/* Identifies the capture an envelope was made from. */
+struct EnvelopeHeader {
+    char magic[4];
+    uint16_t version;
+    uint8_t sample_size;
+    uint8_t reserved;
+    uint64_t file_size;
+    uint32_t head_hash;
+    uint32_t point_count;
+    uint32_t max_power;
+    uint32_t max_iq;
+};
+
+struct PowerAccumulator {
+    uint64_t sum = 0;
+    uint32_t max_power = 0;
+    uint32_t max_iq = 0;
+
+    void add(const int32_t re, const int32_t im) {
+        const uint32_t p = static_cast<uint32_t>(re * re) + static_cast<uint32_t>(im * im);
+        sum += p;
+        if (p > max_power)
+            max_power = p;
+
+        const uint32_t m = std::max(std::abs(re), std::abs(im));
+        if (m > max_iq)
+            max_iq = m;
+    }
+};
+
+/* FNV-1a over the head of the file, catches a different capture of the same size. */
+uint32_t hash_bytes(const uint8_t* p, size_t bytes) {
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < bytes; i++)
+        hash = (hash ^ p[i]) * 16777619U;
+    return hash;
 }
 
-template <typename T>
-uint32_t iq_max(T value) {
-    auto real = abs(value.real());
-    auto imag = abs(value.imag());
-    return (real > imag) ? real : imag;
+bool load_envelope(const fs::path& path, const EnvelopeHeader& expected, PowerEnvelope& envelope) {
+    File f;
+    if (f.open(path))
+        return false;
+
+    EnvelopeHeader header{};
+    auto result = f.read(&header, sizeof(header));
+    if (!result || *result != sizeof(header))
+        return false;
+
+    if (memcmp(header.magic, envelope_magic, sizeof(header.magic)) != 0 ||
+        header.version != expected.version ||
+        header.sample_size != expected.sample_size ||
+        header.file_size != expected.file_size ||
+        header.head_hash != expected.head_hash ||
+        header.point_count > PowerEnvelope::max_points)
+        return false;
+
+    const auto power_bytes = header.point_count * sizeof(envelope.power[0]);
+    result = f.read(envelope.power, power_bytes);
+    if (!result || *result != power_bytes)
+        return false;
+
+    envelope.point_count = header.point_count;
+    envelope.max_power = header.max_power;
+    envelope.max_iq = header.max_iq;
+    return true;
 }
 
-/* Collects capture file metadata and sample power buckets. */
-template <typename T>
-Optional<CaptureInfo> profile_capture(
-    const std::filesystem::path& path,
-    PowerBuckets& buckets,
-    uint8_t samples_per_bucket) {
+void save_envelope(const fs::path& path, EnvelopeHeader header, const PowerEnvelope& envelope) {
     File f;
-    auto error = f.open(path);
-    if (error)
-        return {};
+    if (f.create(path))
+        return;  // Only a cache, profiling still worked.
+
+    header.point_count = envelope.point_count;
+    header.max_power = envelope.max_power;
+    header.max_iq = envelope.max_iq;
+    f.write(&header, sizeof(header));
+    f.write(envelope.power, envelope.point_count * sizeof(envelope.power[0]));
+}
 
-    CaptureInfo info{
-        .file_size = f.size(),
-        .sample_count = f.size() / sizeof(T),
-        .sample_size = sizeof(T),
-        .max_power = 0,
-        .max_iq = 0};
+/* Reads the whole capture once, front to back. */
+bool scan_envelope(File& f, const uint64_t sample_count, const uint8_t sample_size, PowerEnvelope& envelope) {
+    if (f.seek(0).is_error())
+        return false;
 
-    auto profile_samples = buckets.size * samples_per_bucket;
-    auto sample_interval = info.sample_count / profile_samples;
-    uint32_t bucket_width = std::max(1ULL, info.sample_count / buckets.size);
-    uint64_t sample_index = 0;
-    T value{};
+    auto buffer = std::make_unique<uint32_t[]>(PowerEnvelope::block_size / sizeof(uint32_t));
+    auto bytes = reinterpret_cast<uint8_t*>(buffer.get());
 
-    while (true) {
-        f.seek(sample_index * info.sample_size);
-        auto result = f.read(&value, info.sample_size);
-        if (!result) return {};  // Read failed.
+    EnvelopeBuilder builder{envelope, sample_count, sample_size};
+    while (!builder.done()) {
+        const auto length = builder.next_length();
+        auto result = f.read(bytes, length);
+        if (!result || *result != length)
+            return false;
+
+        builder.add(bytes, length);
+    }
+
+    return true;
+}
+
+}  // namespace
+
+EnvelopeBuilder::EnvelopeBuilder(PowerEnvelope& envelope, const uint64_t sample_count, const uint8_t sample_size)
+    : envelope_{envelope},
+      sample_count_{sample_count},
+      sample_size_{sample_size} {
+    envelope_.point_count = std::min<uint64_t>(sample_count, PowerEnvelope::max_points);
+    envelope_.max_power = 0;
+    envelope_.max_iq = 0;
+    std::fill(std::begin(envelope_.power), std::end(envelope_.power), 0);
+}
+
+uint64_t EnvelopeBuilder::slice_end(const size_t point) const {
+    return sample_count_ * (point + 1) / envelope_.point_count;
+}
+
+size_t EnvelopeBuilder::next_length() const {
+    if (done())
+        return 0;
+
+    const auto samples = std::min<uint64_t>(slice_end(point_) - position_, PowerEnvelope::block_size / sample_size_);
+    return samples * sample_size_;
+}
+
+void EnvelopeBuilder::add(const uint8_t* data, const size_t bytes) {
+    if (done())
+        return;
 
-        if (*result != info.sample_size)
-            break;  // EOF
+    const auto block = measure_block(data, bytes, sample_size_);
+    envelope_.power[point_] = std::max(envelope_.power[point_], block.mean_power);
+    envelope_.max_power = std::max(envelope_.max_power, block.max_power);
+    envelope_.max_iq = std::max(envelope_.max_iq, block.max_iq);
 
-        auto max_iq = iq_max(value);
-        if (max_iq > info.max_iq)
-            info.max_iq = max_iq;
+    position_ += bytes / sample_size_;
+    if (position_ >= slice_end(point_))
+        point_++;
+}
+
+fs::path get_envelope_path(const fs::path& capture_path) {
+    auto temp = capture_path;
+    return temp.replace_extension(u".PWR");
+}
+
+/* Word at a time; the M0 has no SIMD but one load still brings in a
+ * whole C16 sample or two C8 samples. */
+BlockPower measure_block(const uint8_t* data, size_t bytes, uint8_t sample_size) {
+    PowerAccumulator acc{};
+    const auto words = reinterpret_cast<const uint32_t*>(data);
+    size_t samples = 0;
+
+    switch (sample_size) {
+        case sizeof(complex16_t): {
+            samples = bytes / sizeof(complex16_t);
+            for (size_t i = 0; i < samples; i++) {
+                const auto w = words[i];
+                acc.add(static_cast<int16_t>(w), static_cast<int32_t>(w) >> 16);
+            }
+            break;
+        }
 
-        auto mag_squared = power(value);
-        if (mag_squared > info.max_power)
-            info.max_power = mag_squared;
+        case sizeof(complex8_t): {
+            samples = bytes / sizeof(complex8_t);
+            size_t i = 0;
+            for (; i + 2 <= samples; i += 2) {
+                const auto w = words[i / 2];
+                acc.add(static_cast<int8_t>(w), static_cast<int8_t>(w >> 8));
+                acc.add(static_cast<int8_t>(w >> 16), static_cast<int32_t>(w) >> 24);
+            }
+            if (i < samples)
+                acc.add(static_cast<int8_t>(data[2 * i]), static_cast<int8_t>(data[2 * i + 1]));
+            break;
+        }
 
-        auto bucket_index = sample_index / bucket_width;
-        buckets.add(bucket_index, mag_squared);
-        sample_index += sample_interval;
+        default:
+            break;
     }
 
-    return info;
+    return {
+        static_cast<uint32_t>(samples ? acc.sum / samples : 0),
+        acc.max_power,
+        acc.max_iq};
 }
 
 Optional<CaptureInfo> profile_capture(
     const fs::path& path,
-    PowerBuckets& buckets,
-    uint8_t samples_per_bucket) {
-    auto sample_size = fs::capture_file_sample_size(path);
+    PowerBuckets& buckets) {
+    const auto sample_size = fs::capture_file_sample_size(path);
+    if (sample_size == 0)
+        return {};
 
-    switch (sample_size) {
-        case sizeof(complex16_t):
-            return profile_capture<complex16_t>(path, buckets, samples_per_bucket);
+    File f;
+    auto error = f.open(path);
+    if (error)
+        return {};
+
+    CaptureInfo info{
+        .file_size = f.size(),
+        .sample_count = f.size() / sample_size,
+        .sample_size = sample_size,
+        .max_power = 0,
+        .max_iq = 0};
 
-        case sizeof(complex8_t):
-            return profile_capture<complex8_t>(path, buckets, samples_per_bucket);
+    uint8_t head[512];
+    auto head_result = f.read(head, sizeof(head));
+    if (!head_result)
+        return {};
 
-        default:
+    EnvelopeHeader header{};
+    memcpy(header.magic, envelope_magic, sizeof(header.magic));
+    header.version = envelope_version;
+    header.sample_size = sample_size;
+    header.file_size = info.file_size;
+    header.head_hash = hash_bytes(head, *head_result);
+
+    // 2K of points, keep them off the stack.
+    auto envelope = std::make_unique<PowerEnvelope>();
+    const auto envelope_path = get_envelope_path(path);
+    if (!load_envelope(envelope_path, header, *envelope)) {
+        if (!scan_envelope(f, info.sample_count, sample_size, *envelope))
             return {};
-    };
+        save_envelope(envelope_path, header, *envelope);
+    }
+
+    info.max_power = envelope->max_power;
+    info.max_iq = envelope->max_iq;
+
+    uint64_t bucket_width = std::max<uint64_t>(1, info.sample_count / buckets.size);
+    for (size_t i = 0; i < envelope->point_count; i++) {
+        const auto first = info.sample_count * i / envelope->point_count;
+        buckets.add(first / bucket_width, envelope->power[i]);
+    }
+
+    return info;
 }
 
 TrimRange compute_trim_range(
@@ -144,6 +306,65 @@ TrimRange compute_trim_range(
         info.sample_size};
 }
 
+std::vector<BurstSegment> find_bursts(
+    CaptureInfo info,
+    const PowerBuckets& buckets,
+    uint8_t cutoff_percent) {
+    std::vector<BurstSegment> bursts{};
+    if (buckets.size == 0 || info.sample_count == 0)
+        return bursts;
+
+    const uint32_t power_cutoff = cutoff_percent * static_cast<uint64_t>(info.max_power) / 100;
+    const uint64_t samples_per_bucket = std::max<uint64_t>(1, info.sample_count / buckets.size);
+
+    // The last bucket also takes the samples that don't divide evenly.
+    auto bucket_sample = [&](size_t index) {
+        return (index >= buckets.size) ? info.sample_count
+                                       : std::min(index * samples_per_bucket, info.sample_count);
+    };
+
+    bool in_burst = false;
+    size_t start_bucket = 0;
+    size_t end_bucket = 0;  // Exclusive, padding included.
+    uint32_t peak = 0;
+
+    auto close_burst = [&]() {
+        const auto start = bucket_sample(start_bucket);
+        bursts.push_back({start, bucket_sample(end_bucket) - start, peak});
+        in_burst = false;
+    };
+
+    for (size_t i = 0; i < buckets.size; ++i) {
+        const auto power = buckets.p[i].power;
+
+        if (power > power_cutoff) {
+            if (!in_burst) {
+                const auto padded_start = (i > 0) ? i - 1 : 0;
+
+                // Reopen the previous burst if the padding runs into it.
+                if (!bursts.empty() && padded_start <= end_bucket) {
+                    peak = bursts.back().peak_power;
+                    bursts.pop_back();
+                } else {
+                    start_bucket = padded_start;
+                    peak = 0;
+                }
+                in_burst = true;
+            }
+
+            peak = std::max(peak, power);
+            end_bucket = std::min(i + 2, buckets.size);
+        } else if (in_burst && i + 1 >= end_bucket) {
+            close_burst();
+        }
+    }
+
+    if (in_burst)
+        close_burst();
+
+    return bursts;
+}
+
 void amplify_iq_buffer(uint8_t* buffer, uint32_t length, uint32_t amplification, uint8_t sample_size) {
     uint32_t mult_count = length / sample_size / 2;
 
@@ -240,6 +461,7 @@ bool trim_capture_with_range(
     // Delete original and overwrite with temp file.
     delete_file(path);
     rename_file(temp_path, path);
+    delete_file(get_envelope_path(path));  // Describes the untrimmed capture.
     return true;
 }
 
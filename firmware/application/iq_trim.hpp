@@ -28,6 +28,7 @@
 
 #include <functional>
 #include <limits>
+#include <vector>
 
 namespace iq {
 
@@ -62,6 +63,51 @@ struct PowerBuckets {
     }
 };
 
+/* Power statistics over a run of samples. */
+struct BlockPower {
+    uint32_t mean_power;
+    uint32_t max_power;
+    uint32_t max_iq;
+};
+
+/* Coarse power profile of a whole capture, cached next to it in a .PWR
+ * file so opening the same capture again doesn't rescan it. Each point
+ * is the loudest block mean in its slice of the file, so a burst much
+ * shorter than a slice still shows. */
+struct PowerEnvelope {
+    static constexpr size_t max_points = 512;
+    static constexpr size_t block_size = 4096;
+
+    uint32_t point_count = 0;
+    uint32_t max_power = 0;
+    uint32_t max_iq = 0;
+    uint32_t power[max_points]{};
+};
+
+/* Fills a PowerEnvelope from a whole capture read in order. Every block
+ * is measured, none is skipped. */
+class EnvelopeBuilder {
+   public:
+    EnvelopeBuilder(PowerEnvelope& envelope, uint64_t sample_count, uint8_t sample_size);
+
+    bool done() const { return point_ >= envelope_.point_count; }
+
+    /* Bytes to read next: up to a block, never across a slice. */
+    size_t next_length() const;
+
+    /* Takes the next_length() bytes, read into a word aligned buffer. */
+    void add(const uint8_t* data, size_t bytes);
+
+   private:
+    PowerEnvelope& envelope_;
+    const uint64_t sample_count_;
+    const uint8_t sample_size_;
+    size_t point_{0};
+    uint64_t position_{0};  // Samples taken so far.
+
+    uint64_t slice_end(size_t point) const;
+};
+
 /* Data needed to trim a capture by sample range.
  * end_sample is the sample *after* the last to keep. */
 struct TrimRange {
@@ -70,11 +116,25 @@ struct TrimRange {
     uint8_t sample_size;
 };
 
-/* Collects capture file metadata and samples power buckets. */
+/* A run of loud buckets in a capture, by sample range.
+ * peak_power is the loudest bucket average in the run. */
+struct BurstSegment {
+    uint64_t start_sample;
+    uint64_t sample_count;
+    uint32_t peak_power;
+};
+
+/* Where the power envelope of a capture is cached. */
+std::filesystem::path get_envelope_path(const std::filesystem::path& capture_path);
+
+/* Power of the samples in a word aligned buffer of whole samples. */
+BlockPower measure_block(const uint8_t* data, size_t bytes, uint8_t sample_size);
+
+/* Collects capture file metadata and power buckets, from the cached
+ * envelope when it still matches the capture. */
 Optional<CaptureInfo> profile_capture(
     const std::filesystem::path& path,
-    PowerBuckets& buckets,
-    uint8_t samples_per_bucket = 10);
+    PowerBuckets& buckets);
 
 /* Computes the trimming range given profiling info.
  * Cutoff percent is a number 1-100. */
@@ -83,6 +143,14 @@ TrimRange compute_trim_range(
     const PowerBuckets& buckets,
     uint8_t cutoff_percent);
 
+/* Splits a capture into bursts in one pass over its power buckets.
+ * Each burst is padded by a bucket on either side; bursts whose padding
+ * touches are merged. Cutoff percent is a number 1-100. */
+std::vector<BurstSegment> find_bursts(
+    CaptureInfo info,
+    const PowerBuckets& buckets,
+    uint8_t cutoff_percent);
+
 /* Multiplies samples in an IQ buffer by amplification value */
 void amplify_iq_buffer(
     uint8_t* buffer,
@@ -59,6 +59,8 @@
 #define LPC_SPI_SSP0_OR_SSP1_IRQ_PRIORITY 3
 
 #define LPC_SDC_SDIO_IRQ_PRIORITY 3
+/* 32KiB per multi-block command, a whole cluster on most FAT32 cards. */
+#define LPC_SDC_SDIO_DESCRIPTOR_COUNT 8
 #define LPC_RTC_IRQ_PRIORITY 3
 
 #define LPC43XX_GPT_USE_TIMER0 TRUE
@@ -34,6 +34,11 @@ const std::string_view sample_rate_name = "sample_rate"sv;
 const std::string_view latitude_name = "latitude"sv;
 const std::string_view longitude_name = "longitude"sv;
 const std::string_view satinuse_name = "satinuse"sv;
+const std::string_view codec_name = "codec"sv;
+const std::string_view sample_count_name = "sample_count"sv;
+const std::string_view delta_pack_codec = "delta_pack"sv;
+const std::string_view trim_start_name = "trim_start_sample"sv;
+const std::string_view trim_end_name = "trim_end_sample"sv;
 
 fs::path get_metadata_path(const fs::path& capture_path) {
     auto temp = capture_path;
@@ -74,6 +79,30 @@ Optional<File::Error> write_metadata_file(const fs::path& path, capture_metadata
         if (error)
             return error;
     }
+
+    // Raw captures keep the original format so older firmware reads them unchanged.
+    if (metadata.codec == capture_codec::delta_pack) {
+        error = f.write_line(std::string{codec_name} + "=" + std::string{delta_pack_codec});
+        if (error)
+            return error;
+
+        error = f.write_line(std::string{sample_count_name} + "=" +
+                             to_string_dec_uint(metadata.sample_count));
+        if (error)
+            return error;
+    }
+
+    if (metadata.trim_end > 0) {
+        error = f.write_line(std::string{trim_start_name} + "=" +
+                             to_string_dec_uint(metadata.trim_start));
+        if (error)
+            return error;
+
+        error = f.write_line(std::string{trim_end_name} + "=" +
+                             to_string_dec_uint(metadata.trim_end));
+        if (error)
+            return error;
+    }
     return {};
 }
 
@@ -103,6 +132,14 @@ Optional<capture_metadata> read_metadata_file(const fs::path& path) {
             parse_float_meta(cols[1], metadata.longitude);
         else if (cols[0] == satinuse_name)
             parse_int(cols[1], metadata.satinuse);
+        else if (cols[0] == codec_name)
+            metadata.codec = (trim(cols[1]) == delta_pack_codec) ? capture_codec::delta_pack : capture_codec::raw;
+        else if (cols[0] == sample_count_name)
+            parse_int(cols[1], metadata.sample_count);
+        else if (cols[0] == trim_start_name)
+            parse_int(cols[1], metadata.trim_start);
+        else if (cols[0] == trim_end_name)
+            parse_int(cols[1], metadata.trim_end);
         else
             continue;
     }
@@ -26,12 +26,23 @@
 #include "optional.hpp"
 #include "rf_path.hpp"
 
+/* How the samples are stored; only non-raw captures write the codec lines. */
+enum class capture_codec : uint8_t {
+    raw = 0,
+    delta_pack,  // .CIQ, see iq_codec.hpp.
+};
+
 struct capture_metadata {
     rf::Frequency center_frequency;
     uint32_t sample_rate;
     float latitude = 0;
     float longitude = 0;
     uint8_t satinuse = 0;
+    capture_codec codec = capture_codec::raw;
+    uint64_t sample_count = 0;  // Decoded length of packed captures, 0 if unknown.
+    /* Virtual trim: replay samples [trim_start, trim_end), trim_end 0 plays to the end. */
+    uint64_t trim_start = 0;
+    uint64_t trim_end = 0;
 };
 
 std::filesystem::path get_metadata_path(const std::filesystem::path& capture_path);
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "replay_pool.hpp"
+
+#include <algorithm>
+
+uint32_t ReplayPoolConfig::slack_ms() const {
+    if (stream_rate == 0 || buffer_count == 0)
+        return 0;
+
+    // One buffer is always being drained by the baseband.
+    return static_cast<uint64_t>(buffer_count - 1) * read_size * 1000 / stream_rate;
+}
+
+ReplayPoolConfig size_replay_pool(
+    uint32_t sample_rate,
+    size_t bytes_per_sample,
+    uint32_t sd_rate,
+    const ReplayPoolLimits& limits) {
+    ReplayPoolConfig pool{};
+    pool.stream_rate = sample_rate * bytes_per_sample;
+    pool.sd_rate = sd_rate;
+
+    const size_t pool_min = limits.min_read_size * limits.min_buffer_count;
+    const size_t pool_max = std::max(limits.memory_budget, pool_min);
+
+    // Enough memory to ride out the target stall, or everything there is
+    // when the card can't comfortably keep ahead of the stream.
+    uint64_t wanted = static_cast<uint64_t>(pool.stream_rate) * limits.target_slack_ms / 1000;
+    if (sd_rate != 0 && sd_rate < 2 * static_cast<uint64_t>(pool.stream_rate))
+        wanted = pool_max;
+    wanted = std::clamp<uint64_t>(wanted, pool_min, pool_max);
+
+    // Largest power-of-two read that still leaves min_buffer_count buffers;
+    // big reads let FatFs transfer whole clusters straight into the buffer.
+    size_t read_size = limits.min_read_size;
+    while (read_size * 2 <= limits.max_read_size &&
+           read_size * 2 * limits.min_buffer_count <= wanted)
+        read_size *= 2;
+
+    pool.read_size = read_size;
+    pool.buffer_count = std::clamp<size_t>(
+        wanted / read_size, limits.min_buffer_count, limits.max_buffer_count);
+
+    return pool;
+}
+
+size_t cluster_transfer_size(size_t size, size_t cluster_size) {
+    constexpr size_t sector_size = 512;
+    if (size < sector_size || cluster_size < sector_size)
+        return size;
+
+    if (size >= cluster_size)
+        return size / cluster_size * cluster_size;
+
+    size_t transfer = sector_size;
+    while (transfer * 2 <= size && cluster_size % (transfer * 2) == 0)
+        transfer *= 2;
+    return transfer;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __REPLAY_POOL_H__
+#define __REPLAY_POOL_H__
+
+#include <cstddef>
+#include <cstdint>
+
+/* Bounds for sizing the replay stream buffer pool. The buffers live in the
+ * baseband heap, which may shrink buffer_count further to make them fit. */
+struct ReplayPoolLimits {
+    size_t memory_budget{64 * 1024};
+    size_t min_read_size{4 * 1024};
+    size_t max_read_size{32 * 1024};
+    size_t min_buffer_count{3};
+    size_t max_buffer_count{8};
+
+    /* How long the pool should cover an SD card that stops delivering. */
+    uint32_t target_slack_ms{250};
+};
+
+/* The buffer pool chosen for a replay, and what it was chosen from. */
+struct ReplayPoolConfig {
+    size_t read_size{16 * 1024};
+    size_t buffer_count{3};
+    uint32_t stream_rate{0};  // Bytes/s consumed by the baseband.
+    uint32_t sd_rate{0};      // Bytes/s measured at start, 0 if unknown.
+
+    /* Time the full buffers can feed the baseband without a new read. */
+    uint32_t slack_ms() const;
+
+    /* False if the card measured slower than the stream consumes data. */
+    bool sustainable() const {
+        return sd_rate == 0 || sd_rate >= stream_rate;
+    }
+};
+
+/* Picks read size and buffer count for a stream of sample_rate samples/s.
+ * sd_rate is the measured card throughput in bytes/s, 0 if unknown. */
+ReplayPoolConfig size_replay_pool(
+    uint32_t sample_rate,
+    size_t bytes_per_sample,
+    uint32_t sd_rate,
+    const ReplayPoolLimits& limits = {});
+
+/* Largest transfer no bigger than size that tiles the card's clusters:
+ * a whole number of clusters, or whole sectors dividing one cluster.
+ * FatFs then moves every transfer with multi-block commands straight
+ * from the buffer. Sizes below a sector or an unknown cluster size
+ * (0) are returned unchanged. */
+size_t cluster_transfer_size(size_t size, size_t cluster_size);
+
+#endif /*__REPLAY_POOL_H__*/
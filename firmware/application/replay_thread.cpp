@@ -42,8 +42,30 @@ ReplayThread::ReplayThread(
     size_t read_size,
     size_t buffer_count,
     bool* ready_signal,
-    std::function<void(uint32_t return_code)> terminate_callback)
-    : config{read_size, buffer_count},
+    std::function<void(uint32_t return_code)> terminate_callback,
+    ReplayFillPolicy fill_policy)
+    : config{read_size, buffer_count, fill_policy},
+      reader{std::move(reader)},
+      ready_sig{ready_signal},
+      terminate_callback{std::move(terminate_callback)} {
+    pool_.read_size = read_size;
+    pool_.buffer_count = buffer_count;
+
+    // Need significant stack for FATFS
+    thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, ReplayThread::static_fn, this);
+}
+
+ReplayThread::ReplayThread(
+    std::unique_ptr<stream::Reader> reader,
+    uint32_t sampling_rate,
+    bool* ready_signal,
+    std::function<void(uint32_t return_code)> terminate_callback,
+    ReplayFillPolicy fill_policy,
+    const ReplayPoolLimits& pool_limits)
+    : config{0, 0, fill_policy},
+      pool_limits{pool_limits},
+      sampling_rate{sampling_rate},
+      adaptive_pool{true},
       reader{std::move(reader)},
       ready_sig{ready_signal},
       terminate_callback{std::move(terminate_callback)} {
@@ -68,7 +90,164 @@ msg_t ReplayThread::static_fn(void* arg) {
     return 0;
 }
 
+void ReplayThread::set_loop(const bool enabled, const File::Offset start_position) {
+    chSysLock();
+    loop_enabled = enabled;
+    loop_start = start_position;
+    chSysUnlock();
+}
+
+bool ReplayThread::queue_next(
+    std::unique_ptr<stream::Reader> next,
+    File::Size gap_bytes,
+    std::function<void(uint32_t stream_offset)> started_callback) {
+    chSysLock();
+    const bool queued = !next_reader;
+    if (queued) {
+        next_reader.swap(next);
+        next_gap = gap_bytes;
+        next_callback.swap(started_callback);
+    }
+    chSysUnlock();
+
+    return queued;
+}
+
+/* Swaps in the queued stream, if any. Runs at the end of the current one. */
+bool ReplayThread::start_next_stream(const uint32_t position) {
+    std::unique_ptr<stream::Reader> next;
+    std::function<void(uint32_t stream_offset)> callback;
+
+    chSysLock();
+    next.swap(next_reader);
+    callback.swap(next_callback);
+    const auto gap = next_gap;
+    chSysUnlock();
+
+    if (!next)
+        return false;
+
+    if (!next_prepared)
+        next->enable_fast_seek();
+
+    reader = std::move(next);
+    next_prepared = false;
+    gap_remaining = gap;
+
+    if (callback)
+        callback(position + gap);
+    return true;
+}
+
+/* Does the slow part of opening the queued stream while buffers are full. */
+void ReplayThread::prepare_next_stream() {
+    if (next_prepared)
+        return;
+
+    // Only this thread takes the queued reader, so it stays valid once seen.
+    chSysLock();
+    const auto next = next_reader.get();
+    chSysUnlock();
+
+    if (next) {
+        next->enable_fast_seek();
+        next_prepared = true;
+    }
+}
+
+File::Result<File::Size> ReplayThread::read_buffer(StreamBuffer* const buffer) {
+    auto p = static_cast<uint8_t*>(buffer->data());
+    const File::Size capacity = buffer->capacity();
+    File::Size filled = 0;
+    bool data_since_wrap = true;
+
+    while (filled < capacity) {
+        // Silence between queued streams.
+        if (gap_remaining) {
+            const auto n = std::min<File::Size>(gap_remaining, capacity - filled);
+            memset(&p[filled], 0, n);
+            filled += n;
+            gap_remaining -= n;
+            continue;
+        }
+
+        auto read_result = reader->read(&p[filled], capacity - filled);
+        if (read_result.is_error())
+            return read_result;
+
+        filled += read_result.value();
+        data_since_wrap |= read_result.value() > 0;
+        if (filled == capacity)
+            break;
+
+        // Short read, end of file. A queued stream carries on in this buffer.
+        if (start_next_stream(stream_position + filled))
+            continue;
+
+        chSysLock();
+        const auto loop = loop_enabled;
+        const auto start = loop_start;
+        chSysUnlock();
+
+        // Stop if looping is off or a whole pass produced nothing.
+        if (!loop || !data_since_wrap)
+            break;
+
+        auto seek_result = reader->seek(start);
+        if (seek_result.is_error())
+            return seek_result.error();
+
+        data_since_wrap = false;
+        loop_count = loop_count + 1;
+    }
+
+    // Pad the last partial buffer with silence rather than stale samples.
+    if (filled > 0 && filled < capacity)
+        memset(&p[filled], 0, capacity - filled);
+
+    if (filled > 0)
+        stream_position += capacity;
+
+    return filled;
+}
+
+uint32_t ReplayThread::probe_read_rate() {
+    constexpr size_t probe_chunk = 4096;
+    constexpr size_t probe_chunks = 8;
+
+    // Time a few reads of the file head, then go back to where we were.
+    const auto position = reader->seek(0);
+    if (position.is_error())
+        return 0;
+
+    auto scratch = std::make_unique<uint8_t[]>(probe_chunk);
+    File::Size bytes = 0;
+    const auto start = chTimeNow();
+
+    for (size_t i = 0; i < probe_chunks; i++) {
+        auto read_result = reader->read(scratch.get(), probe_chunk);
+        if (read_result.is_error() || read_result.value() == 0)
+            break;
+        bytes += read_result.value();
+    }
+
+    const auto elapsed_ms = std::max<systime_t>(chTimeNow() - start, 1) * 1000 / CH_FREQUENCY;
+    if (reader->seek(position.value()).is_error())
+        return 0;
+
+    return bytes * 1000 / elapsed_ms;
+}
+
 uint32_t ReplayThread::run() {
+    // Map the clusters once so that mid-stream reads and loop seeks skip the FAT.
+    reader->enable_fast_seek();
+
+    if (adaptive_pool) {
+        pool_ = size_replay_pool(sampling_rate, sizeof(complex8_t), probe_read_rate(), pool_limits);
+        config.read_size = pool_.read_size;
+        config.buffer_count = pool_.buffer_count;
+    }
+
     BasebandReplay replay{&config};
     BufferExchange buffers{&config};
 
@@ -80,8 +259,6 @@ uint32_t ReplayThread::run() {
         chThdSleep(100);
     };
 
-    constexpr size_t block_size = 512;
-
     // While empty buffers fifo is not empty...
     while (!buffers.empty()) {
         prefill_buffer = buffers.get_prefill();
@@ -89,16 +266,13 @@ uint32_t ReplayThread::run() {
         if (prefill_buffer == nullptr) {
             buffers.put_app(prefill_buffer);
         } else {
-            size_t blocks = config.read_size / block_size;
-
-            for (size_t c = 0; c < blocks; c++) {
-                auto read_result = reader->read(&((uint8_t*)prefill_buffer->data())[c * block_size], block_size);
-                if (read_result.is_error()) {
-                    return READ_ERROR;
-                }
+            // One read per buffer lets FatFs move whole sectors straight in.
+            auto read_result = read_buffer(prefill_buffer);
+            if (read_result.is_error()) {
+                return READ_ERROR;
             }
 
-            prefill_buffer->set_size(config.read_size);
+            prefill_buffer->set_size(prefill_buffer->capacity());
 
             buffers.put(prefill_buffer);
         }
@@ -109,11 +283,13 @@ uint32_t ReplayThread::run() {
     while (!chThdShouldTerminate()) {
         auto buffer = buffers.get();
 
-        auto read_result = reader->read(buffer->data(), buffer->capacity());
+        auto read_result = read_buffer(buffer);
         if (read_result.is_error()) {
             return READ_ERROR;
         } else {
             if (read_result.value() == 0) {
+                // Let the baseband tell draining the FIFOs from an underrun.
+                config.end_of_stream = true;
                 return END_OF_FILE;
             }
         }
@@ -121,6 +297,7 @@ uint32_t ReplayThread::run() {
         buffer->set_size(buffer->capacity());
 
         buffers.put(buffer);
+        prepare_next_stream();
     }
 
     return TERMINATED;
@@ -29,6 +29,7 @@
 
 #include "io.hpp"
 #include "optional.hpp"
+#include "replay_pool.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -41,7 +42,20 @@ class ReplayThread {
         size_t read_size,
         size_t buffer_count,
         bool* ready_signal,
-        std::function<void(uint32_t return_code)> terminate_callback);
+        std::function<void(uint32_t return_code)> terminate_callback,
+        ReplayFillPolicy fill_policy = ReplayFillPolicy::Zero);
+
+    /* Sizes the buffer pool from the C8 stream's sampling rate, the pool
+     * limits and a read speed probe of the card taken when the thread
+     * starts. */
+    ReplayThread(
+        std::unique_ptr<stream::Reader> reader,
+        uint32_t sampling_rate,
+        bool* ready_signal,
+        std::function<void(uint32_t return_code)> terminate_callback,
+        ReplayFillPolicy fill_policy = ReplayFillPolicy::Zero,
+        const ReplayPoolLimits& pool_limits = {});
+
     ~ReplayThread();
 
     ReplayThread(const ReplayThread&) = delete;
@@ -53,6 +67,34 @@ class ReplayThread {
         return config;
     };
 
+    /* The pool the thread asked for. state() holds what the baseband
+     * actually allocated once the ready signal is set. */
+    const ReplayPoolConfig& pool() const {
+        return pool_;
+    };
+
+    /* When enabled, reaching the end of the file seeks back to start_position
+     * and keeps filling the same buffers, so the baseband sees one continuous
+     * stream. Can be changed while running; applies at the next end of file. */
+    void set_loop(const bool enabled, const File::Offset start_position = 0);
+
+    /* Number of times the stream has wrapped around. */
+    uint32_t loops() const {
+        return loop_count;
+    };
+
+    /* Queues the reader for the stream that follows this one. At the end
+     * of the current stream the thread switches to it inside the same
+     * buffer, after gap_bytes of silence, so the baseband never sees the
+     * FIFO drain. The queued file's cluster map is built while the current
+     * one still plays. started_callback runs on the replay thread with the
+     * stream offset, in bytes, where the new stream's samples begin.
+     * Returns false if a stream is already queued. */
+    bool queue_next(
+        std::unique_ptr<stream::Reader> next,
+        File::Size gap_bytes,
+        std::function<void(uint32_t stream_offset)> started_callback);
+
     enum replaythread_return {
         READ_ERROR = 0,
         END_OF_FILE,
@@ -61,14 +103,31 @@ class ReplayThread {
 
    private:
     ReplayConfig config;
+    ReplayPoolConfig pool_{};
+    const ReplayPoolLimits pool_limits{};
+    const uint32_t sampling_rate{0};
+    const bool adaptive_pool{false};
     std::unique_ptr<stream::Reader> reader;
     bool* ready_sig;
+    bool loop_enabled{false};
+    File::Offset loop_start{0};
+    volatile uint32_t loop_count{0};
+    std::unique_ptr<stream::Reader> next_reader{};
+    File::Size next_gap{0};
+    std::function<void(uint32_t stream_offset)> next_callback{};
+    bool next_prepared{false};
+    File::Size gap_remaining{0};
+    uint32_t stream_position{0};  // Bytes handed to the baseband, wraps like its counters.
     std::function<void(uint32_t return_code)> terminate_callback;
     Thread* thread{nullptr};
 
     static msg_t static_fn(void* arg);
 
     uint32_t run();
+    uint32_t probe_read_rate();
+    File::Result<File::Size> read_buffer(StreamBuffer* const buffer);
+    bool start_next_stream(const uint32_t position);
+    void prepare_next_stream();
 };
 
 #endif /*__REPLAY_THREAD_H__*/
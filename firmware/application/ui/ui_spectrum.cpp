@@ -317,11 +317,27 @@ void WaterfallView::on_hide() {
 
 void WaterfallView::start() {
     if (!running_) {
-        baseband::spectrum_streaming_start();
+        baseband::spectrum_streaming_start(fft_size_, fft_window_, averaging_, average_count_);
         running_ = true;
     }
 }
 
+void WaterfallView::set_fft(const size_t fft_size, const SpectrumWindow window) {
+    fft_size_ = fft_size;
+    fft_window_ = window;
+
+    if (running_)
+        baseband::spectrum_streaming_start(fft_size_, fft_window_, averaging_, average_count_);
+}
+
+void WaterfallView::set_averaging(const SpectrumAveraging averaging, const uint8_t count) {
+    averaging_ = averaging;
+    average_count_ = count;
+
+    if (running_)
+        baseband::spectrum_streaming_start(fft_size_, fft_window_, averaging_, average_count_);
+}
+
 void WaterfallView::stop() {
     if (running_) {
         baseband::spectrum_streaming_stop();
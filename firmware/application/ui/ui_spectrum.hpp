@@ -138,6 +138,10 @@ class WaterfallView : public View {
     void start();
     void stop();
 
+    /* These restart streaming with the new settings when it is running. */
+    void set_fft(const size_t fft_size, const SpectrumWindow window);
+    void set_averaging(const SpectrumAveraging averaging, const uint8_t count);
+
     void set_parent_rect(const Rect new_parent_rect) override;
     void show_audio_spectrum_view(const bool show);
 
@@ -151,6 +155,10 @@ class WaterfallView : public View {
     WaterfallWidget waterfall_widget{};
     FrequencyScale frequency_scale{};
     bool running_{false};
+    size_t fft_size_{SpectrumStreamingConfigMessage::min_fft_size};
+    SpectrumWindow fft_window_{SpectrumWindow::Hann};
+    SpectrumAveraging averaging_{SpectrumAveraging::None};
+    uint8_t average_count_{1};
 
     ChannelSpectrumFIFO* channel_fifo{nullptr};
     AudioSpectrum* audio_spectrum_data{nullptr};
@@ -122,7 +122,7 @@ uint32_t RecordView::set_sampling_rate(uint32_t new_sampling_rate) {
         stop();
 
         sampling_rate = new_sampling_rate;
-        baseband::set_sample_rate(sampling_rate, oversample_rate);
+        baseband::set_sample_rate(sampling_rate, oversample_rate, decimation_filter);
 
         button_record.hidden(sampling_rate == 0);
         text_record_filename.hidden(sampling_rate == 0);
@@ -141,7 +141,30 @@ OversampleRate RecordView::get_oversample_rate(uint32_t sample_rate) {
     if (file_type == FileType::WAV)
         return OversampleRate::None;
 
-    return ::get_oversample_rate(sample_rate);
+    return ::get_oversample_rate(sample_rate, decimation);
+}
+
+void RecordView::set_decimation(OversampleRate oversample_rate, DecimationFilter filter) {
+    if (oversample_rate == decimation && filter == decimation_filter)
+        return;
+
+    decimation = oversample_rate;
+    decimation_filter = filter;
+
+    // Forces the next set_sampling_rate to reconfigure the baseband.
+    sampling_rate = 0;
+}
+
+uint32_t RecordView::bytes_per_second() const {
+    if (is_active() && packed_writer && measured_bytes_per_second > 0)
+        return measured_bytes_per_second;
+
+    // - Audio is 1 int16_t per sample or '2' bytes per sample.
+    // - C8 captures 2 (I,Q) int8_t per sample or '2' bytes per sample.
+    // - C16 captures 2 (I,Q) int16_t per sample or '4' bytes per sample.
+    // - Packed C16 is estimated at its incompressible worst case, '4' bytes per sample.
+    const auto bytes_per_sample = (file_type == FileType::RawS16 || file_type == FileType::PackedS16) ? 4 : 2;
+    return sampling_rate * bytes_per_sample;
 }
 
 // Setter for datetime and frequency filename
@@ -244,6 +267,37 @@ void RecordView::start() {
             if (create_error.is_valid()) {
                 handle_error(create_error.value());
             } else {
+                if (capture_limit_seconds) {
+                    // A contiguous file keeps FAT walks out of the write path. Without
+                    // one large enough the capture still runs, allocating as it goes.
+                    const uint64_t file_bytes_per_sample = (file_type == FileType::RawS8) ? 2 : 4;
+                    p->preallocate(uint64_t(sampling_rate) * capture_limit_seconds * file_bytes_per_sample);
+                }
+                writer = std::move(p);
+            }
+        } break;
+
+        case FileType::PackedS16: {
+            // Written again with the decoded length once the capture stops.
+            packed_metadata = {receiver_model.target_frequency(), sampling_rate, latitude, longitude, satinuse,
+                               capture_codec::delta_pack};
+            packed_metadata_path = get_metadata_path(base_path);
+            const auto metadata_file_error = write_metadata_file(packed_metadata_path, packed_metadata);
+            if (metadata_file_error.is_valid()) {
+                handle_error(metadata_file_error.value());
+                return;
+            }
+
+            auto p = std::make_unique<PackedFileWriter>();
+            auto create_error = p->create(base_path.replace_extension(u".CIQ"));
+            if (create_error.is_valid()) {
+                handle_error(create_error.value());
+            } else {
+                if (capture_limit_seconds)
+                    p->preallocate(uint64_t(sampling_rate) * capture_limit_seconds * sizeof(complex16_t));
+                packed_writer = p.get();
+                last_bytes_written = 0;
+                measured_bytes_per_second = 0;
                 writer = std::move(p);
             }
         } break;
@@ -255,9 +309,14 @@ void RecordView::start() {
     if (writer) {
         text_record_filename.set(truncate(base_path.filename().string(), 8));
         button_record.set_bitmap(&bitmap_stop);
+        // The baseband delivers C16 for raw captures and 16-bit audio for WAV.
+        const uint64_t stream_bytes_per_sample = (file_type == FileType::WAV) ? 2 : 4;
+        const uint64_t byte_limit = uint64_t(sampling_rate) * capture_limit_seconds * stream_bytes_per_sample;
+
         capture_thread = std::make_unique<CaptureThread>(
             std::move(writer),
             write_size, buffer_count,
+            byte_limit,
             []() {
                 CaptureThreadDoneMessage message{};
                 EventDispatcher::send_message(message);
@@ -265,7 +324,8 @@ void RecordView::start() {
             [](File::Error error) {
                 CaptureThreadDoneMessage message{error.code()};
                 EventDispatcher::send_message(message);
-            });
+            },
+            (file_type == FileType::WAV) ? CaptureTriggerConfig{} : trigger);
     }
 
     update_status_display();
@@ -278,7 +338,10 @@ void RecordView::on_hide() {
 
 void RecordView::stop() {
     if (is_active()) {
+        capture_thread->stop();
+        finish_packed_capture(capture_thread->bytes_captured());
         capture_thread.reset();
+        packed_writer = nullptr;
         button_record.set_bitmap(&bitmap_record);
         trim_capture();
     }
@@ -287,14 +350,26 @@ void RecordView::stop() {
 }
 
 void RecordView::on_tick_second() {
+    if (is_active() && packed_writer) {
+        const auto bytes_written = packed_writer->bytes_written();
+        measured_bytes_per_second = bytes_written - last_bytes_written;
+        last_bytes_written = bytes_written;
+    }
+
     update_status_display();
 }
 
 void RecordView::update_status_display() {
     if (is_active()) {
-        const auto dropped_percent = std::min(99U, capture_thread->state().dropped_percent());
-        const auto s = to_string_dec_uint(dropped_percent, 2, ' ') + "%";
-        text_record_dropped.set(s);
+        const auto& state = capture_thread->state();
+        if (state.trigger.enabled() && !state.trigger_fired) {
+            // Nothing is written until the trigger fires.
+            text_record_dropped.set("ARM");
+        } else {
+            const auto dropped_percent = std::min(99U, state.dropped_percent());
+            const auto s = to_string_dec_uint(dropped_percent, 2, ' ') + "%";
+            text_record_dropped.set(s);
+        }
     }
 
     /*
@@ -305,12 +380,7 @@ void RecordView::update_status_display() {
 
     if (sampling_rate > 0) {
         const auto space_info = std::filesystem::space(u"");
-        // - Audio is 1 int16_t per sample or '2' bytes per sample.
-        // - C8 captures 2 (I,Q) int8_t per sample or '2' bytes per sample.
-        // - C16 captures 2 (I,Q) int16_t per sample or '4' bytes per sample.
-        const auto bytes_per_sample = file_type == FileType::RawS16 ? 4 : 2;
-        const uint32_t bytes_per_second = sampling_rate * bytes_per_sample;
-        const uint32_t available_seconds = space_info.free / bytes_per_second;
+        const uint32_t available_seconds = space_info.free / std::max<uint32_t>(1, bytes_per_second());
         const uint32_t seconds = available_seconds % 60;
         const uint32_t available_minutes = available_seconds / 60;
         const uint32_t minutes = available_minutes % 60;
@@ -323,6 +393,18 @@ void RecordView::update_status_display() {
     }
 }
 
+void RecordView::finish_packed_capture(const uint64_t bytes_captured) {
+    if (packed_metadata_path.empty())
+        return;
+
+    packed_metadata.sample_count = bytes_captured / sizeof(complex16_t);
+    const auto metadata_file_error = write_metadata_file(packed_metadata_path, packed_metadata);
+    if (metadata_file_error.is_valid())
+        handle_error(metadata_file_error.value());
+
+    packed_metadata_path = {};
+}
+
 void RecordView::trim_capture() {
     using bucket_t = iq::PowerBuckets::Bucket;
 
@@ -28,12 +28,15 @@
 #include "bitmap.hpp"
 #include "capture_thread.hpp"
 #include "iq_trim.hpp"
+#include "metadata_file.hpp"
 #include "signal.hpp"
 
 #include <cstddef>
 #include <string>
 #include <memory>
 
+class PackedFileWriter;
+
 namespace ui {
 
 class RecordView : public View {
@@ -44,6 +47,7 @@ class RecordView : public View {
         RawS8 = 1,
         RawS16 = 2,
         WAV = 3,
+        PackedS16 = 4,  // C16 through iq_codec, written as .CIQ.
     };
 
     RecordView(
@@ -63,9 +67,24 @@ class RecordView : public View {
      * that can be used to configure the radio or other UI element. */
     uint32_t set_sampling_rate(uint32_t new_sampling_rate);
 
+    /* Chooses the capture decimation instead of the oversample table, None
+     * follows the table. Takes effect on the next set_sampling_rate. */
+    void set_decimation(OversampleRate oversample_rate, DecimationFilter filter);
+
+    /* Rate the capture is written to the card at, measured while a packed
+     * capture is running and estimated from the format otherwise. */
+    uint32_t bytes_per_second() const;
+
     void set_file_type(const FileType v) { file_type = v; }
+
+    /* Holds IQ captures back until the trigger fires, see CaptureTriggerConfig. */
+    void set_trigger(const CaptureTriggerConfig& v) { trigger = v; }
     void set_auto_trim(bool v) { auto_trim = v; }
 
+    /* Stops the capture after this many seconds, 0 records until stopped.
+     * Raw captures with a limit are written to a pre-allocated file. */
+    void set_capture_limit(uint32_t seconds) { capture_limit_seconds = seconds; }
+
     void start();
     void stop();
     void on_hide() override;
@@ -82,6 +101,7 @@ class RecordView : public View {
     void on_tick_second();
     void update_status_display();
     void trim_capture();
+    void finish_packed_capture(const uint64_t bytes_captured);
 
     void handle_capture_thread_done(const File::Error error);
     void handle_error(const File::Error error);
@@ -106,10 +126,19 @@ class RecordView : public View {
     const size_t write_size;
     const size_t buffer_count;
     uint32_t sampling_rate{0};
+    OversampleRate decimation{OversampleRate::None};
+    DecimationFilter decimation_filter{DecimationFilter::Standard};
+    const PackedFileWriter* packed_writer{nullptr};  // Owned by capture_thread.
+    uint64_t last_bytes_written{0};
+    uint32_t measured_bytes_per_second{0};
     SignalToken signal_token_tick_second{};
 
     bool auto_trim = false;
+    uint32_t capture_limit_seconds{0};
+    CaptureTriggerConfig trigger{};
     std::filesystem::path trim_path{};
+    std::filesystem::path packed_metadata_path{};
+    capture_metadata packed_metadata{};
     TrimProgressUI trim_ui{};
 
     Rectangle rect_background{
@@ -25,6 +25,7 @@
 
 #include "file.hpp"
 #include "lfsr_random.hpp"
+#include "message.hpp"
 
 #include "ff.h"
 #include "diskio.h"
@@ -73,7 +74,11 @@ class SDCardTestThread {
         size_t read_count{0};
     };
 
-    SDCardTestThread() {
+    /* transfer_size is the bytes per read or write call. */
+    SDCardTestThread(const File::Size transfer_size)
+        : transfer_size{transfer_size},
+          bytes_to_write{std::min(bytes_to_write_max, transfer_size * transfers_max)},
+          bytes_to_read{bytes_to_write} {
         thread = chThdCreateFromHeap(NULL, 3072, NORMALPRIO + 10, SDCardTestThread::static_fn, this);
     }
 
@@ -91,9 +96,13 @@ class SDCardTestThread {
     }
 
    private:
-    static constexpr File::Size write_size = 16384;
-    static constexpr File::Size bytes_to_write = 16 * 1024 * 1024;
-    static constexpr File::Size bytes_to_read = bytes_to_write;
+    static constexpr File::Size bytes_to_write_max = 16 * 1024 * 1024;
+    // Keeps single sector runs short.
+    static constexpr File::Size transfers_max = 4096;
+
+    const File::Size transfer_size;
+    const File::Size bytes_to_write;
+    const File::Size bytes_to_read;
 
     static Thread* thread;
     volatile Result _result{Result::Incomplete};
@@ -139,9 +148,18 @@ class SDCardTestThread {
         return Result::OK;
     }
 
+    /* Sector aligned like the capture and replay pools, so whole sectors
+     * go to the SDIO DMA straight from the buffer. */
+    std::unique_ptr<uint8_t[]> allocate_buffer(uint8_t*& aligned) const {
+        auto storage = std::make_unique<uint8_t[]>(transfer_size + stream_buffer_alignment - 1);
+        aligned = storage ? align_stream_buffer(storage.get()) : nullptr;
+        return storage;
+    }
+
     Result write(const std::filesystem::path& filename) {
-        const auto buffer = std::make_unique<std::array<uint8_t, write_size>>();
-        if (!buffer) {
+        uint8_t* buffer{nullptr};
+        const auto storage = allocate_buffer(buffer);
+        if (!storage) {
             return Result::FailHeap;
         }
 
@@ -156,16 +174,16 @@ class SDCardTestThread {
         const halrtcnt_t test_start = halGetCounterValue();
         while (!chThdShouldTerminate() && (_stats.write_bytes < bytes_to_write)) {
             lfsr_fill(v,
-                      reinterpret_cast<lfsr_word_t*>(buffer->data()),
-                      sizeof(*buffer.get()) / sizeof(lfsr_word_t));
+                      reinterpret_cast<lfsr_word_t*>(buffer),
+                      transfer_size / sizeof(lfsr_word_t));
 
             const halrtcnt_t write_start = halGetCounterValue();
-            const auto result_write = file.write(buffer->data(), buffer->size());
+            const auto result_write = file.write(buffer, transfer_size);
             if (result_write.is_error()) {
                 break;
             }
             const halrtcnt_t write_end = halGetCounterValue();
-            _stats.write_bytes += buffer->size();
+            _stats.write_bytes += transfer_size;
             _stats.write_count++;
 
             const halrtcnt_t write_duration = write_end - write_start;
@@ -186,8 +204,9 @@ class SDCardTestThread {
     }
 
     Result read(const std::filesystem::path& filename) {
-        const auto buffer = std::make_unique<std::array<uint8_t, write_size>>();
-        if (!buffer) {
+        uint8_t* buffer{nullptr};
+        const auto storage = allocate_buffer(buffer);
+        if (!storage) {
             return Result::FailHeap;
         }
 
@@ -202,12 +221,12 @@ class SDCardTestThread {
         const halrtcnt_t test_start = halGetCounterValue();
         while (!chThdShouldTerminate() && (_stats.read_bytes < bytes_to_read)) {
             const halrtcnt_t read_start = halGetCounterValue();
-            const auto result_read = file.read(buffer->data(), buffer->size());
+            const auto result_read = file.read(buffer, transfer_size);
             if (result_read.is_error()) {
                 break;
             }
             const halrtcnt_t read_end = halGetCounterValue();
-            _stats.read_bytes += buffer->size();
+            _stats.read_bytes += transfer_size;
             _stats.read_count++;
 
             const halrtcnt_t read_duration = read_end - read_start;
@@ -219,8 +238,8 @@ class SDCardTestThread {
             }
 
             if (!lfsr_compare(v,
-                              reinterpret_cast<lfsr_word_t*>(buffer->data()),
-                              sizeof(*buffer.get()) / sizeof(lfsr_word_t))) {
+                              reinterpret_cast<lfsr_word_t*>(buffer),
+                              transfer_size / sizeof(lfsr_word_t))) {
                 return Result::FailCompare;
             }
         }
@@ -259,10 +278,13 @@ SDCardDebugView::SDCardDebugView(NavigationView& nav) {
         &text_test_read_time_value,
         &text_test_read_rate_title,
         &text_test_read_rate_value,
+        &options_transfer,
         &button_test,
         &button_ok,
     });
 
+    options_transfer.set_selected_index(1);
+
     button_test.on_select = [this](Button&) { this->on_test(); };
     button_ok.on_select = [&nav](Button&) { nav.pop(); };
 }
@@ -404,7 +426,7 @@ void SDCardDebugView::on_test() {
     text_test_read_time_value.set("");
     text_test_read_rate_value.set("");
 
-    SDCardTestThread thread;
+    SDCardTestThread thread{transfer_size()};
 
     // uint32_t spinner_phase = 0;
     while (thread.result() == SDCardTestThread::Result::Incomplete) {
@@ -450,6 +472,16 @@ void SDCardDebugView::on_test() {
     }
 }
 
+File::Size SDCardDebugView::transfer_size() const {
+    const auto selected = static_cast<File::Size>(options_transfer.selected_index_value());
+    if (selected)
+        return selected;
+
+    // One cluster, as capture and replay transfers are sized; bounded by the M0 heap.
+    const File::Size cluster_size = sd_card::fs.csize * _MAX_SS;
+    return std::clamp<File::Size>(cluster_size, _MAX_SS, transfer_size_max);
+}
+
 std::string SDCardDebugView::fetch_sdcard_format() {
     const size_t max_len = sizeof("Undefined: 255") + 1;
 
@@ -25,6 +25,7 @@
 #include "ui_widget.hpp"
 #include "ui_navigation.hpp"
 
+#include "file.hpp"
 #include "sd_card.hpp"
 
 namespace ui {
@@ -45,8 +46,11 @@ class SDCardDebugView : public View {
 
     void on_status(const sd_card::Status status);
     void on_test();
+    File::Size transfer_size() const;
     std::string fetch_sdcard_format();
 
+    static constexpr File::Size transfer_size_max = 32 * 1024;
+
     Labels labels{
         {{0 * 8, 1 * 16}, "Format", Theme::getInstance()->fg_light->foreground},
         {{0 * 8, 3 * 16}, "CSD", Theme::getInstance()->fg_light->foreground},
@@ -55,6 +59,7 @@ class SDCardDebugView : public View {
         {{0 * 8, 8 * 16}, "Block size", Theme::getInstance()->fg_light->foreground},
         {{0 * 8, 9 * 16}, "Block count", Theme::getInstance()->fg_light->foreground},
         {{0 * 8, 10 * 16}, "Capacity", Theme::getInstance()->fg_light->foreground},
+        {{0 * 8, 11 * 16}, "Test transfer", Theme::getInstance()->fg_light->foreground},
         {{0 * 8, 5 * 16}, "Bus width", Theme::getInstance()->fg_light->foreground},
 
     };
@@ -119,6 +124,15 @@ class SDCardDebugView : public View {
         "",
     };
 
+    /* Bytes per read or write call. One sector shows what unaligned
+     * access through the FatFs window costs, 0 picks the cluster size. */
+    OptionsField options_transfer{
+        {240 - (7 * 8), 11 * 16},
+        7,
+        {{"512B", 512},
+         {"16K", 16384},
+         {"Cluster", 0}}};
+
     ///////////////////////////////////////////////////////////////////////
 
     static constexpr size_t test_write_time_characters = 23;
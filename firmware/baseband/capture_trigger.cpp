@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "capture_trigger.hpp"
+
+#include "heap_allocation.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+CaptureTrigger::CaptureTrigger(CaptureTriggerConfig& config, const size_t max_bytes, const size_t heap_reserve)
+    : config_{config} {
+    // Whole samples only, so draining never splits one.
+    size_t samples = std::min<size_t>(config.pre_trigger_bytes, max_bytes) / sizeof(complex16_t);
+    if (samples)
+        ring_ = allocate_fitting(samples, sizeof(complex16_t), heap_reserve);
+    capacity_ = samples * sizeof(complex16_t);
+    config.pre_trigger_bytes = capacity_;
+
+    // The blocks a match needs to have seen, so that leading "off" states
+    // don't match the history from before the capture started.
+    for (auto mask = config_.pattern_mask; mask; mask >>= 1)
+        pattern_length_++;
+}
+
+bool CaptureTrigger::evaluate(const buffer_c16_t& block) {
+    if (fired_)
+        return false;
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < block.count; i++) {
+        const int32_t re = block.p[i].real();
+        const int32_t im = block.p[i].imag();
+        sum += static_cast<uint32_t>(re * re) + static_cast<uint32_t>(im * im);
+    }
+    const auto mean_power = block.count ? sum / block.count : 0;
+
+    history_ = (history_ << 1) | (mean_power > config_.power_threshold ? 1 : 0);
+    blocks_seen_++;
+
+    fired_ = blocks_seen_ >= pattern_length_ &&
+             (history_ & config_.pattern_mask) == (config_.pattern & config_.pattern_mask);
+    return fired_;
+}
+
+void CaptureTrigger::store(const void* const data, const size_t length) {
+    if (capacity_ == 0)
+        return;
+
+    auto p = static_cast<const uint8_t*>(data);
+    auto n = length;
+
+    // Only the newest capacity_ bytes can be kept.
+    if (n > capacity_) {
+        p += n - capacity_;
+        n = capacity_;
+    }
+
+    const auto first = std::min(n, capacity_ - head_);
+    memcpy(&ring_[head_], p, first);
+    memcpy(&ring_[0], p + first, n - first);
+
+    head_ = (head_ + n) % capacity_;
+    fill_ = std::min(fill_ + n, capacity_);
+}
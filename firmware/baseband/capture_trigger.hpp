@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __CAPTURE_TRIGGER_H__
+#define __CAPTURE_TRIGGER_H__
+
+#include "dsp_types.hpp"
+#include "message.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+/* Holds a triggered capture back. Output blocks are evaluated against
+ * the trigger and kept in a ring while it hasn't fired; once it fires
+ * the ring is handed over, oldest first, ahead of the live stream. */
+class CaptureTrigger {
+   public:
+    /* The ring is sized to the config's pre_trigger_bytes, capped by
+     * max_bytes and halved until it fits in one free block with
+     * heap_reserve bytes to spare. The config is updated with what was
+     * kept. */
+    CaptureTrigger(CaptureTriggerConfig& config, const size_t max_bytes, const size_t heap_reserve = 0);
+
+    CaptureTrigger(const CaptureTrigger&) = delete;
+    CaptureTrigger& operator=(const CaptureTrigger&) = delete;
+
+    bool fired() const { return fired_; }
+
+    /* Adds a block to the on/off history. Returns true on the block that
+     * fires the trigger. */
+    bool evaluate(const buffer_c16_t& block);
+
+    /* Keeps a block that came before the trigger. */
+    void store(const void* const data, const size_t length);
+
+    /* Hands the kept blocks to write(data, length), oldest first. */
+    template <typename Write>
+    void drain(Write write) {
+        if (fill_ == 0)
+            return;
+
+        const auto start = (head_ + capacity_ - fill_) % capacity_;
+        const auto first = std::min(fill_, capacity_ - start);
+        if (first)
+            write(&ring_[start], first);
+        if (fill_ > first)
+            write(&ring_[0], fill_ - first);
+        fill_ = 0;
+    }
+
+    size_t kept() const { return fill_; }
+
+   private:
+    const CaptureTriggerConfig config_;
+    std::unique_ptr<uint8_t[]> ring_{};
+    size_t capacity_{0};
+    size_t head_{0};
+    size_t fill_{0};
+    uint32_t history_{0};
+    size_t blocks_seen_{0};
+    size_t pattern_length_{0};
+    bool fired_{false};
+};
+
+#endif /*__CAPTURE_TRIGGER_H__*/
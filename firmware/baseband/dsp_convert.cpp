@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_convert.hpp"
+
+// The host tests define LPC43XX_M4 too; only real DSP extensions take the packed path.
+#if defined(__ARM_FEATURE_DSP)
+#include "simd.hpp"
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+namespace dsp {
+namespace convert {
+
+namespace {
+
+/* The M4 allows unaligned LDR/STR; memcpy lets the compiler use them. */
+uint32_t load(const void* const p) {
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+void store(void* const p, const uint32_t w) {
+    memcpy(p, &w, sizeof(w));
+}
+
+/* Top bytes of two C16 samples {I0, Q0}, {I1, Q1} as packed {I0, Q0, I1, Q1}. */
+uint32_t top_bytes(const uint32_t w0, const uint32_t w1) {
+#if defined(__ARM_FEATURE_DSP)
+    const uint32_t high = __PKHTB(w1, w0, 16);  // Q1, Q0
+    const uint32_t low = __PKHBT(w0, w1, 16);   // I1, I0
+    return ((low >> 8) & 0x00FF00FFU) | (high & 0xFF00FF00U);
+#else
+    return ((w0 >> 8) & 0x000000FFU) | ((w0 >> 16) & 0x0000FF00U) |
+           ((w1 << 8) & 0x00FF0000U) | (w1 & 0xFF000000U);
+#endif
+}
+
+/* One packed C8 sample in both halves of a word. */
+uint32_t twice(const uint32_t sample) {
+#if defined(__ARM_FEATURE_DSP)
+    return __PKHBT(sample, sample, 16);
+#else
+    return (sample & 0xFFFFU) | (sample << 16);
+#endif
+}
+
+complex8_t narrow(const complex16_t v) {
+    return {static_cast<int8_t>(v.real() >> 8), static_cast<int8_t>(v.imag() >> 8)};
+}
+
+}  // namespace
+
+void c16_to_c8_repeat(const complex16_t* const src, const size_t count, complex8_t* const dst, const size_t repeat) {
+    if (repeat == 1) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            store(&dst[i], top_bytes(load(&src[i]), load(&src[i + 1])));
+            store(&dst[i + 2], top_bytes(load(&src[i + 2]), load(&src[i + 3])));
+        }
+        for (; i < count; i++)
+            dst[i] = narrow(src[i]);
+        return;
+    }
+
+    if (repeat % 2 == 0) {
+        const size_t words = repeat / 2;
+        auto out = dst;
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            const auto pair = top_bytes(load(&src[i]), load(&src[i + 1]));
+            const auto first = twice(pair);
+            const auto second = twice(pair >> 16);
+            for (size_t j = 0; j < words; j++, out += 2)
+                store(out, first);
+            for (size_t j = 0; j < words; j++, out += 2)
+                store(out, second);
+        }
+        if (i < count) {
+            const auto value = narrow(src[i]);
+            for (size_t j = 0; j < repeat; j++)
+                *(out++) = value;
+        }
+        return;
+    }
+
+    // Odd repeat factors don't fill whole words.
+    auto out = dst;
+    for (size_t i = 0; i < count; i++) {
+        const auto value = narrow(src[i]);
+        for (size_t j = 0; j < repeat; j++)
+            *(out++) = value;
+    }
+}
+
+} /* namespace convert */
+} /* namespace dsp */
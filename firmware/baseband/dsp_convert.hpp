@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_CONVERT_H__
+#define __DSP_CONVERT_H__
+
+#include "complex.hpp"
+
+#include <cstddef>
+
+namespace dsp {
+namespace convert {
+
+/* C16 -> C8 keeping the top byte of each lane (arithmetic >> 8), with every
+ * output sample written `repeat` times. Works a word at a time: two source
+ * samples become one packed output word, and even repeat factors are
+ * written as whole words. `dst` must hold count * repeat samples. */
+void c16_to_c8_repeat(const complex16_t* const src, const size_t count, complex8_t* const dst, const size_t repeat);
+
+} /* namespace convert */
+} /* namespace dsp */
+
+#endif /*__DSP_CONVERT_H__*/
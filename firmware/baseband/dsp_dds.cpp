@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_dds.hpp"
+
+#include "sine_table.hpp"
+#include "sine_table_int8.hpp"
+
+namespace dsp {
+
+std::array<int16_t, DDS::table_size + 1> DDS::sine_table;
+bool DDS::table_ready = false;
+
+namespace {
+
+constexpr uint64_t quarter_turn = 1ULL << 62;
+constexpr size_t fraction_bits = 16;
+
+/* xorshift32, only used to decorrelate the phase truncation error. */
+uint32_t next_dither(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+}  // namespace
+
+DDS::DDS() {
+    if (table_ready)
+        return;
+
+    for (size_t i = 0; i <= table_size; i++) {
+        const float w = 2 * pi * i / table_size;
+        sine_table[i] = static_cast<int16_t>(std::lround(sin_f32(w) * amplitude));
+    }
+    table_ready = true;
+}
+
+uint64_t DDS::frequency_word(const int32_t frequency, const uint32_t sampling_rate) {
+    // 2^64 * |f| / fs as two 32-bit long division steps, |f| < fs.
+    const uint64_t magnitude = (frequency < 0) ? -static_cast<int64_t>(frequency) : frequency;
+    const uint64_t numerator = (magnitude % sampling_rate) << 32;
+    const uint64_t high = numerator / sampling_rate;
+    const uint64_t low = ((numerator % sampling_rate) << 32) / sampling_rate;
+    const uint64_t word = (high << 32) | low;
+
+    return (frequency < 0) ? -word : word;
+}
+
+template <DDS::Mode M>
+int8_t DDS::sine(const uint64_t p, const uint32_t dither) const {
+    if (M == Mode::Legacy)
+        return sine_table_i8[p >> 56];
+
+    if (M == Mode::Interpolated) {
+        const size_t index = p >> (64 - table_bits);
+        const int32_t fraction = (p >> (64 - table_bits - fraction_bits)) & ((1 << fraction_bits) - 1);
+        const int32_t s0 = sine_table[index];
+        const int32_t s1 = sine_table[index + 1];
+        const int32_t s = s0 + (((s1 - s0) * fraction) >> fraction_bits);
+        return (s + 128) >> 8;
+    }
+
+    // Table and Dithered: dither spans one table step below the index.
+    const uint64_t dithered = p + (static_cast<uint64_t>(dither) << (64 - table_bits - 32));
+    return (sine_table[dithered >> (64 - table_bits)] + 128) >> 8;
+}
+
+template <DDS::Mode M>
+void DDS::generate_mode(complex8_t* const p, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t dither = (M == Mode::Dithered) ? next_dither(dither_state) : 0;
+        p[i] = {sine<M>(phase + quarter_turn, dither), sine<M>(phase, dither)};
+        phase += phase_inc;
+    }
+}
+
+void DDS::generate(complex8_t* const p, const size_t count) {
+    // One dispatch per block; the sample loops are specialized per mode.
+    switch (mode) {
+        case Mode::Legacy:
+            generate_mode<Mode::Legacy>(p, count);
+            break;
+        case Mode::Table:
+            generate_mode<Mode::Table>(p, count);
+            break;
+        case Mode::Dithered:
+            generate_mode<Mode::Dithered>(p, count);
+            break;
+        default:
+            generate_mode<Mode::Interpolated>(p, count);
+            break;
+    }
+}
+
+} /* namespace dsp */
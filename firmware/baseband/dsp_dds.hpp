@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_DDS_H__
+#define __DSP_DDS_H__
+
+#include "complex.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace dsp {
+
+/* Complex carrier generator with a 64-bit phase accumulator. One LSB of
+ * the frequency word is sampling_rate / 2^64, well below 1 uHz. */
+class DDS {
+   public:
+    enum class Mode : uint8_t {
+        Legacy = 0,        // Top 8 phase bits into sine_table_i8.
+        Table = 1,         // Top 10 phase bits into a Q15 table.
+        Interpolated = 2,  // Q15 table, linear interpolation on the next 16 bits.
+        Dithered = 3,      // Q15 table, phase dithered below the table step.
+    };
+
+    DDS();
+
+    /* Negative frequencies wrap to the upper half of the accumulator. */
+    static uint64_t frequency_word(const int32_t frequency, const uint32_t sampling_rate);
+
+    void set_mode(const Mode new_mode) { mode = new_mode; }
+    void set_frequency_word(const uint64_t word) { phase_inc = word; }
+    void set_phase(const uint64_t new_phase) { phase = new_phase; }
+
+    /* Writes {cos, sin} of the running phase, amplitude 127. */
+    void generate(complex8_t* const p, const size_t count);
+
+   private:
+    static constexpr size_t table_bits = 10;
+    static constexpr size_t table_size = 1 << table_bits;
+    static constexpr int16_t amplitude = 127 * 256;  // Rounds to at most 127.
+
+    /* One extra entry so that interpolation never wraps the index. */
+    static std::array<int16_t, table_size + 1> sine_table;
+    static bool table_ready;
+
+    Mode mode{Mode::Interpolated};
+    uint64_t phase{0};
+    uint64_t phase_inc{0};
+    uint32_t dither_state{0x2545F491};
+
+    template <Mode M>
+    int8_t sine(const uint64_t p, const uint32_t dither) const;
+
+    template <Mode M>
+    void generate_mode(complex8_t* const p, const size_t count);
+};
+
+} /* namespace dsp */
+
+#endif /*__DSP_DDS_H__*/
@@ -27,9 +27,53 @@
 
 #include <hal.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 namespace dsp {
 namespace demodulate {
 
+namespace {
+
+using sample_pair_t = complex16_t::rep_type;
+
+/* cur * conj(prev), saturated to 32 bits. */
+inline complex32_t conjugate_product(const sample_pair_t cur, const sample_pair_t prev) {
+#if defined(__ARM_FEATURE_DSP)
+    return multiply_conjugate_s16_s32(cur, prev);
+#else
+    const int64_t ar = static_cast<int16_t>(cur);
+    const int64_t ai = static_cast<int16_t>(cur >> 16);
+    const int64_t br = static_cast<int16_t>(prev);
+    const int64_t bi = static_cast<int16_t>(prev >> 16);
+    const auto saturate = [](const int64_t v) {
+        return static_cast<int32_t>(std::max<int64_t>(INT32_MIN, std::min<int64_t>(INT32_MAX, v)));
+    };
+    return {saturate(ar * br + ai * bi), saturate(ai * br - ar * bi)};
+#endif
+}
+
+inline float magnitude_squared(const sample_pair_t v) {
+#if defined(__ARM_FEATURE_DSP)
+    return static_cast<uint32_t>(__SMUAD(v, v));
+#else
+    const int32_t r = static_cast<int16_t>(v);
+    const int32_t i = static_cast<int16_t>(v >> 16);
+    return static_cast<uint32_t>(r * r) + static_cast<uint32_t>(i * i);
+#endif
+}
+
+inline int16_t saturate_s16(const int32_t v) {
+#if defined(__ARM_FEATURE_DSP)
+    return __SSAT(v, 16);
+#else
+    return std::max<int32_t>(INT16_MIN, std::min<int32_t>(INT16_MAX, v));
+#endif
+}
+
+}  // namespace
+
 buffer_f32_t AM::execute(
     const buffer_c16_t& src,
     const buffer_f32_t& dst) {
@@ -39,10 +83,8 @@ buffer_f32_t AM::execute(
     while (src_p < src_end) {
         const uint32_t sample0 = *__SIMD32(src_p)++;
         const uint32_t sample1 = *__SIMD32(src_p)++;
-        const uint32_t mag_sq0 = __SMUAD(sample0, sample0);
-        const uint32_t mag_sq1 = __SMUAD(sample1, sample1);
-        *(dst_p++) = __builtin_sqrtf(mag_sq0) * k;
-        *(dst_p++) = __builtin_sqrtf(mag_sq1) * k;
+        *(dst_p++) = __builtin_sqrtf(magnitude_squared(sample0)) * k;
+        *(dst_p++) = __builtin_sqrtf(magnitude_squared(sample1)) * k;
     }
 
     return {dst.p, src.count, src.sampling_rate};
@@ -63,82 +105,184 @@ buffer_f32_t SSB::execute(
 
     return {dst.p, src.count, src.sampling_rate};
 }
-/*
-static inline float angle_approx_4deg0(const complex32_t t) {
-        const auto x = static_cast<float>(t.imag()) / static_cast<float>(t.real());
-        return 16384.0f * x;
-}
-*/
-static inline float angle_approx_0deg27(const complex32_t t) {
-    if (t.real()) {
-        const auto x = static_cast<float>(t.imag()) / static_cast<float>(t.real());
-        return x / (1.0f + 0.28086f * x * x);
-    } else {
-        return (t.imag() < 0) ? -1.5707963268f : 1.5707963268f;
+
+namespace {
+
+/* Angles in the integer discriminators count 1/65536ths of a turn. */
+constexpr float radians_per_turn16 = 2 * pi / 65536;
+
+/* atan(x) for x in [0, 1], by Euler's series, built at compile time. */
+constexpr double arctangent(const double x) {
+    const double x2 = x * x;
+    double term = x / (1 + x2);
+    double sum = 0;
+    for (int n = 1; n < 60; n++) {
+        sum += term;
+        term *= (2.0 * n) / (2 * n + 1) * x2 / (1 + x2);
     }
+    return sum;
 }
 
-static inline float angle_precise(const complex32_t t) {
+constexpr size_t atan_table_bits = 8;
+constexpr size_t atan_table_size = 1 << atan_table_bits;
+
+/* atan(k / 256) in turn16 units for k in [0, 256], plus a guard entry for
+ * the interpolation at k = 256. */
+constexpr std::array<uint16_t, atan_table_size + 2> make_atan_table() {
+    std::array<uint16_t, atan_table_size + 2> table{};
+    for (size_t k = 0; k <= atan_table_size; k++)
+        table[k] = static_cast<uint16_t>(arctangent(static_cast<double>(k) / atan_table_size) * 65536 / (2 * 3.14159265358979323846) + 0.5);
+    table[atan_table_size + 1] = table[atan_table_size];
+    return table;
+}
+
+constexpr auto atan_table = make_atan_table();
+
+inline uint32_t absolute(const int32_t v) {
+    return (v < 0) ? -static_cast<uint32_t>(v) : v;
+}
+
+/* Right shift that brings larger down to at most width bits. */
+inline uint32_t normalize_shift(const uint32_t larger, const uint32_t width) {
+    const uint32_t bits = 32 - __builtin_clz(larger | 1);
+    return (bits > width) ? bits - width : 0;
+}
+
+int32_t angle_table(const complex32_t t) {
+    const uint32_t ax = absolute(t.real());
+    const uint32_t ay = absolute(t.imag());
+    const bool steep = ay > ax;
+    const uint32_t larger = steep ? ay : ax;
+    if (larger == 0)
+        return 0;
+
+    const uint32_t shift = normalize_shift(larger, 16);
+    const uint32_t ratio = (((steep ? ax : ay) >> shift) << 16) / (larger >> shift);  // Q16, <= 1.0
+
+    const uint32_t index = ratio >> (16 - atan_table_bits);
+    const uint32_t fraction = ratio & ((1 << (16 - atan_table_bits)) - 1);
+    const int32_t a0 = atan_table[index];
+    const int32_t a1 = atan_table[index + 1];
+    int32_t angle = a0 + (((a1 - a0) * static_cast<int32_t>(fraction)) >> (16 - atan_table_bits));
+
+    if (steep) angle = 16384 - angle;
+    if (t.real() < 0) angle = 32768 - angle;
+    return (t.imag() < 0) ? -angle : angle;
+}
+
+int32_t angle_polynomial(const complex32_t t) {
+    const uint32_t shift = normalize_shift(std::max(absolute(t.real()), absolute(t.imag())), 15);
+    const auto x = static_cast<int16_t>(t.real() >> shift);
+    const auto y = static_cast<int16_t>(t.imag() >> shift);
+    return static_cast<int16_t>(fxpt_atan2(y, x));
+}
+
+/* Phase step from prev to cur in the discriminator's own units. */
+template <FM::Discriminator D>
+float phase_step(const sample_pair_t cur, const sample_pair_t prev);
+
+template <>
+inline float phase_step<FM::Discriminator::Precise>(const sample_pair_t cur, const sample_pair_t prev) {
+    const auto t = conjugate_product(cur, prev);
     return atan2f(t.imag(), t.real());
 }
 
-buffer_f32_t FM::execute(
-    const buffer_c16_t& src,
-    const buffer_f32_t& dst) {
+template <>
+inline float phase_step<FM::Discriminator::Table>(const sample_pair_t cur, const sample_pair_t prev) {
+    return angle_table(conjugate_product(cur, prev));
+}
+
+template <>
+inline float phase_step<FM::Discriminator::Polynomial>(const sample_pair_t cur, const sample_pair_t prev) {
+    return angle_polynomial(conjugate_product(cur, prev));
+}
+
+template <>
+inline float phase_step<FM::Discriminator::Quadrature>(const sample_pair_t cur, const sample_pair_t prev) {
+    const auto t = conjugate_product(cur, prev);
+    const float power = magnitude_squared(cur) + magnitude_squared(prev);
+    return (power > 0) ? 2.0f * t.imag() / power : 0.0f;
+}
+
+constexpr float radians_per_unit(const FM::Discriminator discriminator) {
+    return ((discriminator == FM::Discriminator::Table) || (discriminator == FM::Discriminator::Polynomial))
+               ? radians_per_turn16
+               : 1.0f;
+}
+
+inline void store(float* const p, const float v) {
+    *p = v;
+}
+
+inline void store(int16_t* const p, const float v) {
+    *p = saturate_s16(static_cast<int32_t>(v));
+}
+
+/* Two samples per iteration, each pair loaded as one word. */
+template <FM::Discriminator D, typename T>
+void discriminate(const buffer_c16_t& src, T* dst_p, sample_pair_t& z_, const float k) {
     auto z = z_;
 
-    const void* src_p = src.p;
-    const auto src_end = &src.p[src.count];
-    auto dst_p = dst.p;
+    const auto* src_p = reinterpret_cast<const sample_pair_t*>(src.p);
+    const auto src_end = src_p + src.count;
     while (src_p < src_end) {
-        const auto s0 = *__SIMD32(src_p)++;
-        const auto s1 = *__SIMD32(src_p)++;
-        const auto t0 = multiply_conjugate_s16_s32(s0, z);
-        const auto t1 = multiply_conjugate_s16_s32(s1, s0);
+        const auto s0 = *(src_p++);
+        const auto s1 = *(src_p++);
+        store(dst_p++, phase_step<D>(s0, z) * k);
+        store(dst_p++, phase_step<D>(s1, s0) * k);
         z = s1;
-        *(dst_p++) = angle_precise(t0) * kf;
-        *(dst_p++) = angle_precise(t1) * kf;
     }
+
     z_ = z;
+}
+
+template <typename T>
+void discriminate(const FM::Discriminator discriminator, const buffer_c16_t& src, T* const dst, sample_pair_t& z, const float k) {
+    switch (discriminator) {
+        case FM::Discriminator::Precise:
+            discriminate<FM::Discriminator::Precise>(src, dst, z, k);
+            break;
+
+        default:
+        case FM::Discriminator::Table:
+            discriminate<FM::Discriminator::Table>(src, dst, z, k);
+            break;
 
+        case FM::Discriminator::Polynomial:
+            discriminate<FM::Discriminator::Polynomial>(src, dst, z, k);
+            break;
+
+        case FM::Discriminator::Quadrature:
+            discriminate<FM::Discriminator::Quadrature>(src, dst, z, k);
+            break;
+    }
+}
+
+}  // namespace
+
+buffer_f32_t FM::execute(
+    const buffer_c16_t& src,
+    const buffer_f32_t& dst) {
+    discriminate(discriminator_, src, dst.p, z_, kf);
     return {dst.p, src.count, src.sampling_rate};
 }
 
 buffer_s16_t FM::execute(
     const buffer_c16_t& src,
     const buffer_s16_t& dst) {
-    auto z = z_;
-
-    const void* src_p = src.p;
-    const auto src_end = &src.p[src.count];
-    void* dst_p = dst.p;
-    while (src_p < src_end) {
-        const auto s0 = *__SIMD32(src_p)++;
-        const auto s1 = *__SIMD32(src_p)++;
-        const auto t0 = multiply_conjugate_s16_s32(s0, z);
-        const auto t1 = multiply_conjugate_s16_s32(s1, s0);
-        z = s1;
-        const int32_t theta0_int = angle_approx_0deg27(t0) * ks16;
-        const int32_t theta0_sat = __SSAT(theta0_int, 16);
-        const int32_t theta1_int = angle_approx_0deg27(t1) * ks16;
-        const int32_t theta1_sat = __SSAT(theta1_int, 16);
-        *__SIMD32(dst_p)++ = __PKHBT(
-            theta0_sat,
-            theta1_sat,
-            16);
-    }
-    z_ = z;
-
+    discriminate(discriminator_, src, dst.p, z_, ks16);
     return {dst.p, src.count, src.sampling_rate};
 }
 
-void FM::configure(const float sampling_rate, const float deviation_hz) {
+void FM::configure(const float sampling_rate, const float deviation_hz, const Discriminator discriminator) {
     /*
      * angle: -pi to pi. output range: -32768 to 32767.
      * Maximum delta-theta (output of atan2) at maximum deviation frequency:
      * delta_theta_max = 2 * pi * deviation / sampling_rate
+     * The factors also fold in each discriminator's angle units.
      */
-    kf = static_cast<float>(1.0f / (2.0 * pi * deviation_hz / sampling_rate));
+    discriminator_ = discriminator;
+    kf = static_cast<float>(radians_per_unit(discriminator) / (2.0 * pi * deviation_hz / sampling_rate));
     ks16 = 32767.0f * kf;
 }
 
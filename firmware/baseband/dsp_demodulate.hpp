@@ -49,6 +49,23 @@ class SSB {
 
 class FM {
    public:
+    /* Ways of turning the phase step between samples into frequency, most
+     * accurate first. Measured on the host, SNR of a full deviation tone:
+     *   Precise     atan2f, the reference.
+     *   Table       Octant folded 256 entry arctangent table with linear
+     *               interpolation; ~80 dB.
+     *   Polynomial  fxpt_atan2's octant folded second order polynomial;
+     *               ~50 dB, fine for voice.
+     *   Quadrature  No arctangent: the cross product over the mean power
+     *               gives sin() of the step. Only fit for steps well
+     *               below a radian, i.e. oversampled narrow deviation. */
+    enum class Discriminator : uint8_t {
+        Precise,
+        Table,
+        Polynomial,
+        Quadrature,
+    };
+
     buffer_f32_t execute(
         const buffer_c16_t& src,
         const buffer_f32_t& dst);
@@ -57,12 +74,16 @@ class FM {
         const buffer_c16_t& src,
         const buffer_s16_t& dst);
 
-    void configure(const float sampling_rate, const float deviation_hz);
+    void configure(
+        const float sampling_rate,
+        const float deviation_hz,
+        const Discriminator discriminator = Discriminator::Table);
 
    private:
     complex16_t::rep_type z_{0};
     float kf{0};
     float ks16{0};
+    Discriminator discriminator_{Discriminator::Table};
 };
 
 } /* namespace demodulate */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_mixer.hpp"
+
+#include "sine_table.hpp"
+
+// The host tests define LPC43XX_M4 too; only real DSP extensions take the packed path.
+#if defined(__ARM_FEATURE_DSP)
+#include "simd.hpp"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace dsp {
+
+Mixer::Mixer() {
+    set_gain(0, false);
+}
+
+void Mixer::set_frequency(const int32_t frequency, const uint32_t sampling_rate) {
+    if (sampling_rate == 0)
+        return;
+
+    const int64_t limit = sampling_rate / 2;
+    const int64_t f = std::clamp<int64_t>(frequency, -limit, limit);
+    phase_inc = static_cast<uint32_t>((f << 32) / static_cast<int64_t>(sampling_rate));
+}
+
+float Mixer::gain_from_db(const int32_t gain_db) {
+    // Whole dB steps; avoids pulling powf into the image.
+    constexpr float one_db = 1.12201845f;
+    float gain = 1.0f;
+    for (int32_t i = 0; i < std::abs(gain_db); i++)
+        gain = (gain_db > 0) ? gain * one_db : gain / one_db;
+    return gain;
+}
+
+int8_t Mixer::clip(const int32_t v, const bool soft) {
+    const int32_t magnitude = std::abs(v);
+    int32_t out = std::min<int32_t>(magnitude, 127);
+
+    if (soft && magnitude > soft_clip_knee) {
+        // u / (1 + u) above the knee: continuous slope, approaches full scale.
+        constexpr float span = 127 - soft_clip_knee;
+        const float u = (magnitude - soft_clip_knee) / span;
+        out = soft_clip_knee + std::lround(span * u / (1.0f + u));
+    }
+
+    return static_cast<int8_t>((v < 0) ? -out : out);
+}
+
+void Mixer::set_gain(const int32_t gain_db, const bool soft_clip) {
+    gain_db_ = std::clamp(gain_db, gain_db_min, gain_db_max);
+
+    const float amplitude = gain_from_db(gain_db_) * (1 << product_shift);
+    for (size_t i = 0; i < phasor_table.size(); i++) {
+        const float w = 2 * pi * i / phasor_table.size();
+        const auto c = static_cast<int16_t>(std::lround(sin_f32(w + pi / 2) * amplitude));
+        const auto s = static_cast<int16_t>(std::lround(sin_f32(w) * amplitude));
+        phasor_table[i] = static_cast<uint16_t>(c) | (static_cast<uint32_t>(static_cast<uint16_t>(s)) << 16);
+    }
+
+    for (int32_t v = -clip_range; v < clip_range; v++)
+        clip_table[v + clip_range] = clip(v, soft_clip);
+}
+
+int8_t Mixer::lookup(const int32_t v) const {
+#if defined(__ARM_FEATURE_DSP)
+    return clip_table[__SSAT(v >> product_shift, 11) + clip_range];
+#else
+    return clip_table[std::clamp(v >> product_shift, -clip_range, clip_range - 1) + clip_range];
+#endif
+}
+
+void Mixer::operator()(complex8_t* const p, const size_t count) {
+    constexpr int32_t round = 1 << (product_shift - 1);
+
+#if defined(__ARM_FEATURE_DSP)
+    // Two samples per word: I0 Q0 I1 Q1.
+    auto words = reinterpret_cast<vec4_s8*>(p);
+    for (size_t i = 0; i < count / 2; i++) {
+        const auto even = sxtb16(words[i], 0);  // I0, I1
+        const auto odd = sxtb16(words[i], 8);   // Q0, Q1
+        const auto s0 = pkhbt(even, odd, 16);   // I0, Q0
+        const auto s1 = pkhtb(odd, even, 16);   // I1, Q1
+
+        vec2_s16 p0, p1;
+        p0.w = phasor_table[phase >> (32 - table_bits)];
+        phase += phase_inc;
+        p1.w = phasor_table[phase >> (32 - table_bits)];
+        phase += phase_inc;
+
+        vec4_s8 out;
+        out.v[0] = lookup(smlsd(s0, p0, round));
+        out.v[1] = lookup(smladx(s0, p0, round));
+        out.v[2] = lookup(smlsd(s1, p1, round));
+        out.v[3] = lookup(smladx(s1, p1, round));
+        words[i] = out;
+    }
+    const size_t done = count & ~size_t(1);
+#else
+    const size_t done = 0;
+#endif
+
+    for (size_t i = done; i < count; i++) {
+        const uint32_t phasor = phasor_table[phase >> (32 - table_bits)];
+        const int32_t c = static_cast<int16_t>(phasor & 0xffff);
+        const int32_t s = static_cast<int16_t>(phasor >> 16);
+        const int32_t re = p[i].real();
+        const int32_t im = p[i].imag();
+
+        p[i] = {lookup(re * c - im * s + round), lookup(re * s + im * c + round)};
+        phase += phase_inc;
+    }
+}
+
+} /* namespace dsp */
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_MIXER_H__
+#define __DSP_MIXER_H__
+
+#include "complex.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace dsp {
+
+/* Frequency shift, digital gain and clipping for int8 IQ, in place. The
+ * gain is folded into the NCO phasor table, so the whole stage costs one
+ * complex multiply and two table lookups per sample. */
+class Mixer {
+   public:
+    static constexpr int32_t gain_db_min = -30;
+    static constexpr int32_t gain_db_max = 20;
+
+    Mixer();
+
+    /* |frequency| up to sampling_rate / 2. */
+    void set_frequency(const int32_t frequency, const uint32_t sampling_rate);
+    void set_gain(const int32_t gain_db, const bool soft_clip);
+
+    /* Unity gain at 0 Hz leaves the samples untouched. */
+    bool bypass() const { return phase_inc == 0 && gain_db_ == 0; }
+
+    void operator()(complex8_t* const p, const size_t count);
+
+   private:
+    static constexpr size_t table_bits = 10;
+    static constexpr size_t product_shift = 11;
+    static constexpr int32_t clip_range = 1 << 10;  // Products saturate here.
+    static constexpr int32_t soft_clip_knee = 64;   // About -6 dBFS.
+
+    /* {cos, sin} * gain packed as Q11 int16 pairs, I in the low half. */
+    std::array<uint32_t, 1 << table_bits> phasor_table{};
+    std::array<int8_t, 2 * clip_range> clip_table{};
+
+    uint32_t phase{0};
+    uint32_t phase_inc{0};
+    int32_t gain_db_{0};
+
+    static float gain_from_db(const int32_t gain_db);
+    static int8_t clip(const int32_t v, const bool soft);
+
+    int8_t lookup(const int32_t v) const;
+};
+
+} /* namespace dsp */
+
+#endif /*__DSP_MIXER_H__*/
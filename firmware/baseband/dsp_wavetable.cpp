@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_wavetable.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dsp {
+
+namespace {
+
+/* Table position of a phase: entry index and a Q16 fraction. */
+struct Position {
+    size_t index;
+    size_t next;
+    int32_t fraction;
+};
+
+Position position(const uint32_t phase, const size_t length) {
+    const uint64_t p = static_cast<uint64_t>(phase) * length;
+    const size_t index = p >> 32;
+    return {index, (index + 1 == length) ? 0 : index + 1, static_cast<int32_t>((p >> 16) & 0xFFFF)};
+}
+
+int8_t interpolate(const int32_t s0, const int32_t s1, const int32_t fraction) {
+    return s0 + (((s1 - s0) * fraction) >> 16);
+}
+
+}  // namespace
+
+bool WaveTable::allocate(const AWGFormat format, const size_t length) {
+    clear();
+
+    const size_t bytes = length * ((format == AWGFormat::IQ) ? 2 : 1);
+    if (length == 0 || bytes > awg_table_max_bytes)
+        return false;
+
+    data_ = std::make_unique<int8_t[]>(bytes);
+    format_ = format;
+    length_ = length;
+    bytes_ = bytes;
+    return true;
+}
+
+void WaveTable::clear() {
+    data_.reset();
+    length_ = 0;
+    bytes_ = 0;
+    bytes_written_ = 0;
+}
+
+void WaveTable::write(const size_t offset, const uint8_t* const data, const size_t size) {
+    if (!data_ || offset >= bytes_)
+        return;
+
+    const auto n = std::min(size, bytes_ - offset);
+    memcpy(&data_[offset], data, n);
+    bytes_written_ += n;
+}
+
+int8_t WaveTable::real_at(const uint32_t phase) const {
+    const auto p = position(phase, length_);
+    const auto s = stride();
+    return interpolate(data_[p.index * s], data_[p.next * s], p.fraction);
+}
+
+complex8_t WaveTable::iq_at(const uint32_t phase) const {
+    const auto p = position(phase, length_);
+    const auto i0 = p.index * 2;
+    const auto i1 = p.next * 2;
+    return {
+        interpolate(data_[i0], data_[i1], p.fraction),
+        interpolate(data_[i0 + 1], data_[i1 + 1], p.fraction)};
+}
+
+} /* namespace dsp */
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_WAVETABLE_H__
+#define __DSP_WAVETABLE_H__
+
+#include "complex.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace dsp {
+
+/* One period of a user waveform held in baseband RAM. Samples are looked
+ * up by a 32-bit phase spanning the whole table, with linear
+ * interpolation between entries, so the playback rate is set by the
+ * phase increment alone. */
+class WaveTable {
+   public:
+    /* Drops the previous table. Returns false if the size is not allowed. */
+    bool allocate(const AWGFormat format, const size_t length);
+    void clear();
+
+    /* Copies table bytes in; ignores anything past the end. */
+    void write(const size_t offset, const uint8_t* const data, const size_t size);
+
+    /* True once every byte of the table has been written. */
+    bool complete() const { return data_ && bytes_written_ == bytes_; }
+
+    AWGFormat format() const { return format_; }
+    size_t length() const { return length_; }
+
+    /* For IQ tables this is the I channel. */
+    int8_t real_at(const uint32_t phase) const;
+    /* IQ tables only. */
+    complex8_t iq_at(const uint32_t phase) const;
+
+   private:
+    std::unique_ptr<int8_t[]> data_{};
+    AWGFormat format_{AWGFormat::Real};
+    size_t length_{0};
+    size_t bytes_{0};
+    size_t bytes_written_{0};
+
+    size_t stride() const { return (format_ == AWGFormat::IQ) ? 2 : 1; }
+};
+
+} /* namespace dsp */
+
+#endif /*__DSP_WAVETABLE_H__*/
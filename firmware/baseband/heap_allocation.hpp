@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __HEAP_ALLOCATION_H__
+#define __HEAP_ALLOCATION_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+
+/* Allocation for buffers that can be made smaller when memory is short.
+ *
+ * chHeapStatus() reports the sum of all free fragments, which says nothing
+ * about whether a block of that size exists, and operator new panics when
+ * it doesn't. These try the allocation itself and return nullptr instead. */
+
+/* Like std::make_unique<T[]>(count), or nullptr if no block is free. */
+template <typename T>
+std::unique_ptr<T[]> try_make_unique(const size_t count) {
+    return std::unique_ptr<T[]>{new (std::nothrow) T[count]()};
+}
+
+/* Holds bytes of heap for its lifetime, so that allocations made
+ * meanwhile leave at least that much allocatable in one block. */
+class HeapReserve {
+   public:
+    explicit HeapReserve(const size_t bytes)
+        : block_{new (std::nothrow) uint8_t[bytes]} {
+    }
+
+   private:
+    std::unique_ptr<uint8_t[]> block_;
+};
+
+/* Uninitialised units * unit_size + slack bytes, halving units until the
+ * block fits with reserve bytes to spare. units is updated, to 0 if not
+ * even one unit fits. */
+inline std::unique_ptr<uint8_t[]> allocate_fitting(size_t& units, const size_t unit_size, const size_t reserve, const size_t slack = 0) {
+    const HeapReserve held{reserve};
+
+    for (; units > 0; units >>= 1) {
+        if (unit_size && (units > (std::numeric_limits<size_t>::max() - slack) / unit_size))
+            continue;
+
+        std::unique_ptr<uint8_t[]> block{new (std::nothrow) uint8_t[units * unit_size + slack]};
+        if (block)
+            return block;
+    }
+
+    return {};
+}
+
+#endif /*__HEAP_ALLOCATION_H__*/
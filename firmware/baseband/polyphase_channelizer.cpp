@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "polyphase_channelizer.hpp"
+
+#include "dsp_fft.hpp"
+#include "sine_table.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+namespace decimate {
+
+namespace {
+
+int16_t saturate_i16(const int32_t v) {
+    return std::max<int32_t>(-32768, std::min<int32_t>(32767, v));
+}
+
+float prototype(const size_t n, const size_t length, const size_t channels) {
+    // Cutoff in cycles per input sample: halfway to the next channel.
+    const float cutoff = 0.5f / channels;
+    const float t = n - (length - 1) / 2.0f;
+    const float x = 2 * pi * cutoff * t;
+    const float sinc = (t == 0) ? 1.0f : sin_f32(x) / x;
+    const float window = 0.54f - 0.46f * sin_f32(2 * pi * n / (length - 1) + pi / 2);  // Hamming
+    return sinc * window;
+}
+
+}  // namespace
+
+void PolyphaseChannelizer::configure(const size_t channels) {
+    channels_ = channels;
+
+    const size_t length = channels * taps_per_branch;
+
+    float sum = 0;
+    for (size_t n = 0; n < length; n++)
+        sum += prototype(n, length, channels);
+
+    // Scaled so that each branch sums to about unity; the transform divides by M.
+    const float scale = channels * 32767.0f / sum;
+    for (size_t n = 0; n < length; n++) {
+        const auto h = std::lround(prototype(n, length, channels) * scale);
+        taps_[n / channels][n % channels] = saturate_i16(h);
+    }
+
+    const size_t bits = log_2(channels);
+    for (size_t c = 0; c < channels; c++) {
+        const size_t k = (c + channels / 2) & (channels - 1);
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; b++)
+            reversed |= ((k >> b) & 1) << (bits - 1 - b);
+        order[c] = reversed;
+    }
+
+    reset();
+}
+
+void PolyphaseChannelizer::reset() {
+    for (auto& row : history)
+        row.fill({0, 0});
+    newest = 0;
+}
+
+void PolyphaseChannelizer::push(const complex16_t* const block) {
+    newest = (newest + 1) % taps_per_branch;
+
+    auto& row = history[newest];
+    for (size_t r = 0; r < channels_; r++)
+        row[r] = block[channels_ - 1 - r];
+}
+
+void PolyphaseChannelizer::filter() {
+    std::array<const complex16_t*, taps_per_branch> rows;
+    for (size_t p = 0; p < taps_per_branch; p++)
+        rows[p] = history[(newest + taps_per_branch - p) % taps_per_branch].data();
+
+    for (size_t r = 0; r < channels_; r++) {
+        int32_t acc_re = 0;
+        int32_t acc_im = 0;
+        for (size_t p = 0; p < taps_per_branch; p++) {
+            const int32_t h = taps_[p][r];
+            const auto x = rows[p][r];
+            acc_re += h * x.real();
+            acc_im += h * x.imag();
+        }
+
+        // Branch r feeds transform input -r, which turns the forward
+        // transform into the sum over e^(+j 2 pi k r / M) the bank needs.
+        bins[(channels_ - r) & (channels_ - 1)] = {
+            saturate_i16((acc_re + (1 << 14)) >> 15),
+            saturate_i16((acc_im + (1 << 14)) >> 15)};
+    }
+
+    fft::passes(bins.data(), channels_, 0, fft::pass_count(channels_));
+}
+
+buffer_c16_t PolyphaseChannelizer::execute(
+    const buffer_c16_t& src,
+    const buffer_c16_t& dst) {
+    const size_t frames = src.count / channels_;
+
+    for (size_t f = 0; f < frames; f++) {
+        push(&src.p[f * channels_]);
+        filter();
+
+        for (size_t c = 0; c < channels_; c++)
+            dst.p[c * frames + f] = bins[order[c]];
+    }
+
+    return {
+        dst.p,
+        frames * channels_,
+        src.sampling_rate / static_cast<uint32_t>(channels_),
+        src.timestamp};
+}
+
+} /* namespace decimate */
+} /* namespace dsp */
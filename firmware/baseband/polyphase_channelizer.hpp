@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __POLYPHASE_CHANNELIZER_H__
+#define __POLYPHASE_CHANNELIZER_H__
+
+#include "dsp_types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace dsp {
+namespace decimate {
+
+/* Critically sampled analysis filter bank. Splits a complex stream into
+ * M channels fs / M apart, each decimated by M, for the cost of one
+ * eight tap branch filter per input sample plus an M point transform per
+ * M samples. The prototype is a Hamming windowed sinc whose -6 dB edge
+ * sits halfway between channel centres, so neighbouring channels cross
+ * over there and a signal centred in one channel is down more than 50 dB
+ * in the next.
+ *
+ * Channels come out in frequency order: channel c is centred on
+ * (c - M / 2) * fs / M, so channel M / 2 is the one on DC. */
+class PolyphaseChannelizer {
+   public:
+    static constexpr size_t min_channels = 4;
+    static constexpr size_t max_channels = 32;
+    static constexpr size_t taps_per_branch = 8;
+
+    /* channels must be a power of two from min_channels to max_channels. */
+    void configure(const size_t channels);
+    void reset();
+
+    size_t channels() const { return channels_; }
+
+    /* src.count must be a multiple of channels(). Writes channels()
+     * streams of src.count / channels() samples each, one after the other,
+     * into dst, which must hold src.count samples and must not overlap
+     * src. Use channel() to pick one stream out of the result. */
+    buffer_c16_t execute(
+        const buffer_c16_t& src,
+        const buffer_c16_t& dst);
+
+    buffer_c16_t channel(const buffer_c16_t& out, const size_t c) const {
+        const size_t count = out.count / channels_;
+        return {out.p + c * count, count, out.sampling_rate, out.timestamp};
+    }
+
+   private:
+    size_t channels_{0};
+
+    /* Prototype regrouped per tap: taps_[p][r] = h[p * M + r], Q15 with
+     * each branch summing to about unity gain. */
+    std::array<std::array<int16_t, max_channels>, taps_per_branch> taps_{};
+
+    /* The last taps_per_branch input blocks, each stored newest sample
+     * first so that branch r reads column r of every row. */
+    std::array<std::array<complex16_t, max_channels>, taps_per_branch> history{};
+    size_t newest{0};
+
+    /* Where each channel lands in the bit reversed transform output. */
+    std::array<uint8_t, max_channels> order{};
+
+    std::array<complex16_t, max_channels> bins{};
+
+    void push(const complex16_t* const block);
+    void filter();
+};
+
+} /* namespace decimate */
+} /* namespace dsp */
+
+#endif /*__POLYPHASE_CHANNELIZER_H__*/
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "polyphase_resampler.hpp"
+
+#include "sine_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+namespace interpolation {
+
+namespace {
+
+/* Passband edge as a fraction of the lower rate's Nyquist frequency. */
+constexpr float passband = 0.9f;
+
+int8_t saturate_i8(const int32_t v) {
+    return std::max<int32_t>(-128, std::min<int32_t>(127, v));
+}
+
+}  // namespace
+
+void PolyphaseResampler::configure(const uint32_t input_rate, const uint32_t output_rate) {
+    step = (static_cast<uint64_t>(input_rate) << 32) / output_rate;
+
+    // Cutoff in cycles per input sample, then per prototype (upsampled) sample.
+    const float ratio = std::min(1.0f, static_cast<float>(output_rate) / input_rate);
+    const float cutoff = 0.5f * passband * ratio / phases;
+
+    constexpr size_t length = phases * taps_per_phase;
+    constexpr float center = (length - 1) / 2.0f;
+
+    prototype_.low_frequency_normalized = -cutoff;
+    prototype_.high_frequency_normalized = cutoff;
+    prototype_.transition_normalized = (1.0f - passband) * ratio / (2 * phases);
+
+    for (size_t n = 0; n < length; n++) {
+        const float t = n - center;
+        const float x = 2 * pi * cutoff * t;
+        const float sinc = (t == 0) ? 1.0f : sin_f32(x) / x;
+        const float window = 0.42f - 0.5f * sin_f32(2 * pi * n / (length - 1) + pi / 2) +
+                             0.08f * sin_f32(4 * pi * n / (length - 1) + pi / 2);  // Blackman
+
+        // Each branch sums to about unity gain.
+        const float h = 2 * cutoff * sinc * window * phases;
+        prototype_.taps[n] = static_cast<int16_t>(std::lround(h * 32767.0f));
+    }
+
+    for (size_t b = 0; b < phases; b++) {
+        for (size_t k = 0; k < taps_per_phase; k++)
+            branches[b][taps_per_phase - 1 - k] = prototype_.taps[k * phases + b];
+    }
+
+    reset();
+}
+
+void PolyphaseResampler::reset() {
+    history_i.fill(0);
+    history_q.fill(0);
+    history_index = 0;
+    phase = 0;
+    advance = 0;
+}
+
+void PolyphaseResampler::push(const complex8_t sample) {
+    history_i[history_index] = history_i[history_index + taps_per_phase] = sample.real();
+    history_q[history_index] = history_q[history_index + taps_per_phase] = sample.imag();
+    history_index = (history_index + 1) % taps_per_phase;
+}
+
+complex8_t PolyphaseResampler::filter(const size_t branch) const {
+    // history_index is the oldest sample of the window.
+    const auto* const x_i = &history_i[history_index];
+    const auto* const x_q = &history_q[history_index];
+    const auto& h = branches[branch];
+
+    int32_t acc_i = 0;
+    int32_t acc_q = 0;
+    for (size_t k = 0; k < taps_per_phase; k++) {
+        acc_i += x_i[k] * h[k];
+        acc_q += x_q[k] * h[k];
+    }
+
+    return {saturate_i8((acc_i + (1 << 14)) >> 15), saturate_i8((acc_q + (1 << 14)) >> 15)};
+}
+
+PolyphaseResampler::Result PolyphaseResampler::operator()(
+    const complex8_t* const in,
+    const size_t in_count,
+    complex8_t* const out,
+    const size_t out_count) {
+    Result result{0, 0};
+
+    if (bypass()) {
+        const auto n = std::min(in_count, out_count);
+        std::copy(in, in + n, out);
+        return {n, n};
+    }
+
+    while (result.produced < out_count) {
+        for (; advance > 0; advance--) {
+            if (result.consumed == in_count)
+                return result;
+            push(in[result.consumed++]);
+        }
+
+        out[result.produced++] = filter(phase >> (32 - phase_bits));
+
+        const uint32_t next_phase = phase + static_cast<uint32_t>(step);
+        advance = (step >> 32) + ((next_phase < phase) ? 1 : 0);
+        phase = next_phase;
+    }
+
+    return result;
+}
+
+} /* namespace interpolation */
+} /* namespace dsp */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __POLYPHASE_RESAMPLER_H__
+#define __POLYPHASE_RESAMPLER_H__
+
+#include "complex.hpp"
+#include "dsp_fir_taps.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace dsp {
+namespace interpolation {
+
+/* Arbitrary ratio complex resampler. Works like LinearResampler, a phase
+ * accumulator steps through the input at input_rate / output_rate, but
+ * each output is filtered through the nearest of 128 branches of a
+ * windowed-sinc prototype instead of a straight line between samples.
+ * The prototype cutoff follows the lower of the two rates. With eight
+ * taps per branch the stopband is meant for upsampling and mild
+ * decimation; large decimation ratios belong in the capture chain. */
+class PolyphaseResampler {
+   public:
+    static constexpr size_t phase_bits = 7;
+    static constexpr size_t phases = 1 << phase_bits;
+    static constexpr size_t taps_per_phase = 8;
+
+    struct Result {
+        size_t consumed;
+        size_t produced;
+    };
+
+    void configure(const uint32_t input_rate, const uint32_t output_rate);
+    void reset();
+
+    /* True when the rates match and the samples can be passed through. */
+    bool bypass() const { return step == (1ULL << 32); }
+
+    /* Stops when either the input runs out or the output is full. */
+    Result operator()(
+        const complex8_t* const in,
+        const size_t in_count,
+        complex8_t* const out,
+        const size_t out_count);
+
+    const fir_taps_real<phases * taps_per_phase>& prototype() const { return prototype_; }
+
+   private:
+    fir_taps_real<phases * taps_per_phase> prototype_{};
+
+    /* Prototype regrouped per branch, oldest sample first. */
+    std::array<std::array<int16_t, taps_per_phase>, phases> branches{};
+
+    /* Delay line written twice so that a window is always contiguous. */
+    std::array<int16_t, taps_per_phase * 2> history_i{};
+    std::array<int16_t, taps_per_phase * 2> history_q{};
+    size_t history_index{0};
+
+    uint64_t step{1ULL << 32};  // Input samples per output, Q32.32.
+    uint32_t phase{0};          // Fraction of an input sample.
+    size_t advance{0};          // Input samples to take before the next output.
+
+    void push(const complex8_t sample);
+    complex8_t filter(const size_t branch) const;
+};
+
+} /* namespace interpolation */
+} /* namespace dsp */
+
+#endif /*__POLYPHASE_RESAMPLER_H__*/
@@ -24,8 +24,11 @@
 #include "audio_dma.hpp"
 #include "dsp_fir_taps.hpp"
 #include "event_m4.hpp"
+#include "portapack_shared_memory.hpp"
 #include "utility.hpp"
 
+#include <algorithm>
+
 using namespace dsp::decimate;
 
 CaptureProcessor::CaptureProcessor() {
@@ -34,16 +37,14 @@ CaptureProcessor::CaptureProcessor() {
 }
 
 void CaptureProcessor::execute(const buffer_c8_t& buffer) {
+    const auto start = halGetCounterValue();
+
     auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    auto out_buffer = decim_1.execute(decim_0_out, dst_buffer);
+    auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+    auto out_buffer = decim_2.execute(decim_1_out, dst_buffer);
 
-    if (stream) {
-        const size_t bytes_to_write = sizeof(*out_buffer.p) * out_buffer.count;
-        const size_t written = stream->write(out_buffer.p, bytes_to_write);
-        if (written != bytes_to_write) {
-            // TODO: Send an error message to the app?
-        }
-    }
+    if (stream)
+        write_stream(out_buffer);
 
     feed_channel_stats(out_buffer);
 
@@ -53,6 +54,49 @@ void CaptureProcessor::execute(const buffer_c8_t& buffer) {
         channel_spectrum.feed(out_buffer, channel_filter_low_f,
                               channel_filter_high_f, channel_filter_transition);
     }
+
+    update_statistics(halGetCounterValue() - start, buffer.count);
+}
+
+void CaptureProcessor::write_stream(const buffer_c16_t& buffer) {
+    const size_t bytes_to_write = sizeof(*buffer.p) * buffer.count;
+
+    if (trigger && !trigger->fired()) {
+        if (!trigger->evaluate(buffer)) {
+            trigger->store(buffer.p, bytes_to_write);
+            return;
+        }
+
+        // The blocks leading up to the trigger go out first.
+        trigger->drain([this](const void* const data, const size_t length) {
+            stream->write(data, length);
+        });
+        capture->trigger_fired = true;
+    }
+
+    const size_t written = stream->write(buffer.p, bytes_to_write);
+    if (written != bytes_to_write) {
+        // TODO: Send an error message to the app?
+    }
+}
+
+void CaptureProcessor::update_statistics(const uint32_t cycles, const size_t samples) {
+    cycles_total += cycles;
+    cycles_samples += samples;
+    cycles_buffers++;
+
+    if (cycles_samples >= baseband_fs * statistics_interval_s) {
+        // Cycles the core has between buffers at this sample rate.
+        const uint64_t budget = static_cast<uint64_t>(cycles_samples) * halGetCounterFrequency() / baseband_fs;
+
+        statistics_message.cycles_average = cycles_total / cycles_buffers;
+        statistics_message.load_percent = std::min<uint64_t>(100, budget ? cycles_total * 100 / budget : 0);
+        shared_memory.application_queue.push(statistics_message);
+
+        cycles_total = 0;
+        cycles_samples = 0;
+        cycles_buffers = 0;
+    }
 }
 
 void CaptureProcessor::on_signal_message(const RequestSignalMessage& message) {
@@ -122,7 +166,20 @@ void CaptureProcessor::sample_rate_config(const SampleRateConfigMessage& message
     if (sample_rate >= 1'500'000)
         spectrum_interval_samples /= (sample_rate / 750'000);
 
-    switch (message.oversample_rate) {
+    configure_chain(message.oversample_rate, message.filter, sample_rate);
+
+    cycles_total = 0;
+    cycles_samples = 0;
+    cycles_buffers = 0;
+}
+
+void CaptureProcessor::configure_chain(
+    const OversampleRate oversample_rate,
+    const DecimationFilter filter,
+    const uint32_t sample_rate) {
+    decim_2.set<NoopDecim>();
+
+    switch (oversample_rate) {
         case OversampleRate::x4:
             // M4 can't handle 2 decimation passes for sample rates needing x4.
             decim_0.set<FIRC8xR16x24FS4Decim4>().configure(taps_200k_decim_0.taps);
@@ -130,8 +187,10 @@ void CaptureProcessor::sample_rate_config(const SampleRateConfigMessage& message
             break;
 
         case OversampleRate::x8:
-            // M4 can't handle 2 decimation passes for sample rates <= 600k.
-            if (message.sample_rate < 600'000) {
+            // Standard only runs 2 decimation passes below 600k, above that
+            // the M4 struggles to keep up with them.
+            if (filter == DecimationFilter::Sharp ||
+                (filter == DecimationFilter::Standard && sample_rate < 600'000)) {
                 decim_0.set<FIRC8xR16x24FS4Decim4>().configure(taps_200k_decim_0.taps);
                 decim_1.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
             } else {
@@ -142,18 +201,36 @@ void CaptureProcessor::sample_rate_config(const SampleRateConfigMessage& message
             break;
 
         case OversampleRate::x16:
-            decim_0.set<FIRC8xR16x24FS4Decim8>().configure(taps_200k_decim_0.taps);
-            decim_1.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
+            if (filter == DecimationFilter::Sharp) {
+                decim_0.set<FIRC8xR16x24FS4Decim4>().configure(taps_200k_decim_0.taps);
+                decim_1.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
+                decim_2.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
+            } else {
+                decim_0.set<FIRC8xR16x24FS4Decim8>().configure(taps_200k_decim_0.taps);
+                decim_1.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
+            }
             break;
 
         case OversampleRate::x32:
-            decim_0.set<FIRC8xR16x24FS4Decim4>().configure(taps_200k_decim_0.taps);
-            decim_1.set<FIRC16xR16x32Decim8>().configure(taps_16k0_decim_1.taps);
+            if (filter == DecimationFilter::Sharp) {
+                decim_0.set<FIRC8xR16x24FS4Decim8>().configure(taps_200k_decim_0.taps);
+                decim_1.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
+                decim_2.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
+            } else {
+                decim_0.set<FIRC8xR16x24FS4Decim4>().configure(taps_200k_decim_0.taps);
+                decim_1.set<FIRC16xR16x32Decim8>().configure(taps_16k0_decim_1.taps);
+            }
             break;
 
         case OversampleRate::x64:
-            decim_0.set<FIRC8xR16x24FS4Decim8>().configure(taps_200k_decim_0.taps);
-            decim_1.set<FIRC16xR16x32Decim8>().configure(taps_16k0_decim_1.taps);
+            if (filter == DecimationFilter::Sharp) {
+                decim_0.set<FIRC8xR16x24FS4Decim4>().configure(taps_200k_decim_0.taps);
+                decim_1.set<FIRC16xR16x32Decim8>().configure(taps_16k0_decim_1.taps);
+                decim_2.set<FIRC16xR16x16Decim2>().configure(taps_200k_decim_1.taps);
+            } else {
+                decim_0.set<FIRC8xR16x24FS4Decim8>().configure(taps_200k_decim_0.taps);
+                decim_1.set<FIRC16xR16x32Decim8>().configure(taps_16k0_decim_1.taps);
+            }
             break;
 
         default:
@@ -163,10 +240,24 @@ void CaptureProcessor::sample_rate_config(const SampleRateConfigMessage& message
 }
 
 void CaptureProcessor::capture_config(const CaptureConfigMessage& message) {
-    if (message.config)
+    trigger.reset();
+    capture = message.config;
+
+    if (message.config) {
         stream = std::make_unique<StreamInput>(message.config);
-    else
+
+        if (message.config->trigger.enabled()) {
+            // The ring is drained into the pool in one go, it has to leave
+            // a buffer free for the block that fired the trigger.
+            const auto pool_bytes = (message.config->buffer_count - 1) * message.config->write_size;
+            trigger = std::make_unique<CaptureTrigger>(
+                message.config->trigger,
+                pool_bytes,
+                heap_reserve);
+        }
+    } else {
         stream.reset();
+    }
 }
 
 int main() {
@@ -27,6 +27,7 @@
 #include "baseband_thread.hpp"
 #include "rssi_thread.hpp"
 
+#include "capture_trigger.hpp"
 #include "dsp_decimate.hpp"
 #include "spectrum_collector.hpp"
 #include "stream_input.hpp"
@@ -98,6 +99,9 @@ class CaptureProcessor : public BasebandProcessor {
 
     size_t baseband_fs = 3072000;  // aka: sample_rate
     static constexpr auto spectrum_rate_hz = 50.0f;
+    static constexpr float statistics_interval_s = 1.0f;
+    // Heap left for everything else once the pre-trigger ring is allocated.
+    static constexpr size_t heap_reserve = 4096;
 
     std::array<complex16_t, 512> dst{};
     const buffer_c16_t dst_buffer{
@@ -114,24 +118,42 @@ class CaptureProcessor : public BasebandProcessor {
         dsp::decimate::FIRC16xR16x32Decim8,
         NoopDecim>
         decim_1{};
+    /* Only used by the Sharp chains, which split the decimation finer. */
+    MultiDecimator<
+        NoopDecim,
+        dsp::decimate::FIRC16xR16x16Decim2>
+        decim_2{};
 
     int32_t channel_filter_low_f = 0;
     int32_t channel_filter_high_f = 0;
     int32_t channel_filter_transition = 0;
 
     std::unique_ptr<StreamInput> stream{};
+    std::unique_ptr<CaptureTrigger> trigger{};
+    CaptureConfig* capture{nullptr};
 
     SpectrumCollector channel_spectrum{};
     size_t spectrum_interval_samples = 0;
     size_t spectrum_samples = 0;
 
+    uint64_t cycles_total = 0;
+    size_t cycles_samples = 0;
+    size_t cycles_buffers = 0;
+    CaptureStatisticsMessage statistics_message{};
+
     /* NB: Threads should be the last members in the class definition. */
     BasebandThread baseband_thread{
         baseband_fs, this, baseband::Direction::Receive, /*auto_start*/ false};
     RSSIThread rssi_thread{};
 
     void sample_rate_config(const SampleRateConfigMessage& message);
+    void configure_chain(
+        const OversampleRate oversample_rate,
+        const DecimationFilter filter,
+        const uint32_t sample_rate);
     void capture_config(const CaptureConfigMessage& message);
+    void update_statistics(const uint32_t cycles, const size_t samples);
+    void write_stream(const buffer_c16_t& buffer);
 };
 
 #endif /*__PROC_CAPTURE_HPP__*/
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "proc_channelizer.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include "audio_dma.hpp"
+#include "dsp_fft.hpp"
+#include "dsp_fir_taps.hpp"
+#include "dsp_iir_config.hpp"
+
+#include "event_m4.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace {
+
+/* Mean |x|^2 of a full scale complex tone. */
+constexpr float full_scale_db = 90.3f;
+
+int8_t power_to_db(const float power) {
+    const float db = dsp::fft::log2_q8(power) * (3.0103f / 256) - full_scale_db;
+    return std::max(-128.0f, std::min(0.0f, db));
+}
+
+}  // namespace
+
+void ChannelizerProcessor::execute(const buffer_c8_t& buffer) {
+    if (!configured) {
+        return;
+    }
+
+    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+    const auto channels = bank.execute(decim_0_out, bank_buffer);
+
+    for (size_t c = 0; c < channel_count; c++) {
+        const auto channel = bank.channel(channels, first_channel + c);
+        float sum = 0;
+        for (size_t i = 0; i < channel.count; i++)
+            sum += dsp::fft::power(channel.p[i]);
+        power_sum[c] += sum;
+    }
+    power_samples += channels.count / bank_channels;
+
+    if (++status_buffers == status_interval) {
+        update_status();
+    }
+
+    std::array<int32_t, 16> sum{};
+    int32_t open = 0;
+    for (size_t r = 0; r < route_count; r++) {
+        auto& route = routes[r];
+
+        // Keep every discriminator running so it has no stale phase when its squelch opens.
+        const auto channel = bank.channel(channels, first_channel + route.channel);
+        const auto demodulated = route.demod.execute(channel, audio_buffer);
+
+        if (open_mask & (1 << route.channel)) {
+            for (size_t i = 0; i < demodulated.count; i++)
+                sum[i] += demodulated.p[i];
+            open++;
+        }
+    }
+
+    size_t mix_count = 0;
+    for (size_t i = 0; i < audio.size(); i++) {
+        audio_resampler(open ? sum[i] / open : 0, [this, &mix_count](const float sample) {
+            mix[mix_count++] = sample;
+        });
+    }
+
+    audio_output.write(buffer_s16_t{mix.data(), mix_count, audio_fs});
+}
+
+void ChannelizerProcessor::update_status() {
+    std::array<int8_t, channel_count> sorted;
+    for (size_t c = 0; c < channel_count; c++) {
+        status_message.power_db[c] = power_to_db(power_sum[c] / power_samples);
+        sorted[c] = status_message.power_db[c];
+    }
+
+    // The quietest quarter of the channels stands in for the noise floor.
+    std::nth_element(sorted.begin(), sorted.begin() + channel_count / 4, sorted.end());
+    const int32_t noise_floor = sorted[channel_count / 4];
+
+    uint16_t new_open_mask = 0;
+    for (size_t c = 0; c < channel_count; c++) {
+        const bool was_open = open_mask & (1 << c);
+        const int32_t threshold = noise_floor + squelch_db - (was_open ? squelch_hysteresis_db : 0);
+
+        if ((squelch_db == 0) || (status_message.power_db[c] >= threshold))
+            new_open_mask |= 1 << c;
+    }
+    open_mask = new_open_mask;
+
+    status_message.noise_floor_db = noise_floor;
+    status_message.open_mask = open_mask;
+    status_message.routed_mask = 0;
+    for (size_t r = 0; r < route_count; r++)
+        status_message.routed_mask |= 1 << routes[r].channel;
+    shared_memory.application_queue.push(status_message);
+
+    power_sum.fill(0);
+    power_samples = 0;
+    status_buffers = 0;
+}
+
+void ChannelizerProcessor::on_message(const Message* const message) {
+    switch (message->id) {
+        case Message::ID::ChannelizerConfigure:
+            configure(*reinterpret_cast<const ChannelizerConfigureMessage*>(message));
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ChannelizerProcessor::configure(const ChannelizerConfigureMessage& message) {
+    constexpr size_t decim_0_input_fs = baseband_fs;
+    constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
+
+    constexpr size_t bank_input_fs = decim_0_output_fs;
+    constexpr size_t bank_output_fs = bank_input_fs / bank_channels;
+
+    constexpr size_t demod_input_fs = bank_output_fs;
+
+    // The baseband thread skips buffers until the new routes are in place.
+    configured = false;
+
+    decim_0.configure(taps_400k_channelizer_decim_0.taps);
+    bank.configure(bank_channels);
+    audio_resampler = {};
+    audio_resampler.configure(demod_input_fs, audio_fs);
+
+    route_count = 0;
+    for (size_t c = 0; (c < channel_count) && (route_count < max_routes); c++) {
+        if (message.route_mask & (1 << c)) {
+            routes[route_count].channel = c;
+            routes[route_count].demod.configure(demod_input_fs, message.deviation, dsp::demodulate::FM::Discriminator::Polynomial);
+            route_count++;
+        }
+    }
+
+    squelch_db = message.squelch_db;
+    open_mask = 0;
+    power_sum.fill(0);
+    power_samples = 0;
+    status_buffers = 0;
+
+    audio_output.configure(audio_24k_hpf_300hz_config, audio_24k_deemph_300_6_config);
+
+    configured = true;
+}
+
+int main() {
+    audio::dma::init_audio_out();
+
+    EventDispatcher event_dispatcher{std::make_unique<ChannelizerProcessor>()};
+    event_dispatcher.run();
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __PROC_CHANNELIZER_H__
+#define __PROC_CHANNELIZER_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "dsp_decimate.hpp"
+#include "dsp_demodulate.hpp"
+#include "linear_resampler.hpp"
+#include "polyphase_channelizer.hpp"
+
+#include "audio_output.hpp"
+#include "message.hpp"
+
+#include <array>
+#include <cstdint>
+
+/* Watches sixteen NFM channels on the 25 kHz raster at once. The front
+ * end keeps the centre 400 kHz around the tuned frequency, a 32 channel
+ * filter bank splits the resulting 800 kHz into 25 kHz channels, and the
+ * middle sixteen are monitored: their power and squelch state go to the
+ * application, and up to four of them are demodulated and mixed while
+ * their squelch is open. The mix is resampled to the 24 kHz audio rate.
+ * The outer channels sit in the front end's transition band and are not
+ * used. */
+class ChannelizerProcessor : public BasebandProcessor {
+   public:
+    void execute(const buffer_c8_t& buffer) override;
+    void on_message(const Message* const message) override;
+
+   private:
+    static constexpr size_t baseband_fs = 3200000;
+    static constexpr size_t audio_fs = 24000;
+    static constexpr size_t bank_channels = 32;
+    static constexpr size_t channel_count = ChannelizerConfigureMessage::channel_count;
+    static constexpr size_t first_channel = (bank_channels - channel_count) / 2;
+    static constexpr size_t max_routes = ChannelizerConfigureMessage::max_routes;
+    static constexpr size_t status_interval = 150;  // Buffers, about 10 Hz.
+    static constexpr int32_t squelch_hysteresis_db = 3;
+
+    std::array<complex16_t, 512> dst{};
+    const buffer_c16_t dst_buffer{
+        dst.data(),
+        dst.size()};
+
+    std::array<complex16_t, 512> bank_out{};
+    const buffer_c16_t bank_buffer{
+        bank_out.data(),
+        bank_out.size()};
+
+    std::array<int16_t, 16> audio{};
+    const buffer_s16_t audio_buffer{
+        audio.data(),
+        audio.size()};
+
+    // 25 kHz in, 24 kHz out: never more samples than the bank gives each channel.
+    std::array<int16_t, 16> mix{};
+
+    dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0{};
+    dsp::decimate::PolyphaseChannelizer bank{};
+    dsp::interpolation::LinearResampler audio_resampler{};
+
+    struct Route {
+        size_t channel;
+        dsp::demodulate::FM demod;
+    };
+    std::array<Route, max_routes> routes{};
+    size_t route_count{0};
+
+    AudioOutput audio_output{};
+
+    std::array<float, channel_count> power_sum{};
+    size_t power_samples{0};
+    size_t status_buffers{0};
+    uint8_t squelch_db{0};
+    uint16_t open_mask{0};
+
+    volatile bool configured{false};
+    ChannelizerStatusMessage status_message{};
+
+    /* NB: Threads should be the last members in the class definition. */
+    BasebandThread baseband_thread{baseband_fs, this, baseband::Direction::Receive};
+    RSSIThread rssi_thread{};
+
+    void configure(const ChannelizerConfigureMessage& message);
+    void update_status();
+};
+
+#endif /*__PROC_CHANNELIZER_H__*/
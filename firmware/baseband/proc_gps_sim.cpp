@@ -50,20 +50,18 @@ void GPSReplayProcessor::execute(const buffer_c8_t& buffer) {
     // File data is in C8 format, which is what we need
     // File samplerate is 2.6MHz, which is what we need
     // To fill up the 2048-sample C8 buffer @ 2 bytes per sample = 4096 bytes
+    // Read straight into the DMA buffer so that underrun fill reaches the air.
     const size_t bytes_to_read = sizeof(*buffer.p) * 1 * (buffer.count);
-    size_t bytes_read_this_iteration = stream->read(iq_buffer.p, bytes_to_read);
+    size_t bytes_read_this_iteration = stream->read(buffer.p, bytes_to_read);
     size_t samples_read_this_iteration = bytes_read_this_iteration / sizeof(*buffer.p);
 
     bytes_read += bytes_read_this_iteration;
 
-    // NB: Couldn't we have just read the data into buffer.p to start with, or some DMA/cache coherency concern?
-    //
-    // for (size_t i = 0; i < buffer.count; i++) {
-    //     auto re_out = iq_buffer.p[i].real();
-    //     auto im_out = iq_buffer.p[i].imag();
-    //     buffer.p[i] = {(int8_t)re_out, (int8_t)im_out};
-    // }
-    memcpy(buffer.p, iq_buffer.p, bytes_read_this_iteration);  // memcpy should be more efficient than 1 byte at a time
+    const auto& underruns = stream->underrun_statistics();
+    if (underruns.aborted && !txunderrun_message.statistics.aborted) {
+        // Report right away so that the application can stop transmitting.
+        report_underruns();
+    }
 
     spectrum_samples += samples_read_this_iteration;
     if (spectrum_samples >= spectrum_interval_samples) {
@@ -73,9 +71,17 @@ void GPSReplayProcessor::execute(const buffer_c8_t& buffer) {
 
         txprogress_message.done = false;
         shared_memory.application_queue.push(txprogress_message);
+
+        if (underruns.count != txunderrun_message.statistics.count)
+            report_underruns();
     }
 }
 
+void GPSReplayProcessor::report_underruns() {
+    txunderrun_message.statistics = stream->underrun_statistics();
+    shared_memory.application_queue.push(txunderrun_message);
+}
+
 void GPSReplayProcessor::on_message(const Message* const message) {
     switch (message->id) {
         case Message::ID::UpdateSpectrum:
@@ -90,6 +96,7 @@ void GPSReplayProcessor::on_message(const Message* const message) {
         case Message::ID::ReplayConfig:
             configured = false;
             bytes_read = 0;
+            txunderrun_message.statistics = {};
             replay_config(*reinterpret_cast<const ReplayConfigMessage*>(message));
             break;
 
@@ -45,12 +45,6 @@ class GPSReplayProcessor : public BasebandProcessor {
     size_t baseband_fs = 3072000;
     static constexpr auto spectrum_rate_hz = 50.0f;
 
-    std::array<complex8_t, 2048> iq{};
-    const buffer_c8_t iq_buffer{
-        iq.data(),
-        iq.size(),
-        baseband_fs};
-
     int32_t channel_filter_low_f = 0;
     int32_t channel_filter_high_f = 0;
     int32_t channel_filter_transition = 0;
@@ -66,8 +60,10 @@ class GPSReplayProcessor : public BasebandProcessor {
 
     void sample_rate_config(const SampleRateConfigMessage& message);
     void replay_config(const ReplayConfigMessage& message);
+    void report_underruns();
 
     TXProgressMessage txprogress_message{};
+    TXUnderrunMessage txunderrun_message{};
     RequestSignalMessage sig_message{RequestSignalMessage::Signal::FillRequest};
 
     /* NB: Threads should be the last members in the class definition. */
@@ -149,7 +149,7 @@ void NarrowbandFMAudio::configure(const NBFMConfigureMessage& message) {
     decim_0.configure(message.decim_0_filter.taps);
     decim_1.configure(message.decim_1_filter.taps);
     channel_filter.configure(message.channel_filter.taps, message.channel_decimation);
-    demod.configure(demod_input_fs, message.deviation);
+    demod.configure(demod_input_fs, message.deviation, dsp::demodulate::FM::Discriminator::Polynomial);
     channel_filter_low_f = message.channel_filter.low_frequency_normalized * channel_filter_input_fs;
     channel_filter_high_f = message.channel_filter.high_frequency_normalized * channel_filter_input_fs;
     channel_filter_transition = message.channel_filter.transition_normalized * channel_filter_input_fs;
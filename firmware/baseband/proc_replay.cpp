@@ -21,6 +21,7 @@
  */
 
 #include "proc_replay.hpp"
+#include "dsp_convert.hpp"
 #include "sine_table_int8.hpp"
 #include "portapack_shared_memory.hpp"
 
@@ -79,24 +80,14 @@ void ReplayProcessor::execute(const buffer_c8_t& buffer) {
     // Compute the number of samples were actually read from the source.
     size_t samples_read = current_bytes_read / sizeof(buffer_c16_t::Type);
 
-    // Write converted source samples to the output buffer with interpolation.
-    for (auto i = 0u; i < samples_read; ++i) {
-        int8_t re_out = iq_buffer.p[i].real() >> 8;
-        int8_t im_out = iq_buffer.p[i].imag() >> 8;
-        auto out_value = buffer_c8_t::Type{re_out, im_out};
-
-        // Interpolate sample.
-        for (auto j = 0u; j < interpolation_factor; ++j) {
-            size_t index = i * interpolation_factor + j;
-            buffer.p[index] = out_value;
-
 #if BUFFER_SIZE_ASSERT
-            // Verify the index is within bounds.
-            if (index >= buffer.count)
-                chDbgPanic("Output bounds");
+    // Verify the interpolated samples stay within bounds.
+    if (samples_read * interpolation_factor > buffer.count)
+        chDbgPanic("Output bounds");
 #endif
-        }
-    }
+
+    // Write converted source samples to the output buffer with interpolation.
+    dsp::convert::c16_to_c8_repeat(iq_buffer.p, samples_read, buffer.p, interpolation_factor);
 
     // Update tracking stats.
     bytes_read += current_bytes_read;
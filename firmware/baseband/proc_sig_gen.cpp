@@ -50,20 +50,34 @@ void SigGenProcessor::execute(const buffer_c8_t& buffer) {
     // File data is in C8 format, which is what we need
     // File samplerate is 2.6MHz, which is what we need
     // To fill up the 2048-sample C8 buffer @ 2 bytes per sample = 4096 bytes
+    // The M4 has no data cache, so the stream is read straight into the DMA
+    // transfer buffer instead of being staged and copied.
     const size_t bytes_to_read = sizeof(*buffer.p) * 1 * (buffer.count);
-    size_t bytes_read_this_iteration = stream->read(iq_buffer.p, bytes_to_read);
-    size_t samples_read_this_iteration = bytes_read_this_iteration / sizeof(*buffer.p);
+    size_t bytes_read_this_iteration = 0;
+    size_t samples_read_this_iteration = 0;
+
+    if (resampler.bypass()) {
+        bytes_read_this_iteration = stream->read(buffer.p, bytes_to_read);
+        samples_read_this_iteration = bytes_read_this_iteration / sizeof(*buffer.p);
+    } else {
+        bytes_read_this_iteration = read_resampled(buffer);
+        samples_read_this_iteration = buffer.count;
+    }
 
     bytes_read += bytes_read_this_iteration;
 
-    // NB: Couldn't we have just read the data into buffer.p to start with, or some DMA/cache coherency concern?
-    //
-    // for (size_t i = 0; i < buffer.count; i++) {
-    //     auto re_out = iq_buffer.p[i].real();
-    //     auto im_out = iq_buffer.p[i].imag();
-    //     buffer.p[i] = {(int8_t)re_out, (int8_t)im_out};
-    // }
-    memcpy(buffer.p, iq_buffer.p, bytes_read_this_iteration);  // memcpy should be more efficient than 1 byte at a time
+    if (!mixer.bypass())
+        mixer(buffer.p, buffer.count);
+
+    // The stream keeps running through the off windows so that the burst
+    // edges only depend on the sample count.
+    gate.apply(buffer.p, buffer.count);
+
+    const auto& underruns = stream->underrun_statistics();
+    if (underruns.aborted && !txunderrun_message.statistics.aborted) {
+        // Report right away so that the application can stop transmitting.
+        report_underruns();
+    }
 
     spectrum_samples += samples_read_this_iteration;
     if (spectrum_samples >= spectrum_interval_samples) {
@@ -73,7 +87,39 @@ void SigGenProcessor::execute(const buffer_c8_t& buffer) {
 
         txprogress_message.done = false;
         shared_memory.application_queue.push(txprogress_message);
+
+        if (underruns.count != txunderrun_message.statistics.count)
+            report_underruns();
+    }
+}
+
+size_t SigGenProcessor::read_resampled(const buffer_c8_t& buffer) {
+    size_t bytes = 0;
+    size_t produced = 0;
+
+    while (produced < buffer.count) {
+        if (resampler_input_position == resampler_input.size()) {
+            // Holes are filled by the stream's fill policy, so the whole
+            // chunk is always usable.
+            bytes += stream->read(resampler_input.data(), sizeof(resampler_input));
+            resampler_input_position = 0;
+        }
+
+        const auto result = resampler(
+            &resampler_input[resampler_input_position],
+            resampler_input.size() - resampler_input_position,
+            &buffer.p[produced],
+            buffer.count - produced);
+        resampler_input_position += result.consumed;
+        produced += result.produced;
     }
+
+    return bytes;
+}
+
+void SigGenProcessor::report_underruns() {
+    txunderrun_message.statistics = stream->underrun_statistics();
+    shared_memory.application_queue.push(txunderrun_message);
 }
 
 void SigGenProcessor::on_message(const Message* const message) {
@@ -90,9 +136,34 @@ void SigGenProcessor::on_message(const Message* const message) {
         case Message::ID::ReplayConfig:
             configured = false;
             bytes_read = 0;
+            txunderrun_message.statistics = {};
+            gate.reset();
+            resampler.reset();
+            resampler_input_position = resampler_input.size();
             replay_config(*reinterpret_cast<const ReplayConfigMessage*>(message));
             break;
 
+        case Message::ID::ReplayRateConfig: {
+            const auto& rate_message = *reinterpret_cast<const ReplayRateConfigMessage*>(message);
+            resampler.configure(rate_message.input_rate, rate_message.output_rate);
+            resampler_input_position = resampler_input.size();
+            break;
+        }
+
+        case Message::ID::ReplayMixerConfig: {
+            const auto& mixer_message = *reinterpret_cast<const ReplayMixerConfigMessage*>(message);
+            mixer_frequency = mixer_message.frequency_offset;
+            mixer.set_frequency(mixer_frequency, baseband_fs);
+            mixer.set_gain(mixer_message.gain_db, mixer_message.soft_clip);
+            break;
+        }
+
+        case Message::ID::TXGateConfig: {
+            const auto& gate_message = *reinterpret_cast<const TXGateConfigMessage*>(message);
+            gate.configure(gate_message.on_samples, gate_message.off_samples);
+            break;
+        }
+
         // App has prefilled the buffers, we're ready to go now
         case Message::ID::FIFOData:
             configured = true;
@@ -107,11 +178,14 @@ void SigGenProcessor::sample_rate_config(const SampleRateConfigMessage& message)
     baseband_fs = message.sample_rate;
     baseband_thread.set_sampling_rate(baseband_fs);
     spectrum_interval_samples = baseband_fs / spectrum_rate_hz;
+    mixer.set_frequency(mixer_frequency, baseband_fs);
 }
 
 void SigGenProcessor::replay_config(const ReplayConfigMessage& message) {
     if (message.config) {
-        stream = std::make_unique<StreamOutput>(message.config);
+        // Free the previous pool first so that the new one can use its space.
+        stream.reset();
+        stream = std::make_unique<StreamOutput>(message.config, heap_reserve);
 
         // Tell application that the buffers and FIFO pointers are ready, prefill
         shared_memory.application_queue.push(sig_message);
@@ -30,6 +30,9 @@
 #include "spectrum_collector.hpp"
 
 #include "stream_output.hpp"
+#include "tx_gate.hpp"
+#include "polyphase_resampler.hpp"
+#include "dsp_mixer.hpp"
 
 #include <array>
 #include <memory>
@@ -44,18 +47,24 @@ class SigGenProcessor : public BasebandProcessor {
    private:
     size_t baseband_fs = 3072000;
     static constexpr auto spectrum_rate_hz = 50.0f;
-
-    std::array<complex8_t, 2048> iq{};
-    const buffer_c8_t iq_buffer{
-        iq.data(),
-        iq.size(),
-        baseband_fs};
+    static constexpr size_t heap_reserve = 4096;
 
     int32_t channel_filter_low_f = 0;
     int32_t channel_filter_high_f = 0;
     int32_t channel_filter_transition = 0;
 
     std::unique_ptr<StreamOutput> stream{};
+    TXGate gate{};
+
+    /* Captures at other rates go through the resampler, which pulls from
+     * the stream in smaller chunks than the DMA buffer. */
+    dsp::interpolation::PolyphaseResampler resampler{};
+    std::array<complex8_t, 512> resampler_input{};
+    size_t resampler_input_position{resampler_input.size()};
+
+    /* Applied at the baseband rate, after resampling. */
+    dsp::Mixer mixer{};
+    int32_t mixer_frequency{0};
 
     SpectrumCollector channel_spectrum{};
     size_t spectrum_interval_samples = 0;
@@ -66,8 +75,11 @@ class SigGenProcessor : public BasebandProcessor {
 
     void sample_rate_config(const SampleRateConfigMessage& message);
     void replay_config(const ReplayConfigMessage& message);
+    void report_underruns();
+    size_t read_resampled(const buffer_c8_t& buffer);
 
     TXProgressMessage txprogress_message{};
+    TXUnderrunMessage txunderrun_message{};
     RequestSignalMessage sig_message{RequestSignalMessage::Signal::FillRequest};
 
     /* NB: Threads should be the last members in the class definition. */
@@ -25,117 +25,283 @@
 #include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
+#include <algorithm>
 #include <cstdint>
 
+std::array<uint16_t, 256> SigGenProcessor::phasor_table;
+
+namespace {
+
+constexpr uint16_t pack_c8(const int8_t re, const int8_t im) {
+    return static_cast<uint8_t>(re) | (static_cast<uint8_t>(im) << 8);
+}
+
+constexpr uint8_t phase_index(const uint32_t phase) {
+    return phase >> 24;
+}
+
+}  // namespace
+
+SigGenProcessor::SigGenProcessor() {
+    for (size_t i = 0; i < phasor_table.size(); i++)
+        phasor_table[i] = pack_c8(sine_table_i8[(i + 64) & 0xFF], sine_table_i8[i]);
+}
+
 void SigGenProcessor::execute(const buffer_c8_t& buffer) {
     if (!configured) return;
 
-    for (size_t i = 0; i < buffer.count; i++) {
-        if (!sample_count && auto_off) {
+    const auto start = halGetCounterValue();
+    (this->*kernel)(buffer);
+    update_statistics(halGetCounterValue() - start);
+
+    if (auto_off) {
+        if (sample_count <= buffer.count) {
+            sample_count = 0;
             configured = false;
             txprogress_message.done = true;
             shared_memory.application_queue.push(txprogress_message);
-        } else
-            sample_count--;
-
-        if (tone_shape == 0) {
-            // CW
-            re = 127;  // max. signed 8 bits value .   (-128 ...+127), max. amplitude ,  static phasor at 0º
-            im = 0;
         } else {
-            if (tone_shape == 1) {
-                // Sine
-                sample = (sine_table_i8[(tone_phase & 0xFF000000) >> 24]);
-            } else if (tone_shape == 2) {
-                // Triangle
-                int8_t a = (tone_phase & 0xFF000000) >> 24;
-                sample = (a & 0x80) ? ((a << 1) ^ 0xFF) - 0x80 : (a << 1) + 0x80;
-            } else if (tone_shape == 3) {
-                // Saw up
-                sample = ((tone_phase & 0xFF000000) >> 24);
-            } else if (tone_shape == 4) {
-                // Saw down
-                sample = ((tone_phase & 0xFF000000) >> 24) ^ 0xFF;
-            } else if (tone_shape == 5) {
-                // Square
-                sample = (((tone_phase & 0xFF000000) >> 24) & 0x80) ? 127 : -128;
-            } else if (tone_shape == 6) {
-                // Noise generator, pseudo random noise generator, 16 bits linear-feedback shift register (LFSR) algorithm, variant Fibonacci.
-                // https://en.wikipedia.org/wiki/Linear-feedback_shift_register
-                // 16 bits LFSR .taps: 16, 15, 13, 4 ;feedback polynomial: x^16 + x^15 + x^13 + x^4 + 1
-                // Periode 65535= 2^n-1, quite continuous .
-                if (counter == 0) {  // we slow down the shift register, because the pseudo random noise clock freq was too high for modulator.
-                    bit_16 = ((lfsr_16 >> 0) ^ (lfsr_16 >> 1) ^ (lfsr_16 >> 3) ^ (lfsr_16 >> 4) ^ ((lfsr_16 >> 12) & 1));
-                    lfsr_16 = (lfsr_16 >> 1) | (bit_16 << 15);
-                    sample = (lfsr_16 & 0x00FF);  // main pseudo random noise generator.
-                }
-                if (counter == 5) {                                  // after many empiric test, that combination mix of >>4 and >>5, gives a reasonable trade off white noise / good rf power level .
-                    sample = ((lfsr_16 & 0b0000111111110000) >> 4);  // just changing the spectrum shape .
-                }
-                if (counter == 10) {
-                    sample = ((lfsr_16 & 0b0001111111100000) >> 5);  // just changing the spectrum shape .
-                }
-                counter++;
-                if (counter == 15) {
-                    counter = 0;
-                }
-            } else if (tone_shape == 7) {
-                // Digital BPSK consecutive 0,1,0,...continuous cycle, 1 bit/symbol, at rate of 2 symbols / Freq Tone Periode... without any Pulse shape at the moment .
-                re = (((tone_phase & 0xFF000000) >> 24) & 0x80) ? 127 : -128;  // Sending 2 bits by Periode T of the GUI tone, alternative static phasor to 0, -180º , 0º
-                im = 0;
-            } else if (tone_shape == 8) {
-                // Digital QPSK  consecutive 00, 01, 10, 11,00, ...continuous cycle ,2 bits/symbol, at rate of 4 symbols / Freq Tone Periode. not random., without any Pulse shape at the moment .
-
-                switch (((tone_phase & 0xFF000000) >> 24)) {
-                    case 0 ... 63:  // equivalent to 1/4 of total 360º degrees.
-                        /* "00" */
-                        re = (sine_table_i8[32]);       // we are sending symbol-phasor 45º during  1/4 of the total periode
-                        im = (sine_table_i8[32 + 64]);  // 32 index  = rounded (45º/360º * 255 total sin table steps) = 31,875
-                        break;
-
-                    case 64 ... 127:
-                        /* "01" */
-                        re = (sine_table_i8[96]);       // symbol-phasor 135º
-                        im = (sine_table_i8[96 + 64]);  // 96 index   = 32 + 256/4
-                        break;
-                        break;
-
-                    case 128 ... 191:
-                        /* "10" */
-                        re = (sine_table_i8[159]);       // symbol-phasor 225º
-                        im = (sine_table_i8[159 + 64]);  // 159 rounded index = 96 + 256/4 = 159.3
-                        break;
-
-                    case 192 ... 255:
-                        /* "11" */
-                        re = (sine_table_i8[223]);                  // symbol-phasor 315º ; 223 rounded index = (315/360) * 255 =223.125
-                        im = (sine_table_i8[((223 + 64) & 0xFF)]);  // Max index 255, circular periodic conversion.
-                        break;
-
-                    default:
-                        break;
-                }
-            }
+            sample_count -= buffer.count;
+        }
+    }
+}
+
+void SigGenProcessor::update_statistics(const uint32_t cycles) {
+    cycles_total += cycles;
+    cycles_peak = std::max(cycles_peak, cycles);
+
+    if (++cycles_buffers >= statistics_interval) {
+        statistics_message.shape = tone_shape;
+        statistics_message.cycles_average = cycles_total / cycles_buffers;
+        statistics_message.cycles_peak = cycles_peak;
+        shared_memory.application_queue.push(statistics_message);
+
+        cycles_total = 0;
+        cycles_peak = 0;
+        cycles_buffers = 0;
+    }
+}
+
+/* FM modulates four samples into four packed C8 outputs. The running sums
+ * of the samples give each output its own phase offset from the group's
+ * start, so only the group total is a serial dependency. */
+void SigGenProcessor::fm_modulate(const vec4_s8 samples, uint32_t* const out) {
+    constexpr vec2_s16 first{1, 0};
+    constexpr vec2_s16 both{1, 1};
+
+    const auto even = sxtb16(samples, 0);  // s0, s2
+    const auto odd = sxtb16(samples, 8);   // s1, s3
 
-            if (tone_shape != 6) {         //(all except Pseudo Random White Noise). We are in (1):periodic signals or (2):BPSK/QPSK , in both cases ,we  need Tone updated acum sum phases to modulate in FM / or control phasor phase (BPSK & QPSK.)
-                tone_phase += tone_delta;  // In periodic signals(Sine/triangle/square) we are using to FM mod. in BPSK-QSPK we are using to calculate each 1/4 of the periode.
+    const int32_t sum1 = even.v[0];
+    const int32_t sum2 = smlad(odd, first, sum1);
+    const int32_t sum3 = sum2 + even.v[1];
+    const int32_t sum4 = smlad(even, both, smlad(odd, both, 0));
+
+    const uint32_t p1 = phase + sum1 * fm_delta;
+    const uint32_t p2 = phase + sum2 * fm_delta;
+    const uint32_t p3 = phase + sum3 * fm_delta;
+    phase += sum4 * fm_delta;
+
+    vec4_s8 lo, hi;
+    lo.w = phasor_table[phase_index(p1)];
+    hi.w = phasor_table[phase_index(p2)];
+    out[0] = pkhbt(lo, hi, 16).w;
+    lo.w = phasor_table[phase_index(p3)];
+    hi.w = phasor_table[phase_index(phase)];
+    out[1] = pkhbt(lo, hi, 16).w;
+}
+
+void SigGenProcessor::kernel_cw(const buffer_c8_t& buffer) {
+    // Max. amplitude phasor, static at 0 degrees unless an offset is set.
+    carrier.generate(buffer.p, buffer.count);
+}
+
+void SigGenProcessor::kernel_tone_fm(const buffer_c8_t& buffer) {
+    auto out = reinterpret_cast<uint32_t*>(buffer.p);
+
+    for (size_t i = 0; i < buffer.count; i += 4) {
+        vec4_s8 samples;
+        samples.v[0] = shape_table[phase_index(tone_phase)];
+        samples.v[1] = shape_table[phase_index(tone_phase + tone_delta)];
+        samples.v[2] = shape_table[phase_index(tone_phase + 2 * tone_delta)];
+        samples.v[3] = shape_table[phase_index(tone_phase + 3 * tone_delta)];
+        tone_phase += 4 * tone_delta;
+
+        fm_modulate(samples, out);
+        out += 2;
+    }
+}
+
+void SigGenProcessor::kernel_noise_fm(const buffer_c8_t& buffer) {
+    // Pseudo random noise generator, 16 bits linear-feedback shift register (LFSR) algorithm, variant Fibonacci.
+    // https://en.wikipedia.org/wiki/Linear-feedback_shift_register
+    // 16 bits LFSR .taps: 16, 15, 13, 4 ;feedback polynomial: x^16 + x^15 + x^13 + x^4 + 1
+    // Periode 65535= 2^n-1, quite continuous .
+    auto out = reinterpret_cast<uint32_t*>(buffer.p);
+
+    for (size_t i = 0; i < buffer.count; i += 4) {
+        vec4_s8 samples;
+
+        for (size_t j = 0; j < 4; j++) {
+            if (counter == 0) {  // we slow down the shift register, because the pseudo random noise clock freq was too high for modulator.
+                const uint16_t bit_16 = ((lfsr_16 >> 0) ^ (lfsr_16 >> 1) ^ (lfsr_16 >> 3) ^ (lfsr_16 >> 4) ^ ((lfsr_16 >> 12) & 1));
+                lfsr_16 = (lfsr_16 >> 1) | (bit_16 << 15);
+                sample = (lfsr_16 & 0x00FF);  // main pseudo random noise generator.
+            } else if (counter == 5) {        // after many empiric test, that combination mix of >>4 and >>5, gives a reasonable trade off white noise / good rf power level .
+                sample = ((lfsr_16 & 0b0000111111110000) >> 4);  // just changing the spectrum shape .
+            } else if (counter == 10) {
+                sample = ((lfsr_16 & 0b0001111111100000) >> 5);  // just changing the spectrum shape .
             }
 
-            if (tone_shape < 7) {  // All Option shape signals  except BPSK(7) & QPSK(8) we are modulating in FM. (Those two has phase shift modulation XPSK , not FM  )
-                // Do FM modulation
-                delta = sample * fm_delta;
+            if (++counter == 15)
+                counter = 0;
+
+            samples.v[j] = sample;
+        }
+
+        fm_modulate(samples, out);
+        out += 2;
+    }
+}
+
+void SigGenProcessor::kernel_symbols(const buffer_c8_t& buffer) {
+    // Not FM: the tone phase selects which symbol phasor is sent.
+    auto out = reinterpret_cast<uint16_t*>(buffer.p);
+
+    for (size_t i = 0; i < buffer.count; i++) {
+        out[i] = symbol_table[phase_index(tone_phase)];
+        tone_phase += tone_delta;
+    }
+}
+
+bool SigGenProcessor::awg_ready(const buffer_c8_t& buffer) {
+    if (awg_table.complete())
+        return true;
+
+    // Still loading: stay silent.
+    std::fill(buffer.p, buffer.p + buffer.count, buffer_c8_t::Type{0, 0});
+    return false;
+}
+
+void SigGenProcessor::kernel_awg_fm(const buffer_c8_t& buffer) {
+    if (!awg_ready(buffer)) return;
+    auto out = reinterpret_cast<uint32_t*>(buffer.p);
+
+    for (size_t i = 0; i < buffer.count; i += 4) {
+        vec4_s8 samples;
+        for (size_t j = 0; j < 4; j++) {
+            samples.v[j] = awg_table.real_at(tone_phase);
+            tone_phase += tone_delta;
+        }
+
+        fm_modulate(samples, out);
+        out += 2;
+    }
+}
+
+void SigGenProcessor::kernel_awg_am(const buffer_c8_t& buffer) {
+    if (!awg_ready(buffer)) return;
+
+    for (size_t i = 0; i < buffer.count; i++) {
+        // Full depth: -128 is off, 127 is full carrier.
+        const int8_t envelope = (awg_table.real_at(tone_phase) + 128) >> 1;
+        buffer.p[i] = {envelope, 0};
+        tone_phase += tone_delta;
+    }
+}
+
+void SigGenProcessor::kernel_awg_direct(const buffer_c8_t& buffer) {
+    if (!awg_ready(buffer)) return;
+
+    if (awg_table.format() == AWGFormat::IQ) {
+        for (size_t i = 0; i < buffer.count; i++) {
+            buffer.p[i] = awg_table.iq_at(tone_phase);
+            tone_phase += tone_delta;
+        }
+    } else {
+        for (size_t i = 0; i < buffer.count; i++) {
+            buffer.p[i] = {awg_table.real_at(tone_phase), 0};
+            tone_phase += tone_delta;
+        }
+    }
+}
+
+void SigGenProcessor::configure_shape(const uint8_t shape) {
+    tone_shape = shape;
+
+    switch (shape) {
+        case 0:
+            // CW
+            kernel = &SigGenProcessor::kernel_cw;
+            return;
+
+        case 6:
+            // Noise generator
+            kernel = &SigGenProcessor::kernel_noise_fm;
+            return;
 
-                phase += delta;
-                sphase = phase + (64 << 24);
+        case 7:
+            // Digital BPSK consecutive 0,1,0,...continuous cycle, 1 bit/symbol, at rate of 2 symbols / Freq Tone Periode... without any Pulse shape at the moment .
+            for (size_t i = 0; i < symbol_table.size(); i++)
+                symbol_table[i] = pack_c8((i & 0x80) ? 127 : -128, 0);  // alternative static phasor to 0, -180º , 0º
+            kernel = &SigGenProcessor::kernel_symbols;
+            return;
 
-                re = (sine_table_i8[(sphase & 0xFF000000) >> 24]);  // sin LUT is not dealing with decimals , output range [-128 ,...127]
-                im = (sine_table_i8[(phase & 0xFF000000) >> 24]);
+        case 8: {
+            // Digital QPSK  consecutive 00, 01, 10, 11,00, ...continuous cycle ,2 bits/symbol, at rate of 4 symbols / Freq Tone Periode. not random., without any Pulse shape at the moment .
+            // Symbol phasors 45º, 135º, 225º, 315º, one per 1/4 of the periode ; 223 rounded index = (315/360) * 255 =223.125
+            constexpr uint8_t symbols[4] = {32, 96, 159, 223};
+            for (size_t i = 0; i < symbol_table.size(); i++) {
+                const uint8_t index = symbols[i >> 6];
+                symbol_table[i] = pack_c8(sine_table_i8[index], sine_table_i8[(index + 64) & 0xFF]);
             }
+            kernel = &SigGenProcessor::kernel_symbols;
+            return;
         }
 
-        buffer.p[i] = {re, im};
+        case 9:
+            // Arbitrary waveform, one table period per tone period.
+            if (awg_modulation == AWGModulation::AM)
+                kernel = &SigGenProcessor::kernel_awg_am;
+            else if (awg_modulation == AWGModulation::Direct)
+                kernel = &SigGenProcessor::kernel_awg_direct;
+            else
+                kernel = &SigGenProcessor::kernel_awg_fm;
+            return;
+
+        default:
+            break;
+    }
+
+    for (size_t i = 0; i < shape_table.size(); i++) {
+        const int8_t a = i;
+
+        switch (shape) {
+            case 1:
+                // Sine
+                shape_table[i] = sine_table_i8[i];
+                break;
+            case 2:
+                // Triangle
+                shape_table[i] = (a & 0x80) ? ((a << 1) ^ 0xFF) - 0x80 : (a << 1) + 0x80;
+                break;
+            case 3:
+                // Saw up
+                shape_table[i] = i;
+                break;
+            case 4:
+                // Saw down
+                shape_table[i] = i ^ 0xFF;
+                break;
+            default:
+                // Square
+                shape_table[i] = (i & 0x80) ? 127 : -128;
+                break;
+        }
     }
-};
+
+    kernel = &SigGenProcessor::kernel_tone_fm;
+}
 
 void SigGenProcessor::on_message(const Message* const msg) {
     const auto message = *reinterpret_cast<const SigGenConfigMessage*>(msg);
@@ -153,15 +319,46 @@ void SigGenProcessor::on_message(const Message* const msg) {
             } else
                 auto_off = false;
 
-            fm_delta = message.bw * (0xFFFFFFULL / 1536000);
-            tone_shape = message.shape;
+            // Full scale samples (+-128) deviate by +-bw/2.
+            fm_delta = (static_cast<uint64_t>(message.bw) << 24) / sampling_rate;
+            awg_modulation = message.awg_modulation;
+            configure_shape(message.shape);
 
             // lfsr = seed_value ;  		// Finally not used , init lfsr 8 bits.
             lfsr_16 = seed_value_16;  // init lfsr 16 bits.
 
+            cycles_total = 0;
+            cycles_peak = 0;
+            cycles_buffers = 0;
+
             configured = true;
             break;
 
+        case Message::ID::SigGenCarrier: {
+            const auto& carrier_message = *reinterpret_cast<const SigGenCarrierMessage*>(msg);
+            carrier.set_mode(static_cast<dsp::DDS::Mode>(carrier_message.mode));
+            carrier.set_frequency_word(dsp::DDS::frequency_word(carrier_message.offset, sampling_rate));
+            break;
+        }
+
+        case Message::ID::AWGConfig: {
+            const auto& awg_message = *reinterpret_cast<const AWGConfigMessage*>(msg);
+            if (awg_message.length)
+                awg_table.allocate(awg_message.format, awg_message.length);
+            else
+                awg_table.clear();
+            break;
+        }
+
+        case Message::ID::AWGData: {
+            // Copied out before the message is released, so the next chunk
+            // can reuse bb_data.
+            const auto& data_message = *reinterpret_cast<const AWGDataMessage*>(msg);
+            const auto size = std::min<size_t>(data_message.size, sizeof(shared_memory.bb_data.data));
+            awg_table.write(data_message.offset, shared_memory.bb_data.data, size);
+            break;
+        }
+
         case Message::ID::SigGenTone:
             tone_delta = reinterpret_cast<const SigGenToneMessage*>(msg)->tone_delta;
             break;
@@ -27,30 +27,76 @@
 #include "baseband_thread.hpp"
 #include "portapack_shared_memory.hpp"
 
+#include "dsp_dds.hpp"
+#include "dsp_wavetable.hpp"
+#include "simd.hpp"
+
+#include <array>
+
 class SigGenProcessor : public BasebandProcessor {
    public:
+    SigGenProcessor();
+
     void execute(const buffer_c8_t& buffer) override;
     void on_message(const Message* const msg) override;
 
    private:
+    /* Fills a whole buffer for one shape. Chosen when the shape changes so
+     * that the sample loops don't branch on it. */
+    using Kernel = void (SigGenProcessor::*)(const buffer_c8_t&);
+
+    static constexpr uint32_t sampling_rate = 1536000;
+    static constexpr size_t statistics_interval = sampling_rate / 2048;  // About 1s of buffers.
+
     bool configured{false};
+    Kernel kernel{&SigGenProcessor::kernel_cw};
 
     uint32_t tone_delta{0}, fm_delta{}, tone_phase{0};
     uint8_t tone_shape{};
     uint32_t sample_count{0};
     bool auto_off{};
-    int32_t phase{0}, sphase{0}, delta{0};  // they may have sign in the pseudo random sample generation.
-    int8_t sample{0}, re{0}, im{0};         // they have sign + and -.
-    uint16_t seed_value_16 = {0xACE1};      // seed 16 bits lfsr : any nonzero start state will work.
-    uint16_t lfsr_16{}, bit_16{};           // bit must be 16-bit to allow bit<<15 later in the code */
+    uint32_t phase{0};
+    int8_t sample{0};
+    uint16_t seed_value_16 = {0xACE1};  // seed 16 bits lfsr : any nonzero start state will work.
+    uint16_t lfsr_16{};
     uint8_t counter{0};
-    // uint8_t seed_value = {0x56}; 					// Finally not used lfsr of 8 bits , seed 8blfsr : any nonzero start state will work.
-    // uint8_t lfsr { }, bit { };  						// Finally not used lfsr of 8 bits , bit must be 8-bit to allow bit<<7 later in the code */
+
+    /* Periodic shapes (sine, triangle, saws, square) over one tone period,
+     * indexed by the top byte of tone_phase. */
+    std::array<int8_t, 256> shape_table{};
+    /* BPSK/QPSK symbol phasors as packed C8 samples, same indexing. */
+    std::array<uint16_t, 256> symbol_table{};
+    /* CW carrier, with an optional offset from the tuned frequency. */
+    dsp::DDS carrier{};
+    /* AWG shape: loaded once, then swept by tone_phase. */
+    dsp::WaveTable awg_table{};
+    AWGModulation awg_modulation{AWGModulation::FM};
+    /* {cos, sin} of the carrier phase as packed C8 samples. */
+    static std::array<uint16_t, 256> phasor_table;
+
+    uint32_t cycles_total{0};
+    uint32_t cycles_peak{0};
+    size_t cycles_buffers{0};
+
+    void configure_shape(const uint8_t shape);
+    void update_statistics(const uint32_t cycles);
+
+    void fm_modulate(const vec4_s8 samples, uint32_t* const out);
+
+    void kernel_cw(const buffer_c8_t& buffer);
+    void kernel_tone_fm(const buffer_c8_t& buffer);
+    void kernel_noise_fm(const buffer_c8_t& buffer);
+    void kernel_symbols(const buffer_c8_t& buffer);
+    void kernel_awg_fm(const buffer_c8_t& buffer);
+    void kernel_awg_am(const buffer_c8_t& buffer);
+    void kernel_awg_direct(const buffer_c8_t& buffer);
+    bool awg_ready(const buffer_c8_t& buffer);
 
     TXProgressMessage txprogress_message{};
+    SigGenStatisticsMessage statistics_message{};
 
     /* NB: Threads should be the last members in the class definition. */
-    BasebandThread baseband_thread{1536000, this, baseband::Direction::Transmit};
+    BasebandThread baseband_thread{sampling_rate, this, baseband::Direction::Transmit};
 };
 
 #endif
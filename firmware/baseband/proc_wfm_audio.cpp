@@ -94,11 +94,12 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
             break;
         case FFT:
             // Spread the FFT workload in time to avoid making the audio skip
-            // "8" comes from the log2() of the size of audio_spectrum: log2(256) = 8
-            if (fft_step < 8) {
-                fft_c_preswapped(audio_spectrum, fft_step, fft_step + 1);
+            // One radix-4 pass per buffer: four passes for 256 points
+            if (fft_step < dsp::fft::pass_count(audio_spectrum.size())) {
+                dsp::fft::passes(audio_spectrum.data(), audio_spectrum.size(), fft_step, fft_step + 1);
                 fft_step++;
             } else {
+                dsp::fft::bit_reverse(audio_spectrum.data(), audio_spectrum.size());
                 const size_t spectrum_end = spectrum.db.size();
                 for (size_t i = 0; i < spectrum_end; i++) {
                     // const auto corrected_sample = spectrum_window_hamming_3(audio_spectrum, i);
@@ -129,7 +130,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 
 void WidebandFMAudio::post_message(const buffer_c16_t& data) {
     // This is called when audio_spectrum_decimator is filled up to 256 samples
-    fft_swap(data, audio_spectrum);
+    dsp::fft::load(data, audio_spectrum);
     audio_spectrum_state = FFT;
     fft_step = 0;
 }
@@ -171,7 +172,7 @@ void WidebandFMAudio::configure(const WFMConfigureMessage& message) {
     channel_filter_low_f = message.decim_1_filter.low_frequency_normalized * decim_1_input_fs;
     channel_filter_high_f = message.decim_1_filter.high_frequency_normalized * decim_1_input_fs;
     channel_filter_transition = message.decim_1_filter.transition_normalized * decim_1_input_fs;
-    demod.configure(demod_input_fs, message.deviation);
+    demod.configure(demod_input_fs, message.deviation, dsp::demodulate::FM::Discriminator::Table);
     audio_filter.configure(message.audio_filter.taps);
     audio_output.configure(message.audio_hpf_config, message.audio_deemph_config);
 
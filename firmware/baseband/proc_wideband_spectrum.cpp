@@ -35,21 +35,26 @@ void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 
     if (!configured) return;
 
+    const size_t fft_size = channel_spectrum.fft_size();
+    if (fft_size == 0) return;
+
     if (phase == 0) {
-        std::fill(spectrum.begin(), spectrum.end(), 0);
+        std::fill_n(spectrum.begin(), fft_size, 0);
     }
 
-    for (size_t i = 0; i < spectrum.size(); i++) {
-        // TODO: Removed window-presum windowing, due to lack of available code RAM.
-        // TODO: Apply window to improve spectrum bin sidelobes.
-        spectrum[i] += buffer.p[i + 0];
-        spectrum[i] += buffer.p[i + 1024];
+    // Up to 1024 points, fold in the matching sample of the second half of
+    // the buffer. A 2048 point transform adds each sample twice instead, to
+    // keep the same gain.
+    const size_t fold = (fft_size <= 1024) ? 1024 : 0;
+    for (size_t i = 0; i < fft_size; i++) {
+        spectrum[i] += buffer.p[i];
+        spectrum[i] += buffer.p[i + fold];
     }
 
     if (phase == trigger) {
         const buffer_c16_t buffer_c16{
             spectrum.data(),
-            spectrum.size(),
+            fft_size,
             buffer.sampling_rate};
         channel_spectrum.feed(
             buffer_c16,
@@ -88,8 +93,13 @@ void WidebandSpectrum::on_message(const Message* const msg) {
 
     switch (msg->id) {
         case Message::ID::UpdateSpectrum:
+            channel_spectrum.on_message(msg);
+            break;
+
         case Message::ID::SpectrumStreamingConfig:
             channel_spectrum.on_message(msg);
+            // The FFT size may have changed; start a fresh presum.
+            phase = 0;
             break;
 
         case Message::ID::WidebandSpectrumConfig:
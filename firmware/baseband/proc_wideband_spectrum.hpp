@@ -48,7 +48,7 @@ class WidebandSpectrum : public BasebandProcessor {
 
     SpectrumCollector channel_spectrum{};
 
-    std::array<complex16_t, 256> spectrum{};
+    std::array<complex16_t, SpectrumStreamingConfigMessage::max_fft_size> spectrum{};
     size_t phase = 0, trigger = 127;
 
     /* NB: Threads should be the last members in the class definition. */
@@ -22,12 +22,14 @@
 #include "spectrum_collector.hpp"
 
 #include "dsp_fft.hpp"
+#include "heap_allocation.hpp"
 
 #include "utility.hpp"
 #include "event_m4.hpp"
 #include "portapack_shared_memory.hpp"
 
 #include <algorithm>
+#include <cstdlib>
 
 void SpectrumCollector::on_message(const Message* const message) {
     switch (message->id) {
@@ -44,14 +46,109 @@ void SpectrumCollector::on_message(const Message* const message) {
     }
 }
 
+namespace {
+
+struct WindowShape {
+    /* Cosine series: w(i) = a0 - a1 cos(x) + a2 cos(2x) - a3 cos(3x) + a4 cos(4x). */
+    std::array<float, 5> terms;
+    /* Display offset, Q8, that puts a tone at the level the old 256 point
+     * FFT with a three point Hamming window showed:
+     * 255 + 5 * (20 log10(0.54 * 256 / a0) - 20 log10(32768)). */
+    int32_t offset_q8;
+};
+
+constexpr WindowShape window_shape(const SpectrumWindow window) {
+    switch (window) {
+        case SpectrumWindow::BlackmanHarris:
+            return {{0.35875f, 0.48829f, 0.14128f, 0.01168f, 0.0f}, 15882};
+        case SpectrumWindow::FlatTop:
+            return {{0.21557895f, 0.41663158f, 0.277263158f, 0.083578947f, 0.006947368f}, 21544};
+        case SpectrumWindow::Hann:
+        default:
+            return {{0.5f, 0.5f, 0.0f, 0.0f, 0.0f}, 12191};
+    }
+}
+
+/* 5 * 10 log10(2), Q8: display units per log2 step of power. */
+constexpr int32_t units_per_log2_q8 = 3853;
+
+}  // namespace
+
 void SpectrumCollector::set_state(const SpectrumStreamingConfigMessage& message) {
     if (message.mode == SpectrumStreamingConfigMessage::Mode::Running) {
+        configure(message.fft_size, message.window);
+        configure_averaging(message.averaging, message.average_count);
         start();
     } else {
         stop();
     }
 }
 
+void SpectrumCollector::configure(const size_t requested_size, const SpectrumWindow new_window) {
+    size_t size = SpectrumStreamingConfigMessage::min_fft_size;
+    while ((size < requested_size) && (size < SpectrumStreamingConfigMessage::max_fft_size))
+        size <<= 1;
+
+    if ((size == fft_size_) && (new_window == window_type) && window) return;
+
+    // The baseband thread preempts this one; keep it away from the buffers.
+    streaming = false;
+    channel_spectrum_request_update = false;
+    history.reset();
+    channel_spectrum.reset();
+    window.reset();
+
+    {
+        const HeapReserve reserve{heap_reserve};
+        while (!allocate_buffers(size) && (size > SpectrumStreamingConfigMessage::min_fft_size))
+            size >>= 1;
+    }
+    // The smallest size may use the reserve.
+    if (!window && !allocate_buffers(size))
+        chDbgPanic("Out of Memory");
+
+    const auto shape = window_shape(new_window);
+    for (size_t i = 0; i <= size / 2; i++) {
+        float w = shape.terms[0];
+        for (size_t term = 1; term < shape.terms.size(); term++) {
+            const float c = shape.terms[term] * dsp::fft::cosine(term * i, size);
+            w += (term & 1) ? -c : c;
+        }
+        window[i] = static_cast<int16_t>(std::max(-1.0f, std::min(1.0f, w)) * 32767.0f);
+    }
+
+    fft_size_ = size;
+    window_type = new_window;
+    window_offset_q8 = shape.offset_q8;
+    history_index = 0;
+    history_sampling_rate = 0;
+}
+
+bool SpectrumCollector::allocate_buffers(const size_t size) {
+    history = try_make_unique<complex16_t>(size);
+    channel_spectrum = try_make_unique<complex16_t>(size);
+    window = try_make_unique<int16_t>(size / 2 + 1);
+    if (history && channel_spectrum && window)
+        return true;
+
+    history.reset();
+    channel_spectrum.reset();
+    window.reset();
+    return false;
+}
+
+void SpectrumCollector::configure_averaging(const SpectrumAveraging new_averaging, const size_t count) {
+    averaging = new_averaging;
+    average_count = std::max<size_t>(count, 1);
+    average_frames = 0;
+
+    if ((averaging != SpectrumAveraging::None) && !average)
+        average = std::make_unique<float[]>(spectrum_bins);
+
+    // Welch averaging wants at least half overlapping frames.
+    hop_size = (averaging == SpectrumAveraging::Welch) ? std::min(spectrum_bins, fft_size_ / 2) : spectrum_bins;
+}
+
 void SpectrumCollector::start() {
     streaming = true;
     ChannelSpectrumConfigMessage message{&fifo};
@@ -65,7 +162,7 @@ void SpectrumCollector::stop() {
 
 void SpectrumCollector::set_decimation_factor(
     const size_t decimation_factor) {
-    channel_spectrum_decimator.set_factor(decimation_factor);
+    this->decimation_factor = std::max<size_t>(decimation_factor, 1);
 }
 
 /* TODO: Refactor to register task with idle thread?
@@ -83,71 +180,123 @@ void SpectrumCollector::feed(
     channel_filter_high_frequency = filter_high_frequency;
     channel_filter_transition = filter_transition;
 
-    channel_spectrum_decimator.feed(
-        channel,
-        [this](const buffer_c16_t& data) {
-            this->post_message(data);
-        });
+    if (!streaming) return;
+
+    const uint32_t sampling_rate = channel.sampling_rate / decimation_factor;
+    if (sampling_rate != history_sampling_rate) {
+        history_sampling_rate = sampling_rate;
+        history_count = 0;
+        hop_count = 0;
+    }
+
+    /* NOTE: Input block size must be >= decimation factor */
+    const size_t mask = fft_size_ - 1;
+    for (size_t i = 0; i < channel.count; i += decimation_factor) {
+        history[history_index] = channel.p[i];
+        history_index = (history_index + 1) & mask;
+        if (history_count < fft_size_) history_count++;
+
+        if ((++hop_count >= hop_size) && (history_count == fft_size_)) {
+            post_message();
+            hop_count = 0;
+        }
+    }
 }
 
-void SpectrumCollector::post_message(const buffer_c16_t& data) {
+void SpectrumCollector::post_message() {
     // Called from baseband processing thread.
-    if (streaming && !channel_spectrum_request_update) {
-        fft_swap(data, channel_spectrum);
-        channel_spectrum_sampling_rate = data.sampling_rate;
+    if (!channel_spectrum_request_update) {
+        // Unroll the history, oldest sample first.
+        const size_t tail = fft_size_ - history_index;
+        std::copy_n(&history[history_index], tail, &channel_spectrum[0]);
+        std::copy_n(&history[0], history_index, &channel_spectrum[tail]);
+        channel_spectrum_sampling_rate = history_sampling_rate;
         channel_spectrum_request_update = true;
         EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
     }
 }
 
-template <typename T>
-static typename T::value_type spectrum_window_none(const T& s, const size_t i) {
-    constexpr size_t length = sizeof(s) / sizeof(s[0]);
-    static_assert(power_of_two(length), "Array length must be power of 2");
-    return s[i];
-};
-
-template <typename T>
-static typename T::value_type spectrum_window_hamming_3(const T& s, const size_t i) {
-    constexpr size_t length = sizeof(s) / sizeof(s[0]);
-    static_assert((length), "Array length must be power of 2");
-    constexpr size_t mask = length - 1;
-    // Three point Hamming window.
-    return s[i] * 0.54f + (s[(i - 1) & mask] + s[(i + 1) & mask]) * -0.23f;
-};
-
-template <typename T>
-static typename T::value_type spectrum_window_blackman_3(const T& s, const size_t i) {
-    constexpr size_t length = sizeof(s) / sizeof(s[0]);
-    static_assert(power_of_two(length), "Array length must be power of 2");
-    constexpr size_t mask = length - 1;
-    // Three term Blackman window.
-    constexpr float alpha = 0.42f;
-    constexpr float beta = 0.5f * 0.5f;
-    constexpr float gamma = 0.08f * 0.05f;
-    return s[i] * alpha - (s[(i - 1) & mask] + s[(i + 1) & mask]) * beta + (s[(i - 2) & mask] + s[(i + 2) & mask]) * gamma;
-};
-
 void SpectrumCollector::update() {
     // Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
     if (streaming && channel_spectrum_request_update) {
         /* Decimated buffer is full. Compute spectrum. */
-        fft_c_preswapped(channel_spectrum, 0, 8);
+        const size_t n = fft_size_;
+        auto* const bins = channel_spectrum.get();
+
+        // Block floating point: scale the frame up to the full 16 bits so
+        // the Q15 transform keeps the precision of quiet channels.
+        int32_t peak = 0;
+        for (size_t i = 0; i < n; i++)
+            peak = std::max<int32_t>(peak, std::max(std::abs(bins[i].real()), std::abs(bins[i].imag())));
+        const int32_t shift = (peak > 0) ? std::max(0, __builtin_clz(peak) - 17) : 0;
+
+        for (size_t i = 0; i < n; i++) {
+            const int32_t w = window[(i <= n / 2) ? i : n - i];
+            bins[i] = {
+                static_cast<int16_t>((bins[i].real() * w) >> (15 - shift)),
+                static_cast<int16_t>((bins[i].imag() * w) >> (15 - shift))};
+        }
+
+        dsp::fft::forward(bins, n);
 
         ChannelSpectrum spectrum;
         spectrum.sampling_rate = channel_spectrum_sampling_rate;
         spectrum.channel_filter_low_frequency = channel_filter_low_frequency;
         spectrum.channel_filter_high_frequency = channel_filter_high_frequency;
         spectrum.channel_filter_transition = channel_filter_transition;
+
+        // Undo the block scaling so frames with different shifts combine.
+        const float scale = 1.0f / (1UL << (2 * shift));
+        const bool first_frame = (average_frames == 0);
+        average_frames++;
+
+        // A Welch result goes out once per average_count frames; the other
+        // modes post their running state every frame.
+        const bool post = (averaging != SpectrumAveraging::Welch) || (average_frames >= average_count);
+
+        // Each display bin takes the peak of the transform bins centred on it.
+        const size_t group = n / spectrum_bins;
         for (size_t i = 0; i < spectrum.db.size(); i++) {
-            const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
-            const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
-            const float db = mag2_to_dbv_norm(mag2);
-            constexpr float mag_scale = 5.0f;
-            const unsigned int v = (db * mag_scale) + 255.0f;
-            spectrum.db[i] = std::max(0U, std::min(255U, v));
+            const size_t first = (i * group - group / 2) & (n - 1);
+            const size_t run = std::min(group, n - first);
+            float power = scale * std::max(
+                                      dsp::fft::peak_power(&bins[first], run),
+                                      dsp::fft::peak_power(&bins[0], group - run));
+
+            switch (averaging) {
+                case SpectrumAveraging::Welch:
+                    average[i] = first_frame ? power : average[i] + power;
+                    if (!post) continue;
+                    power = average[i] / average_frames;
+                    break;
+
+                case SpectrumAveraging::Exponential:
+                    average[i] = first_frame ? power : average[i] + (power - average[i]) / average_count;
+                    power = average[i];
+                    break;
+
+                case SpectrumAveraging::MaxHold:
+                    average[i] = first_frame ? power : std::max(average[i], power);
+                    power = average[i];
+                    break;
+
+                case SpectrumAveraging::MinHold:
+                    average[i] = first_frame ? power : std::min(average[i], power);
+                    power = average[i];
+                    break;
+
+                default:
+                    break;
+            }
+
+            const int32_t v_q8 = ((dsp::fft::log2_q8(power) * units_per_log2_q8) >> 8) + window_offset_q8;
+            spectrum.db[i] = std::max<int32_t>(0, std::min<int32_t>(255, v_q8 >> 8));
+        }
+
+        if (post) {
+            fifo.in(spectrum);
+            if (averaging == SpectrumAveraging::Welch) average_frames = 0;
         }
-        fifo.in(spectrum);
     }
 
     channel_spectrum_request_update = false;
@@ -28,10 +28,9 @@
 #include "dsp_types.hpp"
 #include "complex.hpp"
 
-#include "block_decimator.hpp"
-
 #include <cstdint>
 #include <array>
+#include <memory>
 
 #include "message.hpp"
 
@@ -41,6 +40,12 @@ class SpectrumCollector {
 
     void set_decimation_factor(const size_t decimation_factor);
 
+    /* Transform size in use. It may be smaller than requested when the
+     * heap could not hold the larger buffers. */
+    size_t fft_size() const {
+        return fft_size_;
+    }
+
     void feed(
         const buffer_c16_t& channel,
         const int32_t filter_low_frequency,
@@ -48,21 +53,50 @@ class SpectrumCollector {
         const int32_t filter_transition);
 
    private:
-    BlockDecimator<complex16_t, 256> channel_spectrum_decimator{1};
+    static constexpr size_t spectrum_bins = std::tuple_size<decltype(ChannelSpectrum::db)>::value;
+    static constexpr size_t heap_reserve = 4096;
+
     ChannelSpectrum fifo_data[1 << ChannelSpectrumConfigMessage::fifo_k]{};
     ChannelSpectrumFIFO fifo{fifo_data, ChannelSpectrumConfigMessage::fifo_k};
 
     volatile bool channel_spectrum_request_update{false};
-    bool streaming{false};
-    std::array<std::complex<float>, 256> channel_spectrum{};
+    volatile bool streaming{false};
+
+    /* The last fft_size samples. A frame is taken every spectrum_bins new
+     * samples, so larger transforms overlap instead of updating slower. */
+    std::unique_ptr<complex16_t[]> history{};
+    std::unique_ptr<complex16_t[]> channel_spectrum{};
+    /* First half of a periodic window, Q15. */
+    std::unique_ptr<int16_t[]> window{};
+    size_t fft_size_{0};
+    SpectrumWindow window_type{SpectrumWindow::Hann};
+    int32_t window_offset_q8{0};
+
+    /* Display bin powers carried between frames by the averaging modes. */
+    std::unique_ptr<float[]> average{};
+    SpectrumAveraging averaging{SpectrumAveraging::None};
+    size_t average_count{1};
+    size_t average_frames{0};
+
+    size_t decimation_factor{1};
+    uint32_t history_sampling_rate{0};
+    size_t history_index{0};
+    size_t history_count{0};
+    size_t hop_count{0};
+    size_t hop_size{spectrum_bins};
+
     uint32_t channel_spectrum_sampling_rate{0};
     int32_t channel_filter_low_frequency{0};
     int32_t channel_filter_high_frequency{0};
     int32_t channel_filter_transition{0};
 
-    void post_message(const buffer_c16_t& data);
+    void post_message();
 
     void set_state(const SpectrumStreamingConfigMessage& message);
+    void configure(const size_t requested_size, const SpectrumWindow new_window);
+    /* All or none of the FFT buffers for size points. */
+    bool allocate_buffers(const size_t size);
+    void configure_averaging(const SpectrumAveraging new_averaging, const size_t count);
     void start();
     void stop();
 
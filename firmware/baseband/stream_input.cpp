@@ -28,12 +28,13 @@ StreamInput::StreamInput(CaptureConfig* const config)
     : fifo_buffers_empty{buffers_empty.data(), buffer_count_max_log2},
       fifo_buffers_full{buffers_full.data(), buffer_count_max_log2},
       config{config},
-      data{std::make_unique<uint8_t[]>(config->write_size * config->buffer_count)} {
+      data{std::make_unique<uint8_t[]>(config->write_size * config->buffer_count + stream_buffer_alignment - 1)} {
     config->fifo_buffers_empty = &fifo_buffers_empty;
     config->fifo_buffers_full = &fifo_buffers_full;
 
+    const auto base = align_stream_buffer(data.get());
     for (size_t i = 0; i < config->buffer_count; i++) {
-        buffers[i] = {&(data.get()[i * config->write_size]), config->write_size};
+        buffers[i] = {&base[i * config->write_size], config->write_size};
         fifo_buffers_empty.in(&buffers[i]);
     }
 }
@@ -22,20 +22,33 @@
 
 #include "stream_output.hpp"
 
+#include "heap_allocation.hpp"
+
+#include <algorithm>
+#include <cstring>
+
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
-StreamOutput::StreamOutput(ReplayConfig* const config)
+StreamOutput::StreamOutput(ReplayConfig* const config, const size_t heap_reserve)
     : fifo_buffers_empty{buffers_empty.data(), buffer_count_max_log2},
       fifo_buffers_full{buffers_full.data(), buffer_count_max_log2},
-      config{config},
-      data{std::make_unique<uint8_t[]>(config->read_size * config->buffer_count)} {
+      config{config} {
+    size_t buffer_count = std::min(config->buffer_count, buffer_count_max);
+    data = allocate_fitting(buffer_count, config->read_size, heap_reserve, stream_buffer_alignment - 1);
+    config->buffer_count = buffer_count;
+    const auto base = align_stream_buffer(data.get());
+
+    // Without a copy, RepeatLast holes are filled with zeros.
+    if (config->fill_policy == ReplayFillPolicy::RepeatLast)
+        last_block = try_make_unique<uint8_t>(repeat_block_size_max);
+
     config->fifo_buffers_empty = &fifo_buffers_empty;
     config->fifo_buffers_full = &fifo_buffers_full;
 
     for (size_t i = 0; i < config->buffer_count; i++) {
         // Set buffers to point consecutively in previously allocated unique_ptr "data"
-        buffers[i] = {&(data.get()[i * config->read_size]), config->read_size};
+        buffers[i] = {&base[i * config->read_size], config->read_size};
         // Put all buffer pointers in the "empty buffer" FIFO
         fifo_buffers_empty.in(&buffers[i]);
     }
@@ -45,11 +58,11 @@ size_t StreamOutput::read(void* const data, const size_t length) {
     uint8_t* p = static_cast<uint8_t*>(data);
     size_t read = 0;
 
-    while (read < length) {
+    while (!underruns.aborted && read < length) {
         if (!active_buffer) {
             // We need a full buffer...
             if (!fifo_buffers_full.out(active_buffer)) {
-                // ...but none are available. Hole in transmission (inform app and stop ?)
+                // ...but none are available. Hole in transmission.
                 break;
             }
         }
@@ -70,7 +83,40 @@ size_t StreamOutput::read(void* const data, const size_t length) {
         }
     }
 
+    if (read < length)
+        fill_hole(p, read, length);
+
+    if (last_block) {
+        if (length <= repeat_block_size_max) {
+            memcpy(last_block.get(), p, length);
+            last_block_length = length;
+        } else {
+            last_block_length = 0;
+        }
+    }
+
     config->baseband_bytes_received += length;
 
     return read;
 }
+
+void StreamOutput::fill_hole(uint8_t* const p, const size_t offset, const size_t length) {
+    // Running off the end of the file is not an underrun.
+    if (!config->end_of_stream && !underruns.aborted) {
+        const auto position = config->baseband_bytes_received + offset;
+        if (underruns.count == 0)
+            underruns.first_position = position;
+        underruns.last_position = position;
+        underruns.count++;
+        underruns.bytes_filled += length - offset;
+
+        if (config->fill_policy == ReplayFillPolicy::Abort)
+            underruns.aborted = true;
+    }
+
+    if (last_block && !underruns.aborted && last_block_length >= length) {
+        memcpy(&p[offset], &last_block[offset], length - offset);
+    } else {
+        memset(&p[offset], 0, length - offset);
+    }
+}
@@ -33,15 +33,31 @@
 
 class StreamOutput {
    public:
-    StreamOutput(ReplayConfig* const config);
+    /* buffer_count is lowered in the config until the pool fits in one
+     * free block with heap_reserve bytes to spare, down to 0 if not even
+     * one buffer fits. RepeatLast's copy comes after the pool. */
+    StreamOutput(
+        ReplayConfig* const config,
+        const size_t heap_reserve = 0);
 
     StreamOutput(const StreamOutput&) = delete;
     StreamOutput(StreamOutput&&) = delete;
     StreamOutput& operator=(const StreamOutput&) = delete;
     StreamOutput& operator=(StreamOutput&&) = delete;
 
+    /* Returns the number of bytes taken from the stream. If the stream
+     * runs dry, the rest of data is filled according to the config's
+     * fill policy and the hole is recorded in underrun_statistics(). */
     size_t read(void* const data, const size_t length);
 
+    const ReplayUnderrunStatistics& underrun_statistics() const {
+        return underruns;
+    }
+
+    /* Longest read that RepeatLast can repeat: one 2048 sample C8 DMA
+     * transfer. Longer reads fill their holes with zeros. */
+    static constexpr size_t repeat_block_size_max = 4096;
+
    private:
     static constexpr size_t buffer_count_max_log2 = 3;
     static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
@@ -54,6 +70,13 @@ class StreamOutput {
     StreamBuffer* active_buffer{nullptr};
     ReplayConfig* const config{nullptr};
     std::unique_ptr<uint8_t[]> data{};
+    ReplayUnderrunStatistics underruns{};
+    /* Copy of the last block as it came off the stream. The caller may
+     * process its own buffer in place, so that can't be repeated. */
+    std::unique_ptr<uint8_t[]> last_block{};
+    size_t last_block_length{0};
+
+    void fill_hole(uint8_t* const p, const size_t offset, const size_t length);
 };
 
 #endif /*__STREAM_OUTPUT_H__*/
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "tx_gate.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+void TXGate::configure(const uint64_t on_samples, const uint64_t off_samples) {
+    on_samples_ = on_samples;
+    off_samples_ = off_samples;
+    reset();
+}
+
+size_t TXGate::apply(complex8_t* const p, const size_t count) {
+    if (!enabled())
+        return count;
+
+    const auto period = on_samples_ + off_samples_;
+    size_t keyed = 0;
+    size_t done = 0;
+
+    // Whole runs at a time; a 2048 sample block crosses at most a few edges.
+    while (done < count) {
+        const auto remaining = static_cast<uint64_t>(count - done);
+
+        if (position_ < on_samples_) {
+            const auto n = static_cast<size_t>(std::min(remaining, on_samples_ - position_));
+            keyed += n;
+            done += n;
+            position_ += n;
+        } else {
+            const auto n = static_cast<size_t>(std::min(remaining, period - position_));
+            memset(&p[done], 0, n * sizeof(complex8_t));
+            done += n;
+            position_ += n;
+        }
+
+        if (position_ == period)
+            position_ = 0;
+    }
+
+    return keyed;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __TX_GATE_H__
+#define __TX_GATE_H__
+
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+/* Sample-counted on/off keying for a transmit stream. Each period starts
+ * with on_samples of signal followed by off_samples of silence. The count
+ * runs on every sample handed to the DAC, so edges don't depend on
+ * when the data arrived. */
+class TXGate {
+   public:
+    void configure(const uint64_t on_samples, const uint64_t off_samples);
+
+    /* Restarts at the beginning of an on window. */
+    void reset() { position_ = 0; }
+
+    /* With either length zero the gate stays open. */
+    bool enabled() const { return on_samples_ != 0 && off_samples_ != 0; }
+    bool is_on() const { return !enabled() || position_ < on_samples_; }
+
+    /* Zeroes the samples that fall in an off window and advances the
+     * count. Returns the number of samples left keyed. */
+    size_t apply(complex8_t* const p, const size_t count);
+
+   private:
+    uint64_t on_samples_{0};
+    uint64_t off_samples_{0};
+    uint64_t position_{0};  // Within the current period.
+};
+
+#endif /*__TX_GATE_H__*/
@@ -845,7 +845,7 @@ bool_t sdc_lld_send_cmd_long_crc(SDCDriver* sdcp, uint8_t cmd, uint32_t arg, uin
  * @notapi
  */
 bool_t sdc_lld_read_aligned(SDCDriver* sdcp, uint32_t startblk, uint8_t* buf, uint32_t n) {
-    chDbgCheck((n <= (LPC_SDC_SDIO_DESCRIPTOR_COUNT * LPC_SDC_SDIO_MAX_DESCRIPTOR_BYTES / MMCSD_BLOCK_SIZE)), "max transaction size");
+    chDbgCheck((n <= LPC_SDC_SDIO_MAX_BLOCKS), "max transaction size");
 
     /* TODO: Handle SDHC block indexing? */
 
@@ -908,7 +908,7 @@ error:
  * @notapi
  */
 bool_t sdc_lld_write_aligned(SDCDriver* sdcp, uint32_t startblk, const uint8_t* buf, uint32_t n) {
-    chDbgCheck((n <= (LPC_SDC_SDIO_DESCRIPTOR_COUNT * LPC_SDC_SDIO_MAX_DESCRIPTOR_BYTES / MMCSD_BLOCK_SIZE)), "max transaction size");
+    chDbgCheck((n <= LPC_SDC_SDIO_MAX_BLOCKS), "max transaction size");
 
     /* Checks for errors and waits for the card to be ready for writing.*/
     if (_sdc_wait_for_transfer_state(sdcp))
@@ -969,7 +969,17 @@ error:
  * @notapi
  */
 bool_t sdc_lld_read(SDCDriver* sdcp, uint32_t startblk, uint8_t* buf, uint32_t n) {
-    return sdc_lld_read_aligned(sdcp, startblk, buf, n);
+    /* FatFs asks for up to a whole cluster at once, which can be more than
+     * one descriptor chain holds. */
+    while (n > 0) {
+        const uint32_t count = (n > LPC_SDC_SDIO_MAX_BLOCKS) ? LPC_SDC_SDIO_MAX_BLOCKS : n;
+        if (sdc_lld_read_aligned(sdcp, startblk, buf, count))
+            return CH_FAILED;
+        startblk += count;
+        buf += count * MMCSD_BLOCK_SIZE;
+        n -= count;
+    }
+    return CH_SUCCESS;
 }
 
 /**
@@ -987,7 +997,15 @@ bool_t sdc_lld_read(SDCDriver* sdcp, uint32_t startblk, uint8_t* buf, uint32_t n
  * @notapi
  */
 bool_t sdc_lld_write(SDCDriver* sdcp, uint32_t startblk, const uint8_t* buf, uint32_t n) {
-    return sdc_lld_write_aligned(sdcp, startblk, buf, n);
+    while (n > 0) {
+        const uint32_t count = (n > LPC_SDC_SDIO_MAX_BLOCKS) ? LPC_SDC_SDIO_MAX_BLOCKS : n;
+        if (sdc_lld_write_aligned(sdcp, startblk, buf, count))
+            return CH_FAILED;
+        startblk += count;
+        buf += count * MMCSD_BLOCK_SIZE;
+        n -= count;
+    }
+    return CH_SUCCESS;
 }
 
 /**
@@ -191,6 +191,13 @@ struct SDCDriver {
 
 #define LPC_SDC_SDIO_MAX_DESCRIPTOR_BYTES 0x1000
 
+/**
+ * @brief   Most blocks one read or write command can move through the
+ *          descriptor chain. Larger transfers are split.
+ */
+#define LPC_SDC_SDIO_MAX_BLOCKS \
+    (LPC_SDC_SDIO_DESCRIPTOR_COUNT * LPC_SDC_SDIO_MAX_DESCRIPTOR_BYTES / MMCSD_BLOCK_SIZE)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
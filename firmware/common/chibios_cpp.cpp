@@ -22,6 +22,7 @@
 #include "chibios_cpp.hpp"
 
 #include <cstdint>
+#include <new>
 
 #include <ch.h>
 
@@ -39,6 +40,15 @@ void* operator new[](size_t size) {
     return p;
 }
 
+/* For allocations that can fall back to something smaller. */
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return chHeapAlloc(0x0, size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return chHeapAlloc(0x0, size);
+}
+
 void operator delete(void* p) noexcept {
     chHeapFree(p);
 }
@@ -21,3 +21,246 @@
 
 #include "dsp_fft.hpp"
 #include "complex.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dsp {
+namespace fft {
+
+namespace {
+
+constexpr size_t quarter = max_size / 4;
+
+/* sin(x) for x in [0, pi/2], built at compile time. */
+constexpr double sine(const double x) {
+    double term = x;
+    double sum = x;
+    for (int i = 1; i < 12; i++) {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double pi = 3.14159265358979323846;
+
+constexpr std::array<float, quarter + 1> make_sine_float() {
+    std::array<float, quarter + 1> table{};
+    for (size_t k = 0; k <= quarter; k++)
+        table[k] = sine(k * pi / 2 / quarter);
+    return table;
+}
+
+constexpr std::array<int16_t, quarter + 1> make_sine_q15() {
+    std::array<int16_t, quarter + 1> table{};
+    for (size_t k = 0; k <= quarter; k++)
+        table[k] = static_cast<int16_t>(sine(k * pi / 2 / quarter) * 32767.0 + 0.5);
+    return table;
+}
+
+/* Quarter wave sine tables; every twiddle of a transform up to max_size
+ * is read from these. */
+constexpr auto sine_float = make_sine_float();
+constexpr auto sine_q15 = make_sine_q15();
+
+template <typename T>
+struct Twiddle {
+    T re;
+    T im;
+};
+
+/* e^(-2 pi i k / max_size) for k < 3/4 max_size. */
+template <typename T>
+Twiddle<T> twiddle(const std::array<T, quarter + 1>& table, const size_t k) {
+    if (k <= quarter) {
+        return {table[quarter - k], static_cast<T>(-table[k])};
+    } else if (k <= 2 * quarter) {
+        return {static_cast<T>(-table[k - quarter]), static_cast<T>(-table[2 * quarter - k])};
+    } else {
+        return {static_cast<T>(-table[3 * quarter - k]), table[k - 2 * quarter]};
+    }
+}
+
+/* Radix-4 butterflies of span q: two radix-2 DIF stages fused, with the
+ * outputs left where those stages would put them. */
+void radix4_pass(std::complex<float>* const data, const size_t n, const size_t q) {
+    const size_t stride = max_size / (4 * q);
+
+    for (size_t i = 0; i < n; i += 4 * q) {
+        auto* const x = &data[i];
+        const auto a0 = x[0] + x[2 * q];
+        const auto a2 = x[0] - x[2 * q];
+        const auto a1 = x[q] + x[3 * q];
+        const auto a3 = x[q] - x[3 * q];
+        const std::complex<float> b3{a3.imag(), -a3.real()};
+        x[0] = a0 + a1;
+        x[q] = a0 - a1;
+        x[2 * q] = a2 + b3;
+        x[3 * q] = a2 - b3;
+    }
+
+    for (size_t j = 1; j < q; j++) {
+        const auto t1 = twiddle(sine_float, j * stride);
+        const auto t2 = twiddle(sine_float, 2 * j * stride);
+        const auto t3 = twiddle(sine_float, 3 * j * stride);
+        const std::complex<float> w1{t1.re, t1.im};
+        const std::complex<float> w2{t2.re, t2.im};
+        const std::complex<float> w3{t3.re, t3.im};
+
+        for (size_t i = j; i < n; i += 4 * q) {
+            auto* const x = &data[i];
+            const auto a0 = x[0] + x[2 * q];
+            const auto a2 = x[0] - x[2 * q];
+            const auto a1 = x[q] + x[3 * q];
+            const auto a3 = x[q] - x[3 * q];
+            const std::complex<float> b3{a3.imag(), -a3.real()};
+            x[0] = a0 + a1;
+            x[q] = (a0 - a1) * w2;
+            x[2 * q] = (a2 + b3) * w1;
+            x[3 * q] = (a2 - b3) * w3;
+        }
+    }
+}
+
+void radix2_pass(std::complex<float>* const data, const size_t n) {
+    for (size_t i = 0; i < n; i += 2) {
+        const auto u = data[i];
+        const auto v = data[i + 1];
+        data[i] = u + v;
+        data[i + 1] = u - v;
+    }
+}
+
+int16_t saturate(const int32_t v) {
+#if defined(__ARM_FEATURE_DSP)
+    return __SSAT(v, 16);
+#else
+    return static_cast<int16_t>(std::max<int32_t>(-32768, std::min<int32_t>(32767, v)));
+#endif
+}
+
+complex16_t multiply(const int32_t re, const int32_t im, const Twiddle<int16_t> w) {
+    return {
+        saturate((re * w.re - im * w.im) >> 15),
+        saturate((re * w.im + im * w.re) >> 15)};
+}
+
+/* Each output is a sum of four inputs, so the pass scales by 1/4 to stay
+ * inside 16 bits; the twiddle products are taken after the scaling. */
+void radix4_pass(complex16_t* const data, const size_t n, const size_t q) {
+    const size_t stride = max_size / (4 * q);
+
+    for (size_t j = 0; j < q; j++) {
+        const auto w1 = twiddle(sine_q15, j * stride);
+        const auto w2 = twiddle(sine_q15, 2 * j * stride);
+        const auto w3 = twiddle(sine_q15, 3 * j * stride);
+
+        for (size_t i = j; i < n; i += 4 * q) {
+            auto* const x = &data[i];
+            const int32_t a0r = x[0].real() + x[2 * q].real();
+            const int32_t a0i = x[0].imag() + x[2 * q].imag();
+            const int32_t a2r = x[0].real() - x[2 * q].real();
+            const int32_t a2i = x[0].imag() - x[2 * q].imag();
+            const int32_t a1r = x[q].real() + x[3 * q].real();
+            const int32_t a1i = x[q].imag() + x[3 * q].imag();
+            const int32_t a3r = x[q].real() - x[3 * q].real();
+            const int32_t a3i = x[q].imag() - x[3 * q].imag();
+
+            x[0] = {static_cast<int16_t>((a0r + a1r) >> 2), static_cast<int16_t>((a0i + a1i) >> 2)};
+            if (j == 0) {
+                x[q] = {static_cast<int16_t>((a0r - a1r) >> 2), static_cast<int16_t>((a0i - a1i) >> 2)};
+                x[2 * q] = {static_cast<int16_t>((a2r + a3i) >> 2), static_cast<int16_t>((a2i - a3r) >> 2)};
+                x[3 * q] = {static_cast<int16_t>((a2r - a3i) >> 2), static_cast<int16_t>((a2i + a3r) >> 2)};
+            } else {
+                x[q] = multiply((a0r - a1r) >> 2, (a0i - a1i) >> 2, w2);
+                x[2 * q] = multiply((a2r + a3i) >> 2, (a2i - a3r) >> 2, w1);
+                x[3 * q] = multiply((a2r - a3i) >> 2, (a2i + a3r) >> 2, w3);
+            }
+        }
+    }
+}
+
+void radix2_pass(complex16_t* const data, const size_t n) {
+    for (size_t i = 0; i < n; i += 2) {
+        const int32_t ur = data[i].real();
+        const int32_t ui = data[i].imag();
+        const int32_t vr = data[i + 1].real();
+        const int32_t vi = data[i + 1].imag();
+        data[i] = {static_cast<int16_t>((ur + vr) >> 1), static_cast<int16_t>((ui + vi) >> 1)};
+        data[i + 1] = {static_cast<int16_t>((ur - vr) >> 1), static_cast<int16_t>((ui - vi) >> 1)};
+    }
+}
+
+template <typename T>
+void run_passes(T* const data, const size_t n, const size_t from, const size_t to) {
+    const size_t k = log_2(n);
+    const size_t radix4_passes = k / 2;
+
+    for (size_t pass = from; (pass < to) && (pass < pass_count(n)); pass++) {
+        if (pass < radix4_passes)
+            radix4_pass(data, n, n >> (2 * pass + 2));
+        else
+            radix2_pass(data, n);
+    }
+}
+
+/* log2(1 + x) for x in [0, 1), as 2 atanh(x / (2 + x)) / ln(2). */
+constexpr double log2_1p(const double x) {
+    const double y = x / (2 + x);
+    double term = y;
+    double sum = 0;
+    for (int i = 0; i < 20; i++) {
+        sum += term / (2 * i + 1);
+        term *= y * y;
+    }
+    return 2 * sum / 0.69314718055994530942;
+}
+
+constexpr size_t log2_mantissa_bits = 6;
+
+constexpr std::array<uint8_t, 1 << log2_mantissa_bits> make_log2_table() {
+    constexpr size_t entries = 1 << log2_mantissa_bits;
+    std::array<uint8_t, entries> table{};
+    for (size_t i = 0; i < entries; i++)
+        table[i] = static_cast<uint8_t>(256 * log2_1p((i + 0.5) / entries) + 0.5);
+    return table;
+}
+
+/* Fractional part of log2, indexed by the mantissa bits below the leading one. */
+constexpr auto log2_table = make_log2_table();
+
+} /* namespace */
+
+float cosine(const size_t k, const size_t n) {
+    const size_t m = (k & (n - 1)) * (max_size / n);
+    if (m < 3 * quarter) return twiddle(sine_float, m).re;
+    return sine_float[m - 3 * quarter];
+}
+
+uint32_t peak_power(const complex16_t* const bins, const size_t count) {
+    uint32_t peak = 0;
+    for (size_t i = 0; i < count; i++)
+        peak = std::max(peak, power(bins[i]));
+    return peak;
+}
+
+int32_t log2_q8(const float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+
+    const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127;
+    const uint32_t mantissa = (bits >> (23 - log2_mantissa_bits)) & (log2_table.size() - 1);
+    return exponent * 256 + log2_table[mantissa];
+}
+
+void passes(std::complex<float>* const data, const size_t n, const size_t from, const size_t to) {
+    run_passes(data, n, from, to);
+}
+
+void passes(complex16_t* const data, const size_t n, const size_t from, const size_t to) {
+    run_passes(data, n, from, to);
+}
+
+} /* namespace fft */
+} /* namespace dsp */
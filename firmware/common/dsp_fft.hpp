@@ -174,4 +174,84 @@ void ifft(T* v, int n, T* tmp) {
     return;
 }
 
+namespace dsp {
+namespace fft {
+
+/* Largest transform the twiddle tables cover. */
+constexpr size_t max_size = 4096;
+
+/* A size n transform runs log2(n) / 2 radix-4 passes, plus a final
+ * radix-2 pass when log2(n) is odd. */
+constexpr size_t pass_count(const size_t n) {
+    return (log_2(n) + 1) / 2;
+}
+
+/* Runs passes [from, to) of an in-place decimation in frequency transform
+ * of natural order input, so callers can spread the work over several
+ * buffers. The bins come out in bit reversed order; call bit_reverse()
+ * after the last pass. The Q15 variant scales each radix-4 pass by 1/4
+ * and the radix-2 pass by 1/2, so its result is the DFT divided by n. */
+void passes(std::complex<float>* const data, const size_t n, const size_t from, const size_t to);
+void passes(complex16_t* const data, const size_t n, const size_t from, const size_t to);
+
+template <typename T>
+void bit_reverse(T* const data, const size_t n) {
+    for (size_t i = 0, j = 0; i < n; i++) {
+        if (i < j) std::swap(data[i], data[j]);
+
+        size_t bit = n >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+}
+
+template <typename T>
+void forward(T* const data, const size_t n) {
+    passes(data, n, 0, pass_count(n));
+    bit_reverse(data, n);
+}
+
+template <typename T, size_t N>
+void forward(std::array<T, N>& data) {
+    static_assert(power_of_two(N) && (N >= 2) && (N <= max_size), "FFT size must be a power of two up to max_size");
+    forward(data.data(), N);
+}
+
+/* cos(2 pi k / n) from the twiddle table, for power of two n up to
+ * max_size. */
+float cosine(const size_t k, const size_t n);
+
+/* |v|^2 of a Q15 bin: a single SMUAD on the M4. */
+inline uint32_t power(const complex16_t v) {
+#if defined(__ARM_FEATURE_DSP)
+    return __SMUAD(v.__rep(), v.__rep());
+#else
+    return v.real() * v.real() + v.imag() * v.imag();
+#endif
+}
+
+/* Largest |v|^2 of count consecutive bins. */
+uint32_t peak_power(const complex16_t* const bins, const size_t count);
+
+/* 256 * log2(x) for x >= 0, good to about 0.05 dB once scaled to
+ * decibels. Zero maps to about -127 * 256. */
+int32_t log2_q8(const float x);
+
+/* Copies a block into natural order transform input. */
+template <typename T, size_t N>
+void load(const buffer_c16_t src, std::array<T, N>& dst) {
+    for (size_t i = 0; i < N; i++) {
+        const auto s = src.p[i];
+        dst[i] = {
+            static_cast<typename T::value_type>(s.real()),
+            static_cast<typename T::value_type>(s.imag())};
+    }
+}
+
+} /* namespace fft */
+} /* namespace dsp */
+
 #endif /*__DSP_FFT_H__*/
@@ -1204,6 +1204,43 @@ constexpr fir_taps_real<16> taps_40k_wfm_decim_1 = {
     }},
 };
 
+// Channelizer front end ///////////////////////////////////////////////////
+
+// IFIR image-reject filter: fs=3200000, pass=200000, stop=600000, decim=4, fout=800000
+// Kaiser (beta 5) windowed sinc, cutoff 354167. Keeps the centre 400 kHz of the
+// filter bank input within 0.5 dB and anything folding onto it 55 dB down.
+constexpr fir_taps_real<24> taps_400k_channelizer_decim_0 = {
+    .low_frequency_normalized = -200000.0f / 3200000.0f,
+    .high_frequency_normalized = 200000.0f / 3200000.0f,
+    .transition_normalized = 400000.0f / 3200000.0f,
+    .taps = {{
+        33,
+        73,
+        54,
+        -108,
+        -423,
+        -730,
+        -700,
+        20,
+        1572,
+        3705,
+        5795,
+        7093,
+        7093,
+        5795,
+        3705,
+        1572,
+        20,
+        -700,
+        -730,
+        -423,
+        -108,
+        54,
+        73,
+        33,
+    }},
+};
+
 // TPMS decimation filters ////////////////////////////////////////////////
 
 // IFIR image-reject filter: fs=2457600, pass=100000, stop=407200, decim=4, fout=614400
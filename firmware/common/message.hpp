@@ -127,7 +127,18 @@ class Message {
         FreqChangeCommand = 70,
         I2CDevListChanged = 71,
         LightData = 72,
-        CyclicTxCtr = 73,
+        TXGateConfig = 73,
+        TXUnderrun = 74,
+        SigGenStatistics = 75,
+        SigGenCarrier = 76,
+        AWGConfig = 77,
+        AWGData = 78,
+        ReplayRateConfig = 79,
+        ReplayMixerConfig = 80,
+        ReplayThreadNext = 81,
+        CaptureStatistics = 82,
+        ChannelizerConfigure = 83,
+        ChannelizerStatus = 84,
         MAX
     };
 
@@ -252,6 +263,24 @@ class AudioStatisticsMessage : public Message {
     AudioStatistics statistics;
 };
 
+/* Time domain windows for the channel spectrum FFT. */
+enum class SpectrumWindow : uint8_t {
+    Hann = 0,
+    BlackmanHarris = 1,
+    FlatTop = 2,
+};
+
+/* How the channel spectrum combines successive FFTs before posting. */
+enum class SpectrumAveraging : uint8_t {
+    None = 0,
+    /* Linear power mean of average_count overlapping FFTs. */
+    Welch = 1,
+    /* Running mean weighted 1 / average_count towards each new FFT. */
+    Exponential = 2,
+    MaxHold = 3,
+    MinHold = 4,
+};
+
 class SpectrumStreamingConfigMessage : public Message {
    public:
     enum class Mode : uint32_t {
@@ -259,13 +288,30 @@ class SpectrumStreamingConfigMessage : public Message {
         Running = 1,
     };
 
+    static constexpr size_t min_fft_size = 256;
+    static constexpr size_t max_fft_size = 2048;
+
     constexpr SpectrumStreamingConfigMessage(
-        Mode mode)
+        Mode mode,
+        size_t fft_size = min_fft_size,
+        SpectrumWindow window = SpectrumWindow::Hann,
+        SpectrumAveraging averaging = SpectrumAveraging::None,
+        uint8_t average_count = 1)
         : Message{ID::SpectrumStreamingConfig},
-          mode{mode} {
+          mode{mode},
+          fft_size{fft_size},
+          window{window},
+          averaging{averaging},
+          average_count{average_count} {
     }
 
     Mode mode{Mode::Stopped};
+    /* The spectrum always has 256 bins; larger transforms narrow each
+     * bin's resolution bandwidth and report the peak of the bins it spans. */
+    size_t fft_size{min_fft_size};
+    SpectrumWindow window{SpectrumWindow::Hann};
+    SpectrumAveraging averaging{SpectrumAveraging::None};
+    uint8_t average_count{1};
 };
 
 class WidebandSpectrumConfigMessage : public Message {
@@ -613,6 +659,16 @@ class AMConfigureMessage : public Message {
 };
 
 // TODO: Put this somewhere else, or at least the implementation part.
+/* Stream buffers start on an SD sector boundary. FatFs passes whole
+ * sectors of them straight to the SDIO DMA, without its sector window. */
+constexpr size_t stream_buffer_alignment = 512;
+
+/* Pool allocations carry stream_buffer_alignment - 1 spare bytes. */
+inline uint8_t* align_stream_buffer(uint8_t* const p) {
+    const auto address = reinterpret_cast<uintptr_t>(p);
+    return reinterpret_cast<uint8_t*>((address + stream_buffer_alignment - 1) & ~(stream_buffer_alignment - 1));
+}
+
 class StreamBuffer {
     uint8_t* data_;
     size_t used_;
@@ -670,6 +726,21 @@ class StreamBuffer {
     }
 };
 
+/* Holds a capture back until the last output blocks match a pattern of
+ * on/off states, a block being on when its mean power is above the
+ * threshold. Bit 0 of the pattern is the newest block. The blocks before
+ * the trigger are kept and written first. A zero mask starts at once. */
+struct CaptureTriggerConfig {
+    uint32_t power_threshold{0};  // Mean I^2 + Q^2 of a block of C16 samples.
+    uint32_t pattern_mask{0};
+    uint32_t pattern{0};
+    uint32_t pre_trigger_bytes{0};  // Lowered by the baseband to what it can keep.
+
+    constexpr bool enabled() const {
+        return pattern_mask != 0;
+    }
+};
+
 struct CaptureConfig {
     const size_t write_size;
     const size_t buffer_count;
@@ -677,16 +748,21 @@ struct CaptureConfig {
     uint64_t baseband_bytes_dropped;
     FIFO<StreamBuffer*>* fifo_buffers_empty;
     FIFO<StreamBuffer*>* fifo_buffers_full;
+    CaptureTriggerConfig trigger;
+    bool trigger_fired;
 
     constexpr CaptureConfig(
         const size_t write_size,
-        const size_t buffer_count)
+        const size_t buffer_count,
+        const CaptureTriggerConfig& trigger = {})
         : write_size{write_size},
           buffer_count{buffer_count},
           baseband_bytes_received{0},
           baseband_bytes_dropped{0},
           fifo_buffers_empty{nullptr},
-          fifo_buffers_full{nullptr} {
+          fifo_buffers_full{nullptr},
+          trigger{trigger},
+          trigger_fired{false} {
     }
 
     size_t dropped_percent() const {
@@ -694,7 +770,7 @@ struct CaptureConfig {
             return 0;
         } else {
             const size_t percent = baseband_bytes_dropped * 100U / baseband_bytes_received;
-            return std::max(1U, percent);
+            return std::max<size_t>(1U, percent);
         }
     }
 };
@@ -710,24 +786,45 @@ class CaptureConfigMessage : public Message {
     CaptureConfig* const config;
 };
 
+/* What the baseband puts in the transmit buffer when the application
+ * could not supply a full stream buffer in time. */
+enum class ReplayFillPolicy : uint8_t {
+    Zero = 0,        // Transmit silence for the missing samples.
+    RepeatLast = 1,  // Re-transmit the matching part of the previous block.
+    Abort = 2,       // Transmit silence and stop consuming the stream.
+};
+
 struct ReplayConfig {
-    const size_t read_size;
-    const size_t buffer_count;
+    size_t read_size;
+    size_t buffer_count;  // The baseband may lower this to fit its heap.
+    const ReplayFillPolicy fill_policy;
     uint64_t baseband_bytes_received;
+    bool end_of_stream;
     FIFO<StreamBuffer*>* fifo_buffers_empty;
     FIFO<StreamBuffer*>* fifo_buffers_full;
 
     constexpr ReplayConfig(
         const size_t read_size,
-        const size_t buffer_count)
+        const size_t buffer_count,
+        const ReplayFillPolicy fill_policy = ReplayFillPolicy::Zero)
         : read_size{read_size},
           buffer_count{buffer_count},
+          fill_policy{fill_policy},
           baseband_bytes_received{0},
+          end_of_stream{false},
           fifo_buffers_empty{nullptr},
           fifo_buffers_full{nullptr} {
     }
 };
 
+struct ReplayUnderrunStatistics {
+    uint32_t count{0};           // Number of reads that hit a hole.
+    uint64_t bytes_filled{0};    // Bytes supplied by the fill policy.
+    uint64_t first_position{0};  // Stream byte offset of the first hole.
+    uint64_t last_position{0};   // Stream byte offset of the latest hole.
+    bool aborted{false};
+};
+
 class ReplayConfigMessage : public Message {
    public:
     constexpr ReplayConfigMessage(
@@ -739,6 +836,39 @@ class ReplayConfigMessage : public Message {
     ReplayConfig* const config;
 };
 
+/* Converts a capture recorded at input_rate to the baseband rate. */
+class ReplayRateConfigMessage : public Message {
+   public:
+    constexpr ReplayRateConfigMessage(
+        const uint32_t input_rate,
+        const uint32_t output_rate)
+        : Message{ID::ReplayRateConfig},
+          input_rate(input_rate),
+          output_rate(output_rate) {
+    }
+
+    const uint32_t input_rate;
+    const uint32_t output_rate;
+};
+
+/* Frequency shift and digital gain applied to the replayed samples. */
+class ReplayMixerConfigMessage : public Message {
+   public:
+    constexpr ReplayMixerConfigMessage(
+        const int32_t frequency_offset,
+        const int8_t gain_db,
+        const bool soft_clip)
+        : Message{ID::ReplayMixerConfig},
+          frequency_offset(frequency_offset),
+          gain_db(gain_db),
+          soft_clip(soft_clip) {
+    }
+
+    const int32_t frequency_offset;
+    const int8_t gain_db;
+    const bool soft_clip;
+};
+
 class TXProgressMessage : public Message {
    public:
     constexpr TXProgressMessage()
@@ -749,6 +879,15 @@ class TXProgressMessage : public Message {
     bool done = false;
 };
 
+class TXUnderrunMessage : public Message {
+   public:
+    constexpr TXUnderrunMessage()
+        : Message{ID::TXUnderrun} {
+    }
+
+    ReplayUnderrunStatistics statistics{};
+};
+
 class AFSKRxConfigureMessage : public Message {
    public:
     constexpr AFSKRxConfigureMessage(
@@ -908,18 +1047,78 @@ enum class OversampleRate : uint8_t {
     x64 = 64,
 };
 
+/* How the capture decimation chain splits the oversample rate into FIR
+ * stages. Fast uses the fewest stages, Sharp the most and smallest. */
+enum class DecimationFilter : uint8_t {
+    Standard = 0,
+    Fast = 1,
+    Sharp = 2,
+};
+
 class SampleRateConfigMessage : public Message {
    public:
     constexpr SampleRateConfigMessage(
         uint32_t sample_rate,
-        OversampleRate oversample_rate)
+        OversampleRate oversample_rate,
+        DecimationFilter filter = DecimationFilter::Standard)
         : Message{ID::SampleRateConfig},
           sample_rate(sample_rate),
-          oversample_rate(oversample_rate) {
+          oversample_rate(oversample_rate),
+          filter(filter) {
     }
 
     const uint32_t sample_rate = 0;
     const OversampleRate oversample_rate = OversampleRate::None;
+    const DecimationFilter filter = DecimationFilter::Standard;
+};
+
+/* M4 cost of the capture decimation chain, about once a second. */
+class CaptureStatisticsMessage : public Message {
+   public:
+    constexpr CaptureStatisticsMessage()
+        : Message{ID::CaptureStatistics} {
+    }
+
+    uint32_t cycles_average = 0;  // Per buffer.
+    uint8_t load_percent = 0;     // Of the time between buffers.
+};
+
+/* Channel c of the channelizer is centred on the tuned frequency plus
+ * (c - channel_count / 2) * channel_spacing. */
+class ChannelizerConfigureMessage : public Message {
+   public:
+    static constexpr size_t channel_count = 16;
+    static constexpr int32_t channel_spacing = 25000;
+    static constexpr size_t max_routes = 4;
+
+    constexpr ChannelizerConfigureMessage(
+        const uint16_t route_mask,
+        const uint8_t squelch_db,
+        const size_t deviation)
+        : Message{ID::ChannelizerConfigure},
+          route_mask{route_mask},
+          squelch_db{squelch_db},
+          deviation{deviation} {
+    }
+
+    /* Channels to demodulate; only the lowest max_routes set bits count. */
+    const uint16_t route_mask;
+    /* Open threshold above the noise floor, 0 leaves every channel open. */
+    const uint8_t squelch_db;
+    const size_t deviation;
+};
+
+/* Per channel power and squelch state, about ten times a second. */
+class ChannelizerStatusMessage : public Message {
+   public:
+    constexpr ChannelizerStatusMessage()
+        : Message{ID::ChannelizerStatus} {
+    }
+
+    std::array<int8_t, ChannelizerConfigureMessage::channel_count> power_db{};  // dBFS
+    int8_t noise_floor_db = 0;
+    uint16_t open_mask = 0;    // Channels above the squelch threshold.
+    uint16_t routed_mask = 0;  // Channels feeding the audio output.
 };
 
 class AudioLevelReportMessage : public Message {
@@ -972,21 +1171,38 @@ class AudioTXConfigMessage : public Message {
     const bool lsb_enabled;
 };
 
+/* Arbitrary waveform tables for the tone SigGen, played at the tone rate. */
+enum class AWGFormat : uint8_t {
+    Real = 0,  // int8 samples
+    IQ = 1,    // C8 samples
+};
+
+enum class AWGModulation : uint8_t {
+    FM = 0,      // Real part deviates the carrier.
+    AM = 1,      // Real part is the envelope.
+    Direct = 2,  // Table sent as baseband, real tables on I only.
+};
+
+constexpr size_t awg_table_max_bytes = 16384;
+
 class SigGenConfigMessage : public Message {
    public:
     constexpr SigGenConfigMessage(
         const uint32_t bw,
         const uint32_t shape,
-        const uint32_t duration)
+        const uint32_t duration,
+        const AWGModulation awg_modulation = AWGModulation::FM)
         : Message{ID::SigGenConfig},
           bw(bw),
           shape(shape),
-          duration(duration) {
+          duration(duration),
+          awg_modulation(awg_modulation) {
     }
 
     const uint32_t bw;
     const uint32_t shape;
     const uint32_t duration;
+    const AWGModulation awg_modulation;
 };
 
 class SigGenToneMessage : public Message {
@@ -1000,6 +1216,62 @@ class SigGenToneMessage : public Message {
     const uint32_t tone_delta;
 };
 
+/* CW carrier offset from the tuned frequency and dsp::DDS::Mode. */
+class SigGenCarrierMessage : public Message {
+   public:
+    constexpr SigGenCarrierMessage(
+        const int32_t offset,
+        const uint8_t mode)
+        : Message{ID::SigGenCarrier},
+          offset(offset),
+          mode(mode) {
+    }
+
+    const int32_t offset;
+    const uint8_t mode;
+};
+
+class AWGConfigMessage : public Message {
+   public:
+    constexpr AWGConfigMessage(
+        const AWGFormat format,
+        const uint32_t length)
+        : Message{ID::AWGConfig},
+          format(format),
+          length(length) {
+    }
+
+    const AWGFormat format;
+    const uint32_t length;  // In samples, zero frees the table.
+};
+
+/* A chunk of the table, passed in shared_memory.bb_data.data. */
+class AWGDataMessage : public Message {
+   public:
+    constexpr AWGDataMessage(
+        const uint32_t offset,
+        const uint32_t size)
+        : Message{ID::AWGData},
+          offset(offset),
+          size(size) {
+    }
+
+    const uint32_t offset;
+    const uint32_t size;
+};
+
+/* Cost of the tone generator kernel in M4 cycles per buffer. */
+class SigGenStatisticsMessage : public Message {
+   public:
+    constexpr SigGenStatisticsMessage()
+        : Message{ID::SigGenStatistics} {
+    }
+
+    uint32_t shape = 0;
+    uint32_t cycles_average = 0;
+    uint32_t cycles_peak = 0;
+};
+
 class AFSKTxConfigureMessage : public Message {
    public:
     constexpr AFSKTxConfigureMessage(
@@ -1219,6 +1491,19 @@ class ReplayThreadDoneMessage : public Message {
     uint32_t return_code;
 };
 
+/* A queued stream took over; its samples start at stream_offset
+ * in the TXProgress byte count. */
+class ReplayThreadNextMessage : public Message {
+   public:
+    constexpr ReplayThreadNextMessage(
+        uint32_t stream_offset = 0)
+        : Message{ID::ReplayThreadNext},
+          stream_offset{stream_offset} {
+    }
+
+    uint32_t stream_offset;
+};
+
 class SpectrumPainterBufferConfigureRequestMessage : public Message {
    public:
     constexpr SpectrumPainterBufferConfigureRequestMessage(
@@ -1439,13 +1724,20 @@ class I2CDevListChangedMessage : public Message {
 };
 
 
-class CyclicTXCtrMessage : public Message {
+/* On/off keying of the replayed stream, in samples at the baseband rate.
+ * Either length zero transmits continuously. */
+class TXGateConfigMessage : public Message {
    public:
-    constexpr CyclicTXCtrMessage()
-        : Message{ID::CyclicTxCtr} {
+    constexpr TXGateConfigMessage(
+        const uint64_t on_samples,
+        const uint64_t off_samples)
+        : Message{ID::TXGateConfig},
+          on_samples{on_samples},
+          off_samples{off_samples} {
     }
 
-    bool CyclicTXCtr = FALSE;
+    const uint64_t on_samples;
+    const uint64_t off_samples;
 };
 
 #endif /*__MESSAGE_H__*/
@@ -65,6 +65,24 @@ inline OversampleRate get_oversample_rate(uint32_t sample_rate) {
     return OversampleRate::x4;  // Top range (1.25Mhz ... 5.5Mhz).
 }
 
+/* Range of rates a capture may ask the radio for with a chosen oversample
+ * rate. The minimum is the lowest rate the table itself uses, well clear
+ * of the ~400kHz functional minimum. */
+constexpr uint32_t min_oversampled_rate = 800'000;
+constexpr uint32_t max_oversampled_rate = 20'000'000;
+
+/* Gets the oversample rate for a capture that asks for its own decimation.
+ * None, or a rate the radio can't sample at, falls back to the table. */
+inline OversampleRate get_oversample_rate(uint32_t sample_rate, OversampleRate requested) {
+    const auto table_rate = get_oversample_rate(sample_rate);
+    if (requested == OversampleRate::None || requested == table_rate)
+        return table_rate;
+
+    const uint64_t radio_rate = static_cast<uint64_t>(sample_rate) * toUType(requested);
+    const bool supported = (radio_rate >= min_oversampled_rate) && (radio_rate <= max_oversampled_rate);
+    return supported ? requested : table_rate;
+}
+
 /* Gets the actual sample rate for a given sample rate.
  * This is the rate with the correct oversampling rate applied. */
 inline uint32_t get_actual_sample_rate(uint32_t sample_rate) {
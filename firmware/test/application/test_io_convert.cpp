@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "io_convert.hpp"
+#include "complex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+/* The one-sample-at-a-time converters the word versions must match. */
+void reference_c16_to_c8(complex16_t* data, size_t count) {
+    auto dest = reinterpret_cast<complex8_t*>(data);
+    for (size_t i = 0; i < count; i++)
+        dest[i] = {(int8_t)(data[i].real() / 256), (int8_t)(data[i].imag() / 256)};
+}
+
+void reference_c8_to_c16(complex8_t* data, size_t count) {
+    auto dest = reinterpret_cast<complex16_t*>(data);
+    for (size_t i = count; i-- > 0;)
+        dest[i] = {(int16_t)(data[i].real() * 256), (int16_t)(data[i].imag() * 256)};
+}
+
+std::vector<int16_t> random_lanes(size_t count) {
+    uint32_t state = 1234;
+    std::vector<int16_t> lanes(count);
+    for (auto& v : lanes) {
+        state = state * 1664525 + 1013904223;
+        v = static_cast<int16_t>(state >> 16);
+    }
+
+    // The rounding edge cases around zero and full scale.
+    const int16_t edges[] = {0, -1, -255, -256, -257, 255, 256, -32768, 32767};
+    for (size_t i = 0; i < std::min(count, std::size(edges)); i++)
+        lanes[i] = edges[i];
+    return lanes;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("IQ file conversion");
+
+TEST_CASE("c16_to_c8 matches the scalar reference.") {
+    // Counts around the four sample blocks, at word and half-word alignment.
+    for (size_t offset : {0, 2}) {
+        for (size_t count = 0; count < 24; count++) {
+            const auto lanes = random_lanes(count * 2);
+            std::vector<uint8_t> expected(count * sizeof(complex16_t) + 4);
+            std::vector<uint8_t> actual(expected.size());
+            memcpy(&expected[offset], lanes.data(), count * sizeof(complex16_t));
+            memcpy(&actual[offset], lanes.data(), count * sizeof(complex16_t));
+
+            reference_c16_to_c8(reinterpret_cast<complex16_t*>(&expected[offset]), count);
+            file_convert::c16_to_c8(&actual[offset], count * sizeof(complex16_t));
+
+            CHECK(memcmp(&expected[offset], &actual[offset], count * sizeof(complex8_t)) == 0);
+        }
+    }
+}
+
+TEST_CASE("c8_to_c16 matches the scalar reference.") {
+    for (size_t offset : {0, 2}) {
+        for (size_t count = 0; count < 24; count++) {
+            std::vector<uint8_t> expected(count * sizeof(complex16_t) + 4);
+            std::vector<uint8_t> actual(expected.size());
+            for (size_t i = 0; i < count * sizeof(complex8_t); i++)
+                expected[offset + i] = actual[offset + i] = static_cast<uint8_t>(i * 37 + 128);
+
+            reference_c8_to_c16(reinterpret_cast<complex8_t*>(&expected[offset]), count);
+            file_convert::c8_to_c16(&actual[offset], count * sizeof(complex8_t));
+
+            CHECK(memcmp(&expected[offset], &actual[offset], count * sizeof(complex16_t)) == 0);
+        }
+    }
+}
+
+TEST_CASE("Conversion round trips every C8 value.") {
+    std::vector<uint32_t> storage(256);
+    auto bytes = reinterpret_cast<int8_t*>(storage.data());
+    for (int v = -128; v < 128; v++) {
+        bytes[(v + 128) * 2] = v;
+        bytes[(v + 128) * 2 + 1] = -v - 1;
+    }
+
+    file_convert::c8_to_c16(storage.data(), 256 * sizeof(complex8_t));
+    file_convert::c16_to_c8(storage.data(), 256 * sizeof(complex16_t));
+
+    for (int v = -128; v < 128; v++) {
+        CHECK(bytes[(v + 128) * 2] == v);
+        CHECK(bytes[(v + 128) * 2 + 1] == -v - 1);
+    }
+}
+
+TEST_SUITE_END();
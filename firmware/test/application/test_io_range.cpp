@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "io_range.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/* A stream of bytes 0, 1, 2... that records how it was driven. */
+class CountingReader : public stream::Reader {
+   public:
+    explicit CountingReader(size_t size)
+        : size_{size} {}
+
+    File::Result<File::Size> read(void* const buffer, const File::Size bytes) override {
+        const auto n = std::min<File::Size>(bytes, size_ - std::min(size_, position_));
+        auto p = static_cast<uint8_t*>(buffer);
+        for (size_t i = 0; i < n; i++)
+            p[i] = static_cast<uint8_t>(position_ + i);
+        position_ += n;
+        return {static_cast<File::Size>(n)};
+    }
+
+    File::Result<File::Offset> seek(const File::Offset offset) override {
+        const auto previous = position_;
+        position_ = offset;
+        seeks++;
+        return {static_cast<File::Offset>(previous)};
+    }
+
+    size_t seeks{0};
+
+   private:
+    size_t size_;
+    size_t position_{0};
+};
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Range reader");
+
+TEST_CASE("RangeReader reads only the range.") {
+    auto inner = std::make_unique<CountingReader>(1000);
+    auto counting = inner.get();
+    RangeReader reader{std::move(inner), 100, 300};
+
+    // No seek until the first read.
+    CHECK(counting->seeks == 0);
+
+    std::vector<uint8_t> buffer(150);
+    auto result = reader.read(buffer.data(), buffer.size());
+    REQUIRE(result.is_ok());
+    CHECK(*result == 150);
+    CHECK(buffer[0] == 100);
+    CHECK(counting->seeks == 1);
+
+    result = reader.read(buffer.data(), buffer.size());
+    REQUIRE(result.is_ok());
+    CHECK(*result == 50);
+    CHECK(buffer[49] == static_cast<uint8_t>(299));
+
+    result = reader.read(buffer.data(), buffer.size());
+    REQUIRE(result.is_ok());
+    CHECK(*result == 0);
+}
+
+TEST_CASE("RangeReader seeks relative to the range start.") {
+    RangeReader reader{std::make_unique<CountingReader>(1000), 100, 300};
+
+    std::vector<uint8_t> buffer(200);
+    reader.read(buffer.data(), buffer.size());
+
+    auto previous = reader.seek(0);
+    REQUIRE(previous.is_ok());
+    CHECK(*previous == 200);
+
+    auto result = reader.read(buffer.data(), 10);
+    REQUIRE(result.is_ok());
+    CHECK(*result == 10);
+    CHECK(buffer[0] == 100);
+}
+
+TEST_CASE("apply_trim leaves untrimmed captures alone.") {
+    auto inner = std::make_unique<CountingReader>(16);
+    auto raw = inner.get();
+    auto reader = apply_trim(std::move(inner), 0, 0, 4);
+    CHECK(reader.get() == raw);
+
+    reader = apply_trim(std::move(reader), 2, 3, 4);
+    std::vector<uint8_t> buffer(16);
+    auto result = reader->read(buffer.data(), buffer.size());
+    REQUIRE(result.is_ok());
+    CHECK(*result == 4);
+    CHECK(buffer[0] == 8);
+}
+
+TEST_CASE("SegmentReader plays the segments with zero gaps between them.") {
+    auto inner = std::make_unique<CountingReader>(1000);
+    auto counting = inner.get();
+    SegmentReader reader{std::move(inner), {{100, 4}, {500, 3}}, 2};
+    CHECK(reader.size() == 11);
+
+    std::vector<uint8_t> buffer(32, 0xAA);
+    auto result = reader.read(buffer.data(), buffer.size());
+    REQUIRE(result.is_ok());
+    CHECK(*result == 11);
+
+    const std::vector<uint8_t> expected{
+        100, 101, 102, 103, 0, 0,
+        static_cast<uint8_t>(500), static_cast<uint8_t>(501), static_cast<uint8_t>(502), 0, 0};
+    CHECK(std::vector<uint8_t>(buffer.begin(), buffer.begin() + 11) == expected);
+    CHECK(counting->seeks == 2);
+
+    result = reader.read(buffer.data(), buffer.size());
+    REQUIRE(result.is_ok());
+    CHECK(*result == 0);
+}
+
+TEST_CASE("SegmentReader splits reads across segment boundaries.") {
+    SegmentReader reader{std::make_unique<CountingReader>(1000), {{10, 5}, {20, 5}}, 0};
+
+    std::vector<uint8_t> buffer(3);
+    std::vector<uint8_t> all{};
+    for (;;) {
+        auto result = reader.read(buffer.data(), buffer.size());
+        REQUIRE(result.is_ok());
+        if (*result == 0)
+            break;
+        all.insert(all.end(), buffer.begin(), buffer.begin() + *result);
+    }
+
+    const std::vector<uint8_t> expected{10, 11, 12, 13, 14, 20, 21, 22, 23, 24};
+    CHECK(all == expected);
+}
+
+TEST_CASE("SegmentReader seeks within the combined stream.") {
+    SegmentReader reader{std::make_unique<CountingReader>(1000), {{100, 4}, {200, 4}}, 3};
+
+    std::vector<uint8_t> buffer(16);
+    reader.read(buffer.data(), buffer.size());
+
+    // Into the first gap.
+    auto previous = reader.seek(5);
+    REQUIRE(previous.is_ok());
+    CHECK(*previous == 14);
+    auto result = reader.read(buffer.data(), 4);
+    REQUIRE(result.is_ok());
+    CHECK(*result == 4);
+    CHECK(buffer[0] == 0);
+    CHECK(buffer[1] == 0);
+    CHECK(buffer[2] == 200);
+    CHECK(buffer[3] == 201);
+
+    // Looping restarts the list.
+    reader.seek(0);
+    result = reader.read(buffer.data(), 1);
+    REQUIRE(result.is_ok());
+    CHECK(buffer[0] == 100);
+}
+
+TEST_CASE("SegmentReader cuts a segment short at the end of the file.") {
+    SegmentReader reader{std::make_unique<CountingReader>(12), {{10, 8}, {0, 2}}, 0};
+
+    std::vector<uint8_t> buffer(16);
+    auto result = reader.read(buffer.data(), buffer.size());
+    REQUIRE(result.is_ok());
+    CHECK(*result == 4);
+    CHECK(buffer[0] == 10);
+    CHECK(buffer[1] == 11);
+    CHECK(buffer[2] == 0);
+    CHECK(buffer[3] == 1);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "iq_codec.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/* Decodes a packed stream block by block, the way PackedFileReader walks it. */
+std::vector<complex16_t> unpack(const std::vector<uint8_t>& packed) {
+    std::vector<complex16_t> out;
+    complex16_t block[iq_codec::block_samples];
+    size_t pos = 0;
+    while (pos + iq_codec::header_size <= packed.size()) {
+        const auto size = iq_codec::block_size(&packed[pos]);
+        REQUIRE(size != 0);
+        REQUIRE(pos + size <= packed.size());
+        const auto count = iq_codec::decode_block(&packed[pos], block);
+        out.insert(out.end(), block, block + count);
+        pos += size;
+    }
+    CHECK(pos == packed.size());
+    return out;
+}
+
+std::vector<uint8_t> pack(const std::vector<complex16_t>& samples) {
+    std::vector<uint8_t> out;
+    uint8_t block[iq_codec::max_block_size];
+    for (size_t i = 0; i < samples.size(); i += iq_codec::block_samples) {
+        const auto count = std::min(iq_codec::block_samples, samples.size() - i);
+        const auto size = iq_codec::encode_block(&samples[i], count, block);
+        CHECK(size == iq_codec::block_size(block));
+        CHECK(size <= iq_codec::max_block_size);
+        out.insert(out.end(), block, block + size);
+    }
+    return out;
+}
+
+bool same(const std::vector<complex16_t>& a, const std::vector<complex16_t>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].real() != b[i].real() || a[i].imag() != b[i].imag())
+            return false;
+    }
+    return true;
+}
+
+struct Noise {
+    uint32_t state{1};
+
+    int16_t operator()(const int32_t amplitude) {
+        state = state * 1664525 + 1013904223;
+        return static_cast<int16_t>(static_cast<int32_t>(state >> 16) % (amplitude + 1) - amplitude / 2);
+    }
+};
+
+/* Low level noise with a strong tone burst every tenth of the stream, like
+ * a key fob capture. */
+std::vector<complex16_t> bursty(const size_t count) {
+    Noise noise;
+    std::vector<complex16_t> samples(count);
+    for (size_t i = 0; i < count; i++) {
+        const bool burst = (i % 40000) < 4000;
+        int16_t re = noise(64);
+        int16_t im = noise(64);
+        if (burst) {
+            re += static_cast<int16_t>(20000 * std::cos(i * 0.05));
+            im += static_cast<int16_t>(20000 * std::sin(i * 0.05));
+        }
+        samples[i] = {re, im};
+    }
+    return samples;
+}
+
+double megabytes_per_second(size_t bytes, std::chrono::steady_clock::duration elapsed) {
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? bytes / seconds / 1e6 : 0.0;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("IQ codec");
+
+TEST_CASE("Packed blocks round trip exactly.") {
+    Noise noise;
+    std::vector<complex16_t> full_scale(1000);
+    for (auto& s : full_scale)
+        s = {noise(65535), noise(65535)};
+    full_scale[3] = {-32768, 32767};
+    full_scale[4] = {32767, -32768};
+
+    std::vector<complex16_t> zeros(300, complex16_t{0, 0});
+    std::vector<complex16_t> dc(300, complex16_t{-1234, 567});
+
+    for (const std::vector<complex16_t>* samples : {&full_scale, &zeros, &dc}) {
+        const auto packed = pack(*samples);
+        CHECK(same(unpack(packed), *samples));
+    }
+}
+
+TEST_CASE("Every short block length round trips.") {
+    const auto samples = bursty(iq_codec::block_samples);
+    for (size_t count = 1; count <= iq_codec::block_samples; count++) {
+        const std::vector<complex16_t> part(samples.begin(), samples.begin() + count);
+        CHECK(same(unpack(pack(part)), part));
+    }
+}
+
+TEST_CASE("Headers alone find the block holding a sample.") {
+    // A short block in the middle, the way a stopped and resumed capture ends up.
+    auto samples = bursty(3 * iq_codec::block_samples);
+    const std::vector<complex16_t> tail(samples.begin(), samples.begin() + 100);
+    auto packed = pack(samples);
+    const auto short_block = pack(tail);
+    packed.insert(packed.begin() + pack({samples.begin(), samples.begin() + iq_codec::block_samples}).size(),
+                  short_block.begin(), short_block.end());
+    samples.insert(samples.begin() + iq_codec::block_samples, tail.begin(), tail.end());
+
+    // Skip blocks by header like PackedFileReader::seek, then decode the one it lands in.
+    for (const size_t target : {size_t{0}, size_t{255}, size_t{256}, size_t{355}, size_t{356}, samples.size() - 1}) {
+        size_t pos = 0;
+        size_t first = 0;
+        while (true) {
+            const auto count = iq_codec::block_sample_count(&packed[pos]);
+            if (target < first + count)
+                break;
+            pos += iq_codec::block_size(&packed[pos]);
+            first += count;
+        }
+
+        complex16_t block[iq_codec::block_samples];
+        iq_codec::decode_block(&packed[pos], block);
+        const auto& s = block[target - first];
+        CHECK(s.real() == samples[target].real());
+        CHECK(s.imag() == samples[target].imag());
+    }
+}
+
+TEST_CASE("Quiet signals pack smaller than raw C16.") {
+    const std::vector<complex16_t> zeros(iq_codec::block_samples, complex16_t{0, 0});
+    CHECK(pack(zeros).size() == iq_codec::header_size);
+
+    const auto samples = bursty(40000);
+    const auto packed = pack(samples);
+    CHECK(packed.size() * 2 < samples.size() * sizeof(complex16_t));
+}
+
+TEST_CASE("Block headers are validated.") {
+    uint8_t block[iq_codec::max_block_size]{};
+    const complex16_t sample{1, 2};
+    CHECK(iq_codec::encode_block(&sample, 1, block) == iq_codec::header_size);
+    CHECK(iq_codec::block_size(block) == iq_codec::header_size);
+
+    block[0] = 0x55;
+    CHECK(iq_codec::block_size(block) == 0);
+
+    block[0] = 0xA0;
+    block[1] = iq_codec::max_width + 1;
+    CHECK(iq_codec::block_size(block) == 0);
+
+    block[1] = 0;
+    block[2] = 0;
+    block[3] = 0;
+    CHECK(iq_codec::block_size(block) == 0);
+}
+
+TEST_CASE("Benchmark packing a bursty capture.") {
+    constexpr size_t samples_count = 4 * 1024 * 1024;
+    const auto samples = bursty(samples_count);
+    const auto raw_bytes = samples_count * sizeof(complex16_t);
+
+    auto start = std::chrono::steady_clock::now();
+    const auto packed = pack(samples);
+    const auto pack_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    const auto unpacked = unpack(packed);
+    const auto unpack_time = std::chrono::steady_clock::now() - start;
+
+    CHECK(same(unpacked, samples));
+    MESSAGE("iq_codec ratio: " << double(raw_bytes) / packed.size() << ":1 against C16");
+    MESSAGE("iq_codec pack: " << megabytes_per_second(raw_bytes, pack_time) << " MB/s of C16");
+    MESSAGE("iq_codec unpack: " << megabytes_per_second(raw_bytes, unpack_time) << " MB/s of C16");
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "iq_trim.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/* One sample at a time, as profiling used to measure. */
+template <typename T>
+iq::BlockPower reference(const std::vector<T>& samples) {
+    uint64_t sum = 0;
+    iq::BlockPower result{0, 0, 0};
+    for (const auto& s : samples) {
+        const uint32_t p = s.real() * s.real() + static_cast<uint32_t>(s.imag() * s.imag());
+        sum += p;
+        result.max_power = std::max(result.max_power, p);
+        result.max_iq = std::max<uint32_t>(result.max_iq, std::max(std::abs(s.real()), std::abs(s.imag())));
+    }
+    result.mean_power = samples.empty() ? 0 : sum / samples.size();
+    return result;
+}
+
+template <typename T>
+void check_block(const std::vector<T>& samples) {
+    const auto expected = reference(samples);
+    const auto actual = iq::measure_block(
+        reinterpret_cast<const uint8_t*>(samples.data()),
+        samples.size() * sizeof(T), sizeof(T));
+
+    CHECK(actual.mean_power == expected.mean_power);
+    CHECK(actual.max_power == expected.max_power);
+    CHECK(actual.max_iq == expected.max_iq);
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("IQ trim");
+
+TEST_CASE("measure_block matches per-sample power for C16.") {
+    std::vector<complex16_t> samples;
+    uint32_t state = 7;
+    for (size_t i = 0; i < 1023; i++) {
+        state = state * 1664525 + 1013904223;
+        samples.push_back({static_cast<int16_t>(state >> 16), static_cast<int16_t>(state)});
+    }
+    check_block(samples);
+
+    samples.push_back({-32768, -32768});
+    check_block(samples);
+}
+
+TEST_CASE("measure_block matches per-sample power for C8, odd counts included.") {
+    std::vector<complex8_t> samples;
+    for (int i = 0; i < 255; i++)
+        samples.push_back({static_cast<int8_t>(i - 128), static_cast<int8_t>(127 - i)});
+    check_block(samples);
+
+    samples.pop_back();
+    check_block(samples);
+}
+
+TEST_CASE("measure_block of nothing is zero.") {
+    const auto result = iq::measure_block(nullptr, 0, sizeof(complex8_t));
+    CHECK(result.mean_power == 0);
+    CHECK(result.max_power == 0);
+    CHECK(result.max_iq == 0);
+}
+
+TEST_CASE("Trim range brackets the loud buckets.") {
+    std::vector<iq::PowerBuckets::Bucket> storage(10);
+    iq::PowerBuckets buckets{.p = storage.data(), .size = storage.size()};
+    for (size_t i = 0; i < storage.size(); i++)
+        buckets.add(i, (i >= 3 && i <= 6) ? 1000 : 5);
+
+    iq::CaptureInfo info{
+        .file_size = 4000,
+        .sample_count = 1000,
+        .sample_size = sizeof(complex16_t),
+        .max_power = 1000,
+        .max_iq = 31};
+
+    const auto range = iq::compute_trim_range(info, buckets, 7);
+    CHECK(range.start_sample == 300);
+    CHECK(range.end_sample == 700);
+}
+
+TEST_CASE("Bursts are padded by a bucket and split on silence.") {
+    std::vector<iq::PowerBuckets::Bucket> storage(20);
+    iq::PowerBuckets buckets{.p = storage.data(), .size = storage.size()};
+    for (size_t i = 0; i < storage.size(); i++) {
+        uint32_t power = 5;
+        if (i >= 2 && i <= 3)
+            power = 800;
+        else if (i == 10)
+            power = 1000;
+        else if (i == 19)
+            power = 400;
+        buckets.add(i, power);
+    }
+
+    iq::CaptureInfo info{
+        .file_size = 8000,
+        .sample_count = 2000,
+        .sample_size = sizeof(complex16_t),
+        .max_power = 1000,
+        .max_iq = 31};
+
+    const auto bursts = iq::find_bursts(info, buckets, 7);
+    REQUIRE(bursts.size() == 3);
+
+    CHECK(bursts[0].start_sample == 100);
+    CHECK(bursts[0].sample_count == 400);
+    CHECK(bursts[0].peak_power == 800);
+
+    CHECK(bursts[1].start_sample == 900);
+    CHECK(bursts[1].sample_count == 300);
+    CHECK(bursts[1].peak_power == 1000);
+
+    // Runs to the end of the capture.
+    CHECK(bursts[2].start_sample == 1800);
+    CHECK(bursts[2].sample_count == 200);
+    CHECK(bursts[2].peak_power == 400);
+}
+
+TEST_CASE("Bursts with touching padding are merged.") {
+    std::vector<iq::PowerBuckets::Bucket> storage(10);
+    iq::PowerBuckets buckets{.p = storage.data(), .size = storage.size()};
+    for (size_t i = 0; i < storage.size(); i++)
+        buckets.add(i, (i == 0 || i == 3) ? 1000 : (i == 7 ? 600 : 5));
+
+    iq::CaptureInfo info{
+        .file_size = 2000,
+        .sample_count = 1000,
+        .sample_size = sizeof(complex8_t),
+        .max_power = 1000,
+        .max_iq = 31};
+
+    const auto bursts = iq::find_bursts(info, buckets, 7);
+    REQUIRE(bursts.size() == 2);
+    CHECK(bursts[0].start_sample == 0);
+    CHECK(bursts[0].sample_count == 500);
+    CHECK(bursts[1].start_sample == 600);
+    CHECK(bursts[1].sample_count == 300);
+    CHECK(bursts[1].peak_power == 600);
+
+    CHECK(iq::find_bursts(info, iq::PowerBuckets{}, 7).empty());
+}
+
+TEST_CASE("Envelope finds a burst far shorter than its slice.") {
+    // 512 slices of 2048 samples; 64 loud samples in the middle of slice 300.
+    constexpr size_t slice_samples = 2048;
+    constexpr uint64_t sample_count = iq::PowerEnvelope::max_points * slice_samples;
+    constexpr uint64_t burst_start = 300 * slice_samples + 1500;
+    constexpr uint64_t burst_length = 64;
+
+    std::vector<complex16_t> capture(sample_count, complex16_t{10, -10});
+    for (auto i = burst_start; i < burst_start + burst_length; i++)
+        capture[i] = {20000, -20000};
+
+    auto envelope = std::make_unique<iq::PowerEnvelope>();
+    iq::EnvelopeBuilder builder{*envelope, sample_count, sizeof(complex16_t)};
+    const auto bytes = reinterpret_cast<const uint8_t*>(capture.data());
+    size_t offset = 0;
+    while (!builder.done()) {
+        const auto length = builder.next_length();
+        REQUIRE(length > 0);
+        REQUIRE(length <= iq::PowerEnvelope::block_size);
+        builder.add(&bytes[offset], length);
+        offset += length;
+    }
+    CHECK(offset == sample_count * sizeof(complex16_t));
+    CHECK(envelope->point_count == iq::PowerEnvelope::max_points);
+    CHECK(envelope->max_power == 800'000'000U);
+
+    std::vector<iq::PowerBuckets::Bucket> storage(iq::PowerEnvelope::max_points);
+    iq::PowerBuckets buckets{.p = storage.data(), .size = storage.size()};
+    for (size_t i = 0; i < envelope->point_count; i++)
+        buckets.add(i, envelope->power[i]);
+
+    iq::CaptureInfo info{
+        .file_size = sample_count * sizeof(complex16_t),
+        .sample_count = sample_count,
+        .sample_size = sizeof(complex16_t),
+        .max_power = envelope->max_power,
+        .max_iq = envelope->max_iq};
+
+    const auto bursts = iq::find_bursts(info, buckets, 1);
+    REQUIRE(bursts.size() == 1);
+    CHECK(bursts[0].start_sample <= burst_start);
+    CHECK(bursts[0].start_sample + bursts[0].sample_count >= burst_start + burst_length);
+}
+
+TEST_CASE("Envelope sidecar sits next to the capture.") {
+    CHECK(iq::get_envelope_path(u"/CAPTURES/BAUD_0001.C16") == u"/CAPTURES/BAUD_0001.PWR");
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "oversample.hpp"
+
+TEST_SUITE_BEGIN("Oversample");
+
+TEST_CASE("No requested decimation follows the table.") {
+    CHECK(get_oversample_rate(12'500, OversampleRate::None) == OversampleRate::x64);
+    CHECK(get_oversample_rate(500'000, OversampleRate::None) == OversampleRate::x8);
+    CHECK(get_oversample_rate(2'000'000, OversampleRate::None) == OversampleRate::x4);
+}
+
+TEST_CASE("A requested decimation is used when the radio can sample at it.") {
+    CHECK(get_oversample_rate(50'000, OversampleRate::x64) == OversampleRate::x64);
+    CHECK(get_oversample_rate(500'000, OversampleRate::x16) == OversampleRate::x16);
+    CHECK(get_oversample_rate(200'000, OversampleRate::x8) == OversampleRate::x8);
+    CHECK(get_oversample_rate(100'000, OversampleRate::x8) == OversampleRate::x8);
+}
+
+TEST_CASE("A requested decimation too fast for the radio falls back to the table.") {
+    CHECK(get_oversample_rate(1'000'000, OversampleRate::x32) == OversampleRate::x8);
+    CHECK(get_oversample_rate(5'500'000, OversampleRate::x8) == OversampleRate::x4);
+
+    // The table's own choice is kept even above the limit.
+    CHECK(get_oversample_rate(5'500'000, OversampleRate::x4) == OversampleRate::x4);
+}
+
+TEST_CASE("A requested decimation too slow for the radio falls back to the table.") {
+    CHECK(get_oversample_rate(12'500, OversampleRate::x4) == OversampleRate::x64);
+    CHECK(get_oversample_rate(100'000, OversampleRate::x4) == OversampleRate::x16);
+    CHECK(get_oversample_rate(50'000, OversampleRate::x8) == OversampleRate::x32);
+
+    // The table's own choice is kept at its lowest rate.
+    CHECK(get_oversample_rate(12'500, OversampleRate::x64) == OversampleRate::x64);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "replay_pool.hpp"
+
+TEST_SUITE_BEGIN("Replay pool sizing");
+
+TEST_CASE("Low rates get the smallest pool.") {
+    auto pool = size_replay_pool(8000, 2, 0);
+    CHECK_EQ(pool.read_size, 4 * 1024);
+    CHECK_EQ(pool.buffer_count, 3);
+    CHECK(pool.sustainable());
+}
+
+TEST_CASE("Pool grows with the sample rate up to the budget.") {
+    ReplayPoolLimits limits{};
+    auto slow = size_replay_pool(100'000, 2, 0, limits);
+    auto fast = size_replay_pool(10'000'000, 2, 0, limits);
+
+    CHECK(slow.read_size * slow.buffer_count < fast.read_size * fast.buffer_count);
+    CHECK(fast.read_size * fast.buffer_count <= limits.memory_budget);
+    CHECK(fast.buffer_count >= limits.min_buffer_count);
+    CHECK(fast.buffer_count <= limits.max_buffer_count);
+}
+
+TEST_CASE("A card slower than twice the stream gets the whole budget.") {
+    ReplayPoolLimits limits{};
+    limits.memory_budget = 96 * 1024;
+
+    auto pool = size_replay_pool(500'000, 2, 1'500'000, limits);
+    CHECK_EQ(pool.read_size, 32 * 1024);
+    CHECK_EQ(pool.buffer_count, 3);
+    CHECK(pool.sustainable());
+}
+
+TEST_CASE("A card slower than the stream is reported.") {
+    auto pool = size_replay_pool(10'000'000, 2, 4'000'000);
+    CHECK_FALSE(pool.sustainable());
+}
+
+TEST_CASE("Reads stay within the configured bounds.") {
+    ReplayPoolLimits limits{};
+    limits.max_read_size = 8 * 1024;
+    limits.memory_budget = 1024 * 1024;
+
+    auto pool = size_replay_pool(20'000'000, 2, 0, limits);
+    CHECK_EQ(pool.read_size, 8 * 1024);
+    CHECK_EQ(pool.buffer_count, limits.max_buffer_count);
+}
+
+TEST_CASE("Slack excludes the buffer being drained.") {
+    ReplayPoolConfig pool{};
+    pool.read_size = 16 * 1024;
+    pool.buffer_count = 3;
+    pool.stream_rate = 32 * 1024 * 1000;
+    CHECK_EQ(pool.slack_ms(), 1);
+}
+
+TEST_CASE("Transfers tile the cluster size.") {
+    CHECK_EQ(cluster_transfer_size(16 * 1024, 32 * 1024), 16 * 1024);
+    CHECK_EQ(cluster_transfer_size(16 * 1024, 4 * 1024), 16 * 1024);
+    CHECK_EQ(cluster_transfer_size(20 * 1024, 8 * 1024), 16 * 1024);
+    CHECK_EQ(cluster_transfer_size(5000, 32 * 1024), 4096);
+    CHECK_EQ(cluster_transfer_size(96 * 1024, 64 * 1024), 64 * 1024);
+}
+
+TEST_CASE("Transfers are left alone without a cluster size.") {
+    CHECK_EQ(cluster_transfer_size(5000, 0), 5000);
+    CHECK_EQ(cluster_transfer_size(100, 32 * 1024), 100);
+}
+
+TEST_SUITE_END();
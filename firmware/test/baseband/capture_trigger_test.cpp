@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "capture_trigger.hpp"
+#include "doctest.h"
+
+#include <array>
+#include <vector>
+
+namespace {
+
+constexpr size_t block_samples = 4;
+constexpr size_t block_bytes = block_samples * sizeof(complex16_t);
+
+/* A block whose samples are all {level, -level}, tagged by its first real. */
+struct Block {
+    std::array<complex16_t, block_samples> samples{};
+
+    Block(int16_t level, int16_t tag = 0) {
+        samples.fill({level, static_cast<int16_t>(-level)});
+        samples[0] = {tag, static_cast<int16_t>(-level)};
+    }
+
+    buffer_c16_t buffer() {
+        return {samples.data(), samples.size()};
+    }
+};
+
+std::vector<int16_t> drained_tags(CaptureTrigger& trigger) {
+    std::vector<int16_t> tags{};
+    trigger.drain([&tags](const void* const data, const size_t length) {
+        auto p = static_cast<const complex16_t*>(data);
+        for (size_t i = 0; i < length / sizeof(complex16_t); i += block_samples)
+            tags.push_back(p[i].real());
+    });
+    return tags;
+}
+
+}  // namespace
+
+TEST_CASE("CaptureTrigger fires on the first loud block") {
+    CaptureTriggerConfig config{100, 0x1, 0x1, 3 * block_bytes};
+    CaptureTrigger trigger{config, 1024};
+
+    for (int16_t tag = 0; tag < 5; tag++) {
+        Block quiet{1, tag};
+        CHECK_FALSE(trigger.evaluate(quiet.buffer()));
+        trigger.store(quiet.samples.data(), block_bytes);
+    }
+
+    Block loud{100, 5};
+    CHECK(trigger.evaluate(loud.buffer()));
+    CHECK(trigger.fired());
+
+    // Only evaluates once.
+    CHECK_FALSE(trigger.evaluate(loud.buffer()));
+
+    // The newest three quiet blocks were kept, oldest first.
+    CHECK(drained_tags(trigger) == std::vector<int16_t>{2, 3, 4});
+    CHECK(trigger.kept() == 0);
+}
+
+TEST_CASE("CaptureTrigger ring is capped by the budget in whole samples") {
+    CaptureTriggerConfig config{100, 0x1, 0x1, 4096};
+    CaptureTrigger trigger{config, 2 * block_bytes + 3};
+    CHECK(config.pre_trigger_bytes == 2 * block_bytes);
+
+    CaptureTriggerConfig none{100, 0x1, 0x1, 0};
+    CaptureTrigger unbuffered{none, 1024};
+    Block quiet{1};
+    unbuffered.store(quiet.samples.data(), block_bytes);
+    CHECK(unbuffered.kept() == 0);
+    CHECK(drained_tags(unbuffered).empty());
+}
+
+TEST_CASE("CaptureTrigger matches an on/off pattern of blocks") {
+    // Off, on, on, off, with the newest block in bit 0.
+    CaptureTriggerConfig config{100, 0xF, 0x6, 0};
+    CaptureTrigger trigger{config, 0};
+
+    const std::array<int16_t, 7> levels{100, 100, 1, 100, 100, 100, 1};
+    const std::array<int16_t, 7> levels_match{1, 100, 100, 1, 100, 100, 1};
+
+    for (auto level : levels) {
+        Block b{level};
+        CHECK_FALSE(trigger.evaluate(b.buffer()));
+    }
+
+    CaptureTrigger second{config, 0};
+    size_t fired_at = 0;
+    for (size_t i = 0; i < levels_match.size(); i++) {
+        Block b{levels_match[i]};
+        if (second.evaluate(b.buffer())) {
+            fired_at = i;
+            break;
+        }
+    }
+    CHECK(fired_at == 3);
+}
+
+TEST_CASE("CaptureTrigger needs the whole pattern to have been seen") {
+    // Four quiet blocks then a loud one; a loud first block doesn't count.
+    CaptureTriggerConfig config{100, 0x1F, 0x01, 0};
+    CaptureTrigger trigger{config, 0};
+
+    Block loud{100};
+    CHECK_FALSE(trigger.evaluate(loud.buffer()));
+
+    Block quiet{1};
+    for (size_t i = 0; i < 4; i++)
+        CHECK_FALSE(trigger.evaluate(quiet.buffer()));
+    CHECK(trigger.evaluate(loud.buffer()));
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_convert.hpp"
+#include "doctest.h"
+
+#include <vector>
+
+namespace {
+
+/* The per-sample loop proc_replay used before. */
+std::vector<complex8_t> reference(const std::vector<complex16_t>& src, const size_t repeat) {
+    std::vector<complex8_t> out;
+    for (const auto& v : src) {
+        const complex8_t value{static_cast<int8_t>(v.real() >> 8), static_cast<int8_t>(v.imag() >> 8)};
+        for (size_t j = 0; j < repeat; j++)
+            out.push_back(value);
+    }
+    return out;
+}
+
+std::vector<complex16_t> samples(const size_t count) {
+    uint32_t state = 42;
+    std::vector<complex16_t> out;
+    for (size_t i = 0; i < count; i++) {
+        state = state * 1664525 + 1013904223;
+        out.push_back({static_cast<int16_t>(state >> 16), static_cast<int16_t>(state)});
+    }
+    if (count > 2) {
+        out[0] = {-1, -256};
+        out[1] = {-32768, 32767};
+        out[2] = {255, -257};
+    }
+    return out;
+}
+
+bool same(const std::vector<complex8_t>& a, const std::vector<complex8_t>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].real() != b[i].real() || a[i].imag() != b[i].imag())
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("c16_to_c8_repeat matches the per-sample conversion") {
+    for (size_t repeat : {1, 2, 3, 4, 8, 16}) {
+        for (size_t count = 0; count < 19; count++) {
+            const auto src = samples(count);
+            std::vector<complex8_t> out(count * repeat);
+            dsp::convert::c16_to_c8_repeat(src.data(), count, out.data(), repeat);
+
+            CAPTURE(repeat);
+            CAPTURE(count);
+            CHECK(same(out, reference(src, repeat)));
+        }
+    }
+}
+
+TEST_CASE("c16_to_c8_repeat handles unaligned buffers") {
+    const auto src = samples(33);
+    std::vector<complex16_t> shifted_src(src.size() + 1);
+    std::vector<complex8_t> out(src.size() * 4 + 1);
+
+    // Half-word offsets on both sides.
+    auto in = reinterpret_cast<complex16_t*>(reinterpret_cast<uint8_t*>(shifted_src.data()) + 2);
+    std::copy(src.begin(), src.end(), in);
+    dsp::convert::c16_to_c8_repeat(in, src.size(), out.data() + 1, 4);
+
+    const std::vector<complex8_t> result(out.begin() + 1, out.end());
+    CHECK(same(result, reference(src, 4)));
+}
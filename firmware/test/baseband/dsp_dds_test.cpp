@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_dds.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr size_t fft_size = 4096;
+
+/* Spurious-free dynamic range in dB of a tone sitting exactly on bin
+ * tone_bin, so that no window is needed. Plain DFT, the test isn't
+ * about speed. */
+double sfdr_db(const std::vector<complex8_t>& samples, const size_t tone_bin) {
+    std::vector<double> cos_table(fft_size);
+    std::vector<double> sin_table(fft_size);
+    for (size_t i = 0; i < fft_size; i++) {
+        cos_table[i] = std::cos(2 * M_PI * i / fft_size);
+        sin_table[i] = std::sin(2 * M_PI * i / fft_size);
+    }
+
+    double tone = 0;
+    double spur = 0;
+    for (size_t k = 0; k < fft_size; k++) {
+        double re = 0;
+        double im = 0;
+        for (size_t n = 0; n < fft_size; n++) {
+            const size_t w = (k * n) % fft_size;
+            const double x = samples[n].real();
+            const double y = samples[n].imag();
+            re += x * cos_table[w] + y * sin_table[w];
+            im += y * cos_table[w] - x * sin_table[w];
+        }
+
+        const auto power = re * re + im * im;
+        if (k == tone_bin)
+            tone = power;
+        else if (power > spur)
+            spur = power;
+    }
+
+    return 10 * std::log10(tone / spur);
+}
+
+std::vector<complex8_t> generate(dsp::DDS::Mode mode, const uint64_t word) {
+    dsp::DDS dds{};
+    dds.set_mode(mode);
+    dds.set_frequency_word(word);
+
+    std::vector<complex8_t> samples(fft_size);
+    dds.generate(samples.data(), samples.size());
+    return samples;
+}
+
+}  // namespace
+
+TEST_CASE("DDS frequency word resolves fractions of a hertz") {
+    constexpr uint32_t fs = 1536000;
+
+    CHECK(dsp::DDS::frequency_word(0, fs) == 0);
+    CHECK(dsp::DDS::frequency_word(fs / 4, fs) == (1ULL << 62));
+    CHECK(dsp::DDS::frequency_word(-(int32_t)(fs / 4), fs) == (3ULL << 62));
+
+    // Off by less than one LSB of the word.
+    const auto word = dsp::DDS::frequency_word(1, fs);
+    const long double hz = static_cast<long double>(word) * fs / 18446744073709551616.0L;
+    CHECK(std::fabs(static_cast<double>(hz) - 1.0) < 1e-12);
+}
+
+TEST_CASE("DDS modes produce a full scale carrier") {
+    for (auto mode : {dsp::DDS::Mode::Legacy, dsp::DDS::Mode::Table, dsp::DDS::Mode::Interpolated, dsp::DDS::Mode::Dithered}) {
+        const auto samples = generate(mode, 0);
+        CHECK(samples[0].real() == 127);
+        CHECK(std::abs(samples[0].imag()) <= 1);
+    }
+}
+
+TEST_CASE("DDS spectral purity per mode") {
+    // An odd bin makes the phase truncation error as irregular as possible.
+    constexpr size_t tone_bin = 301;
+    constexpr uint64_t word = static_cast<uint64_t>(tone_bin) << (64 - 12);
+
+    const auto legacy = sfdr_db(generate(dsp::DDS::Mode::Legacy, word), tone_bin);
+    const auto table = sfdr_db(generate(dsp::DDS::Mode::Table, word), tone_bin);
+    const auto interpolated = sfdr_db(generate(dsp::DDS::Mode::Interpolated, word), tone_bin);
+    const auto dithered = sfdr_db(generate(dsp::DDS::Mode::Dithered, word), tone_bin);
+
+    MESSAGE("DDS SFDR legacy 8-bit: " << legacy << " dB");
+    MESSAGE("DDS SFDR 10-bit table: " << table << " dB");
+    MESSAGE("DDS SFDR interpolated: " << interpolated << " dB");
+    MESSAGE("DDS SFDR dithered: " << dithered << " dB");
+
+    CHECK(table > legacy);
+    CHECK(interpolated > legacy + 6);
+    CHECK(dithered > legacy);
+}
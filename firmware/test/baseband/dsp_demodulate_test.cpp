@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_demodulate.hpp"
+#include "doctest.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+using Discriminator = dsp::demodulate::FM::Discriminator;
+
+struct Tier {
+    Discriminator discriminator;
+    const char* name;
+};
+
+constexpr std::array<Tier, 4> tiers{{
+    {Discriminator::Precise, "Precise"},
+    {Discriminator::Table, "Table"},
+    {Discriminator::Polynomial, "Polynomial"},
+    {Discriminator::Quadrature, "Quadrature"},
+}};
+
+/* A tone frequency modulated onto a full scale carrier, and the output an
+ * ideal discriminator would give for it: the phase step of each sample
+ * over the step at full deviation. */
+struct FMSignal {
+    std::vector<complex16_t> samples;
+    std::vector<float> expected;
+};
+
+FMSignal modulate(const float sampling_rate, const float deviation, const float tone, const size_t count) {
+    FMSignal signal;
+    double phase = 0;
+    double previous = 0;
+    for (size_t n = 0; n < count; n++) {
+        const double frequency = deviation * std::sin(2 * M_PI * tone * n / sampling_rate);
+        phase += 2 * M_PI * frequency / sampling_rate;
+
+        const complex16_t s{
+            static_cast<int16_t>(std::lround(30000 * std::cos(phase))),
+            static_cast<int16_t>(std::lround(30000 * std::sin(phase)))};
+        signal.samples.push_back(s);
+        signal.expected.push_back((phase - previous) / (2 * M_PI * deviation / sampling_rate));
+        previous = phase;
+    }
+    return signal;
+}
+
+double snr_db(const std::vector<float>& actual, const std::vector<float>& expected) {
+    double signal = 0;
+    double noise = 0;
+    // Skip the first sample, which is measured against the zero initial state.
+    for (size_t i = 1; i < actual.size(); i++) {
+        signal += expected[i] * expected[i];
+        noise += (actual[i] - expected[i]) * (actual[i] - expected[i]);
+    }
+    return 10 * std::log10(signal / (noise + 1e-30));
+}
+
+std::vector<float> demodulate(const FMSignal& signal, const float sampling_rate, const float deviation, const Discriminator discriminator) {
+    dsp::demodulate::FM demod;
+    demod.configure(sampling_rate, deviation, discriminator);
+
+    std::vector<float> out(signal.samples.size());
+    auto samples = signal.samples;
+    demod.execute(
+        buffer_c16_t{samples.data(), samples.size(), static_cast<uint32_t>(sampling_rate)},
+        buffer_f32_t{out.data(), out.size()});
+    return out;
+}
+
+uint64_t cycle_count() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+}  // namespace
+
+TEST_CASE("FM discriminators recover a full deviation NFM tone") {
+    constexpr float fs = 24000;
+    constexpr float deviation = 5000;
+    const auto signal = modulate(fs, deviation, 1000, 4800);
+
+    CHECK(snr_db(demodulate(signal, fs, deviation, Discriminator::Precise), signal.expected) > 75);
+    CHECK(snr_db(demodulate(signal, fs, deviation, Discriminator::Table), signal.expected) > 75);
+    CHECK(snr_db(demodulate(signal, fs, deviation, Discriminator::Polynomial), signal.expected) > 45);
+}
+
+TEST_CASE("FM discriminators handle every quadrant") {
+    // Steps of up to 170 degrees either way, beyond any single octant.
+    constexpr float fs = 24000;
+    constexpr float deviation = 11000;
+    const auto signal = modulate(fs, deviation, 700, 4800);
+
+    for (const auto& tier : tiers) {
+        if (tier.discriminator == Discriminator::Quadrature)
+            continue;
+        CAPTURE(std::string{tier.name});
+        CHECK(snr_db(demodulate(signal, fs, deviation, tier.discriminator), signal.expected) > 45);
+    }
+}
+
+TEST_CASE("FM quadrature discriminator is close for small phase steps") {
+    // 2.5 kHz deviation at 384 kHz: steps of at most 2.3 degrees.
+    constexpr float fs = 384000;
+    constexpr float deviation = 2500;
+    const auto signal = modulate(fs, deviation, 1000, 38400);
+
+    CHECK(snr_db(demodulate(signal, fs, deviation, Discriminator::Quadrature), signal.expected) > 40);
+}
+
+TEST_CASE("FM s16 output matches the float output") {
+    constexpr float fs = 24000;
+    constexpr float deviation = 5000;
+    auto signal = modulate(fs, deviation, 1000, 480);
+
+    for (const auto& tier : tiers) {
+        CAPTURE(std::string{tier.name});
+        const auto reference = demodulate(signal, fs, deviation, tier.discriminator);
+
+        dsp::demodulate::FM demod;
+        demod.configure(fs, deviation, tier.discriminator);
+        std::vector<int16_t> out(signal.samples.size());
+        demod.execute(
+            buffer_c16_t{signal.samples.data(), signal.samples.size()},
+            buffer_s16_t{out.data(), out.size()});
+
+        // The s16 path truncates, as it always has.
+        for (size_t i = 0; i < out.size(); i++)
+            CHECK(std::abs(out[i] - reference[i] * 32767) <= 2.0f);
+    }
+}
+
+TEST_CASE("FM discriminators keep their phase across buffers") {
+    constexpr float fs = 24000;
+    constexpr float deviation = 5000;
+    auto signal = modulate(fs, deviation, 1000, 512);
+    const auto whole = demodulate(signal, fs, deviation, Discriminator::Table);
+
+    dsp::demodulate::FM demod;
+    demod.configure(fs, deviation, Discriminator::Table);
+    std::vector<float> out(signal.samples.size());
+    for (size_t i = 0; i < signal.samples.size(); i += 16) {
+        demod.execute(
+            buffer_c16_t{&signal.samples[i], 16},
+            buffer_f32_t{&out[i], 16});
+    }
+
+    CHECK(out == whole);
+}
+
+TEST_CASE("Benchmark FM discriminators") {
+    constexpr float fs = 24000;
+    constexpr float deviation = 5000;
+    auto signal = modulate(fs, deviation, 1000, 4800);
+    std::vector<float> out(signal.samples.size());
+    constexpr size_t passes = 200;
+
+    double precise_cycles = 0;
+    for (const auto& tier : tiers) {
+        dsp::demodulate::FM demod;
+        demod.configure(fs, deviation, tier.discriminator);
+
+        const auto start = cycle_count();
+        for (size_t i = 0; i < passes; i++) {
+            demod.execute(
+                buffer_c16_t{signal.samples.data(), signal.samples.size()},
+                buffer_f32_t{out.data(), out.size()});
+        }
+        const double cycles = static_cast<double>(cycle_count() - start) / (passes * signal.samples.size());
+        if (tier.discriminator == Discriminator::Precise)
+            precise_cycles = cycles;
+
+        MESSAGE("FM " << std::string{tier.name} << ": SNR " << snr_db(demodulate(signal, fs, deviation, tier.discriminator), signal.expected)
+                                     << " dB, " << cycles << " host cycles/sample (" << cycles / precise_cycles << "x atan2f)");
+        CHECK(cycles > 0);
+    }
+}
@@ -22,6 +22,154 @@
 #include "dsp_fft.hpp"
 #include "doctest.h"
 
+#include <chrono>
+#include <vector>
+
+namespace {
+
+/* Two tones and a DC offset, well inside 16 bits. */
+std::vector<complex16_t> test_signal(const size_t n) {
+    std::vector<complex16_t> signal(n);
+    for (size_t i = 0; i < n; i++) {
+        const double a = 2 * M_PI * 5 * i / n;
+        const double b = 2 * M_PI * 37.5 * i / n;
+        signal[i] = {
+            static_cast<int16_t>(200 + 12000 * std::cos(a) + 4000 * std::cos(b)),
+            static_cast<int16_t>(-300 + 12000 * std::sin(a) - 4000 * std::sin(b))};
+    }
+    return signal;
+}
+
+std::vector<std::complex<double>> reference_dft(const std::vector<complex16_t>& signal) {
+    const size_t n = signal.size();
+    std::vector<std::complex<double>> bins(n);
+    for (size_t k = 0; k < n; k++) {
+        std::complex<double> sum{};
+        for (size_t i = 0; i < n; i++) {
+            const double phase = -2 * M_PI * static_cast<double>((k * i) % n) / n;
+            sum += std::complex<double>(signal[i].real(), signal[i].imag()) * std::polar(1.0, phase);
+        }
+        bins[k] = sum;
+    }
+    return bins;
+}
+
+/* Error relative to the strongest bin, in dB. */
+template <typename T>
+double error_db(const std::vector<std::complex<double>>& reference, const T& result, const double scale) {
+    double peak = 0;
+    double error = 0;
+    for (size_t k = 0; k < reference.size(); k++) {
+        const std::complex<double> bin(result[k].real() * scale, result[k].imag() * scale);
+        peak = std::max(peak, std::abs(reference[k]));
+        error = std::max(error, std::abs(bin - reference[k]));
+    }
+    return 20 * std::log10(error / peak);
+}
+
+template <typename T>
+std::vector<T> load(const std::vector<complex16_t>& signal) {
+    std::vector<T> data(signal.size());
+    for (size_t i = 0; i < signal.size(); i++)
+        data[i] = {
+            static_cast<typename T::value_type>(signal[i].real()),
+            static_cast<typename T::value_type>(signal[i].imag())};
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("fft float matches the DFT for every supported size") {
+    for (size_t n = 2; n <= dsp::fft::max_size; n *= 2) {
+        const auto signal = test_signal(n);
+        auto data = load<std::complex<float>>(signal);
+        dsp::fft::forward(data.data(), n);
+
+        const auto error = error_db(reference_dft(signal), data, 1.0);
+        INFO("n = " << n << ", error " << error << " dB");
+        CHECK(error < -100);
+    }
+}
+
+TEST_CASE("fft Q15 matches the scaled DFT") {
+    for (size_t n = 16; n <= dsp::fft::max_size; n *= 2) {
+        const auto signal = test_signal(n);
+        auto data = load<complex16_t>(signal);
+        dsp::fft::forward(data.data(), n);
+
+        /* Rounding noise grows by about 3 dB per pass. */
+        const auto error = error_db(reference_dft(signal), data, static_cast<double>(n));
+        INFO("n = " << n << ", error " << error << " dB");
+        CHECK(error < -60);
+    }
+}
+
+TEST_CASE("fft passes can be spread over several calls") {
+    const auto signal = test_signal(512);
+    auto whole = load<std::complex<float>>(signal);
+    auto split = whole;
+
+    dsp::fft::forward(whole.data(), whole.size());
+    for (size_t pass = 0; pass < dsp::fft::pass_count(split.size()); pass++)
+        dsp::fft::passes(split.data(), split.size(), pass, pass + 1);
+    dsp::fft::bit_reverse(split.data(), split.size());
+
+    CHECK(whole == split);
+}
+
+TEST_CASE("fft radix-4 agrees with the radix-2 implementation") {
+    const auto signal = test_signal(256);
+    std::array<std::complex<float>, 256> radix2{};
+    std::array<std::complex<float>, 256> radix4{};
+    std::copy_n(load<std::complex<float>>(signal).begin(), 256, radix2.begin());
+    radix4 = radix2;
+
+    dsp::fft::bit_reverse(radix2.data(), radix2.size());
+    fft_c_preswapped(radix2, 0, 8);
+    dsp::fft::forward(radix4);
+
+    for (size_t k = 0; k < radix4.size(); k++) {
+        CHECK(radix4[k].real() == doctest::Approx(radix2[k].real()).epsilon(1e-3).scale(1e3));
+        CHECK(radix4[k].imag() == doctest::Approx(radix2[k].imag()).epsilon(1e-3).scale(1e3));
+    }
+}
+
+TEST_CASE("Benchmark fft radix-4 against radix-2") {
+    constexpr size_t runs = 20000;
+    const auto signal = test_signal(256);
+    std::array<std::complex<float>, 256> input{};
+    std::copy_n(load<std::complex<float>>(signal).begin(), 256, input.begin());
+    auto input_q15 = load<complex16_t>(signal);
+
+    auto time = [&](auto&& transform) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < runs; i++)
+            transform();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+    };
+
+    std::array<std::complex<float>, 256> data{};
+    std::vector<complex16_t> data_q15(256);
+    const auto radix2 = time([&] {
+        data = input;
+        dsp::fft::bit_reverse(data.data(), data.size());
+        fft_c_preswapped(data, 0, 8);
+    });
+    const auto radix4 = time([&] {
+        data = input;
+        dsp::fft::forward(data);
+    });
+    const auto radix4_q15 = time([&] {
+        data_q15 = input_q15;
+        dsp::fft::forward(data_q15.data(), data_q15.size());
+    });
+
+    MESSAGE("256 point FFT, float radix-2: " << radix2 << " us");
+    MESSAGE("256 point FFT, float radix-4: " << radix4 << " us");
+    MESSAGE("256 point FFT, Q15 radix-4: " << radix4_q15 << " us");
+    CHECK(radix4 > 0);
+}
+
 TEST_CASE("ifft successfully calculates dc on zero frequency") {
     uint32_t fft_width = 8;
     complex16_t* v = new complex16_t[fft_width];
@@ -123,3 +271,28 @@ TEST_CASE("ifft successfully calculates pure sine of half the sample rate") {
     delete[] v;
     delete[] tmp;
 }
+
+TEST_CASE("fft cosine reads the whole circle from the quarter wave table") {
+    for (size_t n : {256, 2048}) {
+        for (size_t k = 0; k < 2 * n; k += 7)
+            CHECK(dsp::fft::cosine(k, n) == doctest::Approx(std::cos(2 * M_PI * k / n)).epsilon(1e-6).scale(1));
+    }
+}
+
+TEST_CASE("fft log2_q8 tracks log2 to a fraction of a dB") {
+    CHECK(dsp::fft::log2_q8(0.0f) < -126 * 256);
+
+    for (float x = 1e-6f; x < 1e12f; x *= 1.37f) {
+        const double db = 10 * std::log10(2.0) * dsp::fft::log2_q8(x) / 256;
+        INFO("x = " << x);
+        CHECK(std::abs(db - 10 * std::log10(x)) < 0.05);
+    }
+}
+
+TEST_CASE("fft peak_power finds the strongest bin") {
+    std::array<complex16_t, 8> bins{{{1, 1}, {-300, 400}, {0, 0}, {-32768, -32768}, {5, 5}, {0, 0}, {0, 0}, {2, 0}}};
+    CHECK(dsp::fft::power(bins[1]) == 250000);
+    CHECK(dsp::fft::peak_power(bins.data(), 3) == 250000);
+    CHECK(dsp::fft::peak_power(bins.data(), bins.size()) == 0x80000000u);
+    CHECK(dsp::fft::peak_power(bins.data(), 0) == 0);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_mixer.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t sampling_rate = 2600000;
+
+std::vector<complex8_t> constant(const size_t count, const complex8_t value) {
+    return std::vector<complex8_t>(count, value);
+}
+
+}  // namespace
+
+TEST_CASE("Mixer is bypassed at 0 Hz and unity gain") {
+    dsp::Mixer mixer;
+    CHECK(mixer.bypass());
+
+    mixer.set_frequency(1000, sampling_rate);
+    CHECK_FALSE(mixer.bypass());
+
+    mixer.set_frequency(0, sampling_rate);
+    mixer.set_gain(-6, false);
+    CHECK_FALSE(mixer.bypass());
+}
+
+TEST_CASE("Mixer at unity gain keeps the samples within one LSB") {
+    dsp::Mixer mixer;
+    mixer.set_gain(0, false);
+
+    std::vector<complex8_t> samples;
+    for (int i = -127; i <= 127; i++)
+        samples.push_back({static_cast<int8_t>(i), static_cast<int8_t>(-i / 2)});
+    const auto input = samples;
+
+    mixer(samples.data(), samples.size());
+    for (size_t i = 0; i < samples.size(); i++) {
+        CHECK(std::abs(samples[i].real() - input[i].real()) <= 1);
+        CHECK(std::abs(samples[i].imag() - input[i].imag()) <= 1);
+    }
+}
+
+TEST_CASE("Mixer shifts DC to the requested offset") {
+    dsp::Mixer mixer;
+    mixer.set_frequency(sampling_rate / 4, sampling_rate);
+
+    auto samples = constant(8, {100, 0});
+    mixer(samples.data(), samples.size());
+
+    // Quarter turn per sample: 100, 100j, -100, -100j.
+    const complex8_t expected[] = {{100, 0}, {0, 100}, {-100, 0}, {0, -100}};
+    for (size_t i = 0; i < samples.size(); i++) {
+        CHECK(std::abs(samples[i].real() - expected[i % 4].real()) <= 1);
+        CHECK(std::abs(samples[i].imag() - expected[i % 4].imag()) <= 1);
+    }
+}
+
+TEST_CASE("Mixer reaches half the sampling rate in both directions") {
+    for (const int32_t frequency : {static_cast<int32_t>(sampling_rate / 2), -static_cast<int32_t>(sampling_rate / 2)}) {
+        dsp::Mixer mixer;
+        mixer.set_frequency(frequency, sampling_rate);
+
+        auto samples = constant(6, {50, 20});
+        mixer(samples.data(), samples.size());
+
+        for (size_t i = 0; i < samples.size(); i++) {
+            const int sign = (i & 1) ? -1 : 1;
+            CHECK(std::abs(samples[i].real() - sign * 50) <= 1);
+            CHECK(std::abs(samples[i].imag() - sign * 20) <= 1);
+        }
+    }
+}
+
+TEST_CASE("Mixer tone keeps its power across the shift") {
+    dsp::Mixer mixer;
+    mixer.set_frequency(-313000, sampling_rate);
+
+    auto samples = constant(4096, {90, -40});
+    mixer(samples.data(), samples.size());
+
+    double power = 0;
+    for (const auto& s : samples)
+        power += s.real() * s.real() + s.imag() * s.imag();
+
+    const double expected = 90 * 90 + 40 * 40;
+    CHECK(power / samples.size() == doctest::Approx(expected).epsilon(0.02));
+}
+
+TEST_CASE("Mixer applies gain in dB") {
+    dsp::Mixer mixer;
+
+    mixer.set_gain(-6, false);
+    auto samples = constant(2, {100, -100});
+    mixer(samples.data(), samples.size());
+    CHECK(samples[0].real() == 50);
+    CHECK(samples[0].imag() == -50);
+
+    mixer.set_gain(-20, false);
+    samples = constant(2, {100, -100});
+    mixer(samples.data(), samples.size());
+    CHECK(samples[1].real() == 10);
+    CHECK(samples[1].imag() == -10);
+}
+
+TEST_CASE("Mixer hard clips to full scale unless soft clip is set") {
+    dsp::Mixer mixer;
+
+    mixer.set_gain(12, false);
+    auto samples = constant(1, {100, 10});
+    mixer(samples.data(), samples.size());
+    CHECK(samples[0].real() == 127);
+    CHECK(samples[0].imag() == 40);
+
+    mixer.set_gain(20, true);
+    int8_t previous = 0;
+    for (int8_t level = 1; level < 127; level++) {
+        samples = constant(1, {level, 0});
+        mixer(samples.data(), samples.size());
+        CHECK(samples[0].real() >= previous);
+        CHECK(samples[0].real() < 127);
+        previous = samples[0].real();
+    }
+    CHECK(previous > 100);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_wavetable.hpp"
+#include "doctest.h"
+
+#include <array>
+
+TEST_CASE("WaveTable is complete only once every byte has arrived") {
+    dsp::WaveTable table{};
+    const std::array<uint8_t, 4> data{0, 40, 80, 120};
+
+    REQUIRE(table.allocate(AWGFormat::Real, 4));
+    CHECK_FALSE(table.complete());
+
+    table.write(0, data.data(), 2);
+    CHECK_FALSE(table.complete());
+    table.write(2, &data[2], 2);
+    CHECK(table.complete());
+
+    table.clear();
+    CHECK_FALSE(table.complete());
+}
+
+TEST_CASE("WaveTable rejects empty and oversized tables") {
+    dsp::WaveTable table{};
+
+    CHECK_FALSE(table.allocate(AWGFormat::Real, 0));
+    CHECK_FALSE(table.allocate(AWGFormat::IQ, awg_table_max_bytes / 2 + 1));
+    CHECK(table.allocate(AWGFormat::IQ, awg_table_max_bytes / 2));
+}
+
+TEST_CASE("WaveTable interpolates and wraps to the first entry") {
+    dsp::WaveTable table{};
+    const std::array<uint8_t, 4> data{0, 40, 80, 120};
+
+    REQUIRE(table.allocate(AWGFormat::Real, data.size()));
+    table.write(0, data.data(), data.size());
+
+    // Each entry spans a quarter of the phase range.
+    CHECK(table.real_at(0x00000000) == 0);
+    CHECK(table.real_at(0x40000000) == 40);
+    CHECK(table.real_at(0x20000000) == 20);
+    CHECK(table.real_at(0x60000000) == 60);
+
+    // Between the last entry and the first one.
+    CHECK(table.real_at(0xE0000000) == 60);
+}
+
+TEST_CASE("WaveTable plays I/Q tables and exposes I as the real part") {
+    dsp::WaveTable table{};
+    const std::array<uint8_t, 4> data{100, static_cast<uint8_t>(-100), static_cast<uint8_t>(-100), 100};
+
+    REQUIRE(table.allocate(AWGFormat::IQ, 2));
+    table.write(0, data.data(), data.size());
+
+    CHECK(table.iq_at(0) == complex8_t{100, -100});
+    CHECK(table.iq_at(0x80000000) == complex8_t{-100, 100});
+    CHECK(table.iq_at(0x40000000) == complex8_t{0, 0});
+    CHECK(table.real_at(0x80000000) == -100);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "heap_allocation.hpp"
+#include "doctest.h"
+
+#include <limits>
+
+TEST_CASE("allocate_fitting keeps the requested size when it fits") {
+    size_t units = 6;
+    const auto block = allocate_fitting(units, 4096, 4096);
+    CHECK(block != nullptr);
+    CHECK(units == 6);
+}
+
+TEST_CASE("allocate_fitting leaves room for the slack past the halving") {
+    // The slack alone would overflow next to the largest unit count.
+    size_t units = 4;
+    const auto block = allocate_fitting(units, std::numeric_limits<size_t>::max() / 4, 0, 511);
+    CHECK(block == nullptr);
+    CHECK(units == 0);
+}
+
+TEST_CASE("allocate_fitting gives up without panicking") {
+    // Larger than any address space, at every step down to one unit.
+    size_t units = 8;
+    const auto block = allocate_fitting(units, std::numeric_limits<size_t>::max() / 2, 0);
+    CHECK(block == nullptr);
+    CHECK(units == 0);
+}
+
+TEST_CASE("allocate_fitting halves past sizes that overflow") {
+    size_t units = 1024;
+    const auto block = allocate_fitting(units, std::numeric_limits<size_t>::max() / 100, 0);
+    CHECK(block == nullptr);
+    CHECK(units == 0);
+}
+
+TEST_CASE("try_make_unique value-initialises like make_unique") {
+    const auto p = try_make_unique<int16_t>(64);
+    REQUIRE(p != nullptr);
+    for (size_t i = 0; i < 64; i++)
+        CHECK(p[i] == 0);
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "polyphase_channelizer.hpp"
+#include "doctest.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+using dsp::decimate::PolyphaseChannelizer;
+
+constexpr size_t block_size = 512;
+constexpr uint32_t input_rate = 800000;
+
+/* Tone at a fraction of the input rate, in cycles per sample. */
+struct ToneSource {
+    double frequency;
+    double amplitude{8000};
+    size_t n{0};
+
+    void fill(std::array<complex16_t, block_size>& block) {
+        for (auto& s : block) {
+            const double phase = 2 * M_PI * frequency * n++;
+            s = {static_cast<int16_t>(std::lround(amplitude * std::cos(phase))),
+                 static_cast<int16_t>(std::lround(amplitude * std::sin(phase)))};
+        }
+    }
+};
+
+/* Mean power per channel over a few blocks, once the branch history has
+ * filled. */
+std::array<double, PolyphaseChannelizer::max_channels> channel_power(
+    PolyphaseChannelizer& bank,
+    ToneSource& source) {
+    std::array<complex16_t, block_size> in{};
+    std::array<complex16_t, block_size> out{};
+    std::array<double, PolyphaseChannelizer::max_channels> power{};
+
+    for (size_t block = 0; block < 8; block++) {
+        source.fill(in);
+        const auto result = bank.execute({in.data(), in.size(), input_rate}, {out.data(), out.size()});
+        if (block < 2)
+            continue;
+
+        for (size_t c = 0; c < bank.channels(); c++) {
+            const auto channel = bank.channel(result, c);
+            for (size_t i = 0; i < channel.count; i++)
+                power[c] += std::norm(std::complex<double>(channel.p[i].real(), channel.p[i].imag())) / channel.count / 6;
+        }
+    }
+    return power;
+}
+
+double db(const double ratio) {
+    return 10 * std::log10(ratio + 1e-20);
+}
+
+}  // namespace
+
+TEST_CASE("PolyphaseChannelizer splits the input into decimated channels") {
+    PolyphaseChannelizer bank;
+    bank.configure(32);
+
+    std::array<complex16_t, block_size> in{};
+    std::array<complex16_t, block_size> out{};
+    const auto result = bank.execute({in.data(), in.size(), input_rate}, {out.data(), out.size()});
+
+    CHECK(result.count == block_size);
+    CHECK(result.sampling_rate == input_rate / 32);
+    CHECK(bank.channel(result, 3).count == block_size / 32);
+    CHECK(bank.channel(result, 3).p == out.data() + 3 * (block_size / 32));
+}
+
+TEST_CASE("PolyphaseChannelizer puts a tone in the channel centred on it") {
+    for (const size_t channels : {4, 8, 16, 32}) {
+        for (const size_t target : {size_t{0}, channels / 2, channels / 2 + 1, channels - 1}) {
+            CAPTURE(channels);
+            CAPTURE(target);
+
+            PolyphaseChannelizer bank;
+            bank.configure(channels);
+
+            ToneSource source{(static_cast<double>(target) - channels / 2.0) / channels};
+            const auto power = channel_power(bank, source);
+            const double input_power = source.amplitude * source.amplitude;
+
+            // Unity gain at the channel centre.
+            CHECK(std::abs(db(power[target] / input_power)) < 0.5);
+
+            for (size_t c = 0; c < channels; c++) {
+                if (c != target)
+                    CHECK(db(power[c] / power[target]) < -50);
+            }
+        }
+    }
+}
+
+TEST_CASE("PolyphaseChannelizer neighbours cross over halfway between centres") {
+    PolyphaseChannelizer bank;
+    bank.configure(16);
+
+    // Halfway between channels 9 and 10.
+    ToneSource source{1.5 / 16};
+    const auto power = channel_power(bank, source);
+    const double input_power = source.amplitude * source.amplitude;
+
+    CHECK(db(power[9] / input_power) == doctest::Approx(-6).epsilon(0.1));
+    CHECK(db(power[10] / input_power) == doctest::Approx(-6).epsilon(0.1));
+    CHECK(db(power[12] / input_power) < -50);
+}
+
+TEST_CASE("Benchmark PolyphaseChannelizer") {
+    PolyphaseChannelizer bank;
+    bank.configure(32);
+
+    std::array<complex16_t, block_size> in{};
+    std::array<complex16_t, block_size> out{};
+    ToneSource{0.1}.fill(in);
+
+    constexpr size_t blocks = 20000;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < blocks; i++)
+        bank.execute({in.data(), in.size(), input_rate}, {out.data(), out.size()});
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    MESSAGE("PolyphaseChannelizer 32 channels: " << blocks * block_size / seconds / 1e6 << " MS/s");
+    CHECK(seconds > 0);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "polyphase_resampler.hpp"
+#include "doctest.h"
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using dsp::interpolation::PolyphaseResampler;
+
+namespace {
+
+std::vector<complex8_t> make_tone(const double frequency, const uint32_t rate, const size_t count, const double amplitude = 100) {
+    std::vector<complex8_t> samples(count);
+    for (size_t n = 0; n < count; n++) {
+        const double w = 2 * M_PI * frequency * n / rate;
+        samples[n] = {
+            static_cast<int8_t>(std::lround(amplitude * std::cos(w))),
+            static_cast<int8_t>(std::lround(amplitude * std::sin(w)))};
+    }
+    return samples;
+}
+
+std::vector<complex8_t> resample(PolyphaseResampler& resampler, const std::vector<complex8_t>& in, const size_t block) {
+    std::vector<complex8_t> out{};
+    std::vector<complex8_t> chunk(block);
+    size_t position = 0;
+
+    while (position < in.size()) {
+        const auto result = resampler(&in[position], in.size() - position, chunk.data(), chunk.size());
+        out.insert(out.end(), chunk.begin(), chunk.begin() + result.produced);
+        position += result.consumed;
+    }
+    return out;
+}
+
+/* Fits the best single tone at the given frequency and returns the
+ * ratio of its power to everything else, in dB. */
+double tone_snr_db(const std::vector<complex8_t>& samples, const double frequency, const uint32_t rate, const size_t skip) {
+    std::complex<double> a{};
+    const size_t count = samples.size() - skip;
+    for (size_t n = skip; n < samples.size(); n++) {
+        const std::complex<double> y{static_cast<double>(samples[n].real()), static_cast<double>(samples[n].imag())};
+        a += y * std::polar(1.0, -2 * M_PI * frequency * n / rate);
+    }
+    a /= static_cast<double>(count);
+
+    double residual = 0;
+    for (size_t n = skip; n < samples.size(); n++) {
+        const std::complex<double> y{static_cast<double>(samples[n].real()), static_cast<double>(samples[n].imag())};
+        residual += std::norm(y - a * std::polar(1.0, 2 * M_PI * frequency * n / rate));
+    }
+
+    return 10 * std::log10(std::norm(a) / (residual / count));
+}
+
+}  // namespace
+
+TEST_CASE("PolyphaseResampler passes matching rates straight through") {
+    PolyphaseResampler resampler{};
+    resampler.configure(2600000, 2600000);
+    CHECK(resampler.bypass());
+
+    const auto in = make_tone(100000, 2600000, 1000);
+    std::vector<complex8_t> out(1000);
+    const auto result = resampler(in.data(), in.size(), out.data(), out.size());
+    CHECK(result.consumed == 1000);
+    CHECK(result.produced == 1000);
+    CHECK(out == in);
+}
+
+TEST_CASE("PolyphaseResampler keeps the output to input ratio") {
+    PolyphaseResampler resampler{};
+    resampler.configure(1000000, 2600000);
+
+    const auto out = resample(resampler, make_tone(0, 1000000, 100000), 2048);
+    CHECK(out.size() == doctest::Approx(260000).epsilon(0.001));
+
+    // Unity gain at DC once the filter has filled.
+    CHECK(std::abs(out.back().real() - 100) <= 1);
+    CHECK(std::abs(out.back().imag()) <= 1);
+}
+
+TEST_CASE("PolyphaseResampler keeps an in-band tone clean") {
+    struct Ratio {
+        uint32_t in;
+        uint32_t out;
+        double tone;
+    };
+
+    for (const auto& r : {Ratio{500000, 2600000, 120000}, Ratio{1000000, 2600000, -250000}, Ratio{2000000, 2600000, 600000}, Ratio{3072000, 2600000, 500000}}) {
+        PolyphaseResampler resampler{};
+        resampler.configure(r.in, r.out);
+
+        const auto out = resample(resampler, make_tone(r.tone, r.in, 50000), 2048);
+        const auto snr = tone_snr_db(out, r.tone, r.out, 256);
+
+        MESSAGE("PolyphaseResampler " << r.in << " -> " << r.out << " tone " << r.tone << " Hz SNR " << snr << " dB");
+        CHECK(snr > 30);
+    }
+}
+
+TEST_CASE("Benchmark PolyphaseResampler throughput") {
+    constexpr size_t input_samples = 2'000'000;
+    constexpr uint32_t output_rate = 2600000;
+
+    for (uint32_t input_rate : {500000U, 1000000U, 2000000U, 3072000U}) {
+        PolyphaseResampler resampler{};
+        resampler.configure(input_rate, output_rate);
+
+        const auto in = make_tone(input_rate / 10.0, input_rate, input_samples);
+        std::vector<complex8_t> out(2048);
+        size_t position = 0;
+        size_t produced = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        while (position < in.size()) {
+            const auto result = resampler(&in[position], in.size() - position, out.data(), out.size());
+            position += result.consumed;
+            produced += result.produced;
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        MESSAGE("PolyphaseResampler " << input_rate << " -> " << output_rate << ": " << produced / seconds / 1e6 << " Msamples/s out");
+        CHECK(produced > 0);
+    }
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "stream_output.hpp"
+#include "dsp_mixer.hpp"
+#include "tx_gate.hpp"
+#include "doctest.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+/* Plays the M0 side of the replay: fills every empty buffer with a
+ * running byte counter and hands it back as full. */
+struct FakeReplayThread {
+    ReplayConfig& config;
+    uint8_t next{0};
+
+    void service() {
+        StreamBuffer* buffer{nullptr};
+        while (config.fifo_buffers_empty->out(buffer)) {
+            auto p = static_cast<uint8_t*>(buffer->data());
+            for (size_t i = 0; i < buffer->capacity(); i++)
+                p[i] = next++;
+            buffer->set_size(buffer->capacity());
+            config.fifo_buffers_full->in(buffer);
+        }
+    }
+};
+
+constexpr size_t dma_block_bytes = 2048 * sizeof(complex8_t);
+
+double bytes_per_second(size_t bytes, std::chrono::steady_clock::duration elapsed) {
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? bytes / seconds : 0.0;
+}
+
+}  // namespace
+
+TEST_CASE("StreamOutput reads the stream in order across buffer boundaries") {
+    ReplayConfig config{16384, 3};
+    StreamOutput stream{&config};
+    FakeReplayThread m0{config};
+
+    std::array<uint8_t, dma_block_bytes> dma{};
+    uint8_t expected = 0;
+
+    for (size_t block = 0; block < 64; block++) {
+        m0.service();
+        REQUIRE(stream.read(dma.data(), dma.size()) == dma.size());
+
+        for (auto b : dma)
+            CHECK(b == expected++);
+    }
+
+    CHECK(config.baseband_bytes_received == 64 * dma.size());
+}
+
+TEST_CASE("StreamOutput returns a short read when no full buffer is available") {
+    ReplayConfig config{4096, 2};
+    StreamOutput stream{&config};
+    FakeReplayThread m0{config};
+
+    std::array<uint8_t, 3 * 4096> dma{};
+    m0.service();
+
+    CHECK(stream.read(dma.data(), dma.size()) == 2 * 4096);
+}
+
+TEST_CASE("StreamOutput zero-fills and records holes") {
+    ReplayConfig config{4096, 2, ReplayFillPolicy::Zero};
+    StreamOutput stream{&config};
+    FakeReplayThread m0{config};
+
+    std::array<uint8_t, 4096> dma{};
+    m0.service();
+    stream.read(dma.data(), dma.size());
+    stream.read(dma.data(), dma.size());
+
+    dma.fill(0xAA);
+    CHECK(stream.read(dma.data(), dma.size()) == 0);
+    for (auto b : dma)
+        CHECK(b == 0);
+
+    CHECK(stream.read(dma.data(), dma.size()) == 0);
+
+    const auto& stats = stream.underrun_statistics();
+    CHECK(stats.count == 2);
+    CHECK(stats.bytes_filled == 2 * 4096);
+    CHECK(stats.first_position == 2 * 4096);
+    CHECK(stats.last_position == 3 * 4096);
+    CHECK_FALSE(stats.aborted);
+}
+
+TEST_CASE("StreamOutput repeats the tail of the previous block") {
+    ReplayConfig config{4096, 1, ReplayFillPolicy::RepeatLast};
+    StreamOutput stream{&config};
+    FakeReplayThread m0{config};
+
+    std::array<uint8_t, 2048> first{};
+    std::array<uint8_t, 2048> second{};
+    std::array<uint8_t, 2048> third{};
+
+    m0.service();
+    REQUIRE(stream.read(first.data(), first.size()) == 2048);
+    REQUIRE(stream.read(second.data(), second.size()) == 2048);
+
+    // Nothing left: the whole block repeats the previous one.
+    CHECK(stream.read(third.data(), third.size()) == 0);
+    CHECK(third == second);
+    CHECK(stream.underrun_statistics().count == 1);
+}
+
+TEST_CASE("StreamOutput repeats stream data, not the processed DMA buffer") {
+    ReplayConfig config{4096, 1, ReplayFillPolicy::RepeatLast};
+    StreamOutput stream{&config};
+    FakeReplayThread m0{config};
+
+    dsp::Mixer mixer;
+    mixer.set_frequency(100000, 2000000);
+    mixer.set_gain(6, false);
+    TXGate gate;
+    gate.configure(2048, 1024);
+
+    // Processed in place like SigGenProcessor does with the DMA transfer buffer.
+    std::array<complex8_t, 1024> dma{};
+    const auto dma_bytes = dma.size() * sizeof(complex8_t);
+    auto transfer = [&]() {
+        const auto n = stream.read(dma.data(), dma_bytes);
+        mixer(dma.data(), dma.size());
+        gate.apply(dma.data(), dma.size());
+        return n;
+    };
+
+    m0.service();
+    REQUIRE(transfer() == dma_bytes);
+    REQUIRE(transfer() == dma_bytes);
+
+    // The hole falls in the gate's off window, then back into an on window.
+    std::array<complex8_t, 1024> raw{};
+    CHECK(stream.read(raw.data(), dma_bytes) == 0);
+    for (size_t i = 0; i < raw.size(); i++) {
+        CHECK(raw[i].real() == static_cast<int8_t>(dma_bytes + 2 * i));
+        CHECK(raw[i].imag() == static_cast<int8_t>(dma_bytes + 2 * i + 1));
+    }
+
+    CHECK(transfer() == 0);
+    CHECK(stream.read(raw.data(), dma_bytes) == 0);
+    CHECK(raw[0].real() == static_cast<int8_t>(dma_bytes));
+}
+
+TEST_CASE("StreamOutput stops consuming after an abort") {
+    ReplayConfig config{4096, 1, ReplayFillPolicy::Abort};
+    StreamOutput stream{&config};
+    FakeReplayThread m0{config};
+
+    std::array<uint8_t, 4096> dma{};
+    m0.service();
+    REQUIRE(stream.read(dma.data(), dma.size()) == 4096);
+    CHECK(stream.read(dma.data(), dma.size()) == 0);
+    CHECK(stream.underrun_statistics().aborted);
+
+    // Buffers that arrive late are ignored.
+    m0.service();
+    dma.fill(0xAA);
+    CHECK(stream.read(dma.data(), dma.size()) == 0);
+    CHECK(dma[0] == 0);
+    CHECK(stream.underrun_statistics().count == 1);
+}
+
+TEST_CASE("StreamOutput does not count draining at end of stream as a hole") {
+    ReplayConfig config{4096, 1};
+    StreamOutput stream{&config};
+    FakeReplayThread m0{config};
+
+    std::array<uint8_t, 4096> dma{};
+    m0.service();
+    stream.read(dma.data(), dma.size());
+
+    config.end_of_stream = true;
+    CHECK(stream.read(dma.data(), dma.size()) == 0);
+    CHECK(stream.underrun_statistics().count == 0);
+}
+
+TEST_CASE("Benchmark StreamOutput direct fill against staged copy") {
+    constexpr size_t total_bytes = 64 * 1024 * 1024;
+    constexpr size_t blocks = total_bytes / dma_block_bytes;
+
+    std::array<uint8_t, dma_block_bytes> dma{};
+    std::array<uint8_t, dma_block_bytes> staging{};
+
+    auto run = [&](bool staged) {
+        ReplayConfig config{16384, 3};
+        StreamOutput stream{&config};
+        FakeReplayThread m0{config};
+        size_t moved = 0;
+
+        std::chrono::steady_clock::duration elapsed{};
+        for (size_t block = 0; block < blocks; block++) {
+            m0.service();
+
+            const auto start = std::chrono::steady_clock::now();
+            if (staged) {
+                const auto n = stream.read(staging.data(), staging.size());
+                memcpy(dma.data(), staging.data(), n);
+                moved += n;
+            } else {
+                moved += stream.read(dma.data(), dma.size());
+            }
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        REQUIRE(moved == total_bytes);
+        return bytes_per_second(moved, elapsed);
+    };
+
+    const auto staged = run(true);
+    const auto direct = run(false);
+
+    MESSAGE("StreamOutput::read staged copy: " << staged / 1e6 << " MB/s");
+    MESSAGE("StreamOutput::read direct fill: " << direct / 1e6 << " MB/s");
+    CHECK(direct > 0);
+    CHECK(staged > 0);
+}
+
+TEST_CASE("StreamOutput caps the pool at the FIFO size") {
+    ReplayConfig config{16384, 3};
+    StreamOutput stream{&config, 4096};
+    CHECK(config.buffer_count == 3);
+
+    ReplayConfig too_many{4096, 12};
+    StreamOutput capped{&too_many};
+    CHECK(too_many.buffer_count == 8);
+}
+
+TEST_CASE("StreamOutput buffers start on sector boundaries") {
+    ReplayConfig config{16384, 3};
+    StreamOutput stream{&config};
+
+    StreamBuffer* buffer{nullptr};
+    size_t count = 0;
+    while (config.fifo_buffers_empty->out(buffer)) {
+        CHECK(reinterpret_cast<uintptr_t>(buffer->data()) % stream_buffer_alignment == 0);
+        count++;
+    }
+    CHECK(count == 3);
+}
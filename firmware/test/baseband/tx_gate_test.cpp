@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "tx_gate.hpp"
+#include "doctest.h"
+
+#include <vector>
+
+namespace {
+
+/* Runs a never-silent synthetic stream through the gate in blocks and
+ * returns the sample positions where the output turns on or off. */
+std::vector<uint64_t> gate_edges(TXGate& gate, const size_t block_size, const size_t blocks) {
+    std::vector<complex8_t> block(block_size);
+    std::vector<uint64_t> edges{};
+    uint64_t position = 0;
+    bool keyed = true;
+
+    for (size_t b = 0; b < blocks; b++) {
+        for (auto& s : block)
+            s = {1, -1};
+
+        gate.apply(block.data(), block.size());
+
+        for (const auto& s : block) {
+            const bool on = (s.real() != 0);
+            if (on != keyed) {
+                edges.push_back(position);
+                keyed = on;
+            }
+            position++;
+        }
+    }
+
+    return edges;
+}
+
+}  // namespace
+
+TEST_CASE("TXGate passes everything through when disabled") {
+    TXGate gate{};
+    std::vector<complex8_t> block(2048, {3, 4});
+
+    CHECK(gate.apply(block.data(), block.size()) == block.size());
+    CHECK(block.back() == complex8_t{3, 4});
+
+    gate.configure(1000, 0);
+    CHECK_FALSE(gate.enabled());
+    CHECK(gate.apply(block.data(), block.size()) == block.size());
+}
+
+TEST_CASE("TXGate edges fall on exact sample positions") {
+    // 2.6 MSPS with 5 ms on and 3 ms off, in DMA sized blocks.
+    constexpr uint64_t on = 13000;
+    constexpr uint64_t off = 7800;
+    constexpr uint64_t period = on + off;
+
+    TXGate gate{};
+    gate.configure(on, off);
+
+    const auto edges = gate_edges(gate, 2048, 100);
+    const uint64_t total = 2048 * 100;
+
+    std::vector<uint64_t> expected{};
+    for (uint64_t start = 0; start < total; start += period) {
+        if (start + on < total)
+            expected.push_back(start + on);
+        if (start + period < total)
+            expected.push_back(start + period);
+    }
+
+    CHECK(edges == expected);
+}
+
+TEST_CASE("TXGate edges do not depend on the block size") {
+    TXGate a{};
+    TXGate b{};
+    a.configure(1000, 500);
+    b.configure(1000, 500);
+
+    CHECK(gate_edges(a, 2048, 12) == gate_edges(b, 96, 256));
+}
+
+TEST_CASE("TXGate handles windows shorter than a block") {
+    TXGate gate{};
+    gate.configure(3, 2);
+
+    std::vector<complex8_t> block(12, {1, 1});
+    CHECK(gate.apply(block.data(), block.size()) == 8);
+
+    const bool expected[] = {1, 1, 1, 0, 0, 1, 1, 1, 0, 0, 1, 1};
+    for (size_t i = 0; i < block.size(); i++)
+        CHECK((block[i].real() != 0) == expected[i]);
+
+    // The next block picks up in the middle of the on window.
+    CHECK(gate.is_on());
+    gate.reset();
+    CHECK(gate.is_on());
+}
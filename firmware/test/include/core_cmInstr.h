@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for CMSIS core_cmInstr.h. The test include directory is
+ * searched before the CMSIS one, so firmware code that touches the core
+ * instruction intrinsics (FIFO barriers, inter-core events) can be built
+ * and run on the dev machine. */
+
+#ifndef __CORE_CMINSTR_H
+#define __CORE_CMINSTR_H
+
+#include <stdint.h>
+
+static inline void __NOP(void) {}
+static inline void __WFI(void) {}
+static inline void __WFE(void) {}
+static inline void __SEV(void) {}
+static inline void __ISB(void) {}
+static inline void __DSB(void) { __sync_synchronize(); }
+static inline void __DMB(void) { __sync_synchronize(); }
+
+static inline uint32_t __REV(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+static inline uint32_t __REV16(uint32_t value) {
+    return ((value & 0xff00ff00U) >> 8) | ((value & 0x00ff00ffU) << 8);
+}
+
+static inline int32_t __REVSH(int32_t value) {
+    return (int16_t)(((value & 0xff00) >> 8) | ((value & 0x00ff) << 8));
+}
+
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2) {
+    op2 &= 31;
+    return op2 ? (op1 >> op2) | (op1 << (32 - op2)) : op1;
+}
+
+static inline uint32_t __RBIT(uint32_t value) {
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i++) {
+        result = (result << 1) | ((value >> i) & 1);
+    }
+    return result;
+}
+
+static inline uint8_t __CLZ(uint32_t value) {
+    return value ? __builtin_clz(value) : 32;
+}
+
+#define __SSAT(ARG1, ARG2) ({                                   \
+    const int32_t __max = (int32_t)((1UL << ((ARG2)-1)) - 1);   \
+    const int32_t __min = -__max - 1;                           \
+    const int32_t __v = (int32_t)(ARG1);                        \
+    (__v > __max) ? __max : ((__v < __min) ? __min : __v);      \
+})
+
+#define __USAT(ARG1, ARG2) ({                                   \
+    const int32_t __max = (int32_t)((1UL << (ARG2)) - 1);       \
+    const int32_t __v = (int32_t)(ARG1);                        \
+    (uint32_t)((__v > __max) ? __max : ((__v < 0) ? 0 : __v));  \
+})
+
+#endif /* __CORE_CMINSTR_H */